@@ -4,6 +4,7 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "base/path_service.h"
+#include "base/run_loop.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
@@ -11,6 +12,7 @@
 #include "brave/browser/brave_content_browser_client.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 #include "brave/components/brave_shields/browser/autoplay_whitelist_service.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
@@ -228,6 +230,10 @@ class AutoplayWhitelistServiceTest : public ExtensionBrowserTest {
   }
 
   void WaitForAutoplayWhitelistServiceThread() {
+    base::RunLoop run_loop;
+    brave_component_updater::ComponentLoadScheduler::GetInstance()
+        ->RunWhenIdleForTesting(run_loop.QuitClosure());
+    run_loop.Run();
     scoped_refptr<base::ThreadTestHelper> io_helper(new base::ThreadTestHelper(
         g_brave_browser_process->local_data_files_service()->GetTaskRunner()));
     ASSERT_TRUE(io_helper->Run());
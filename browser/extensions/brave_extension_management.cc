@@ -25,6 +25,16 @@
 #include "brave/browser/extensions/brave_tor_client_updater.h"
 #endif
 
+#if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
+#include "base/bind.h"
+#include "base/task/post_task.h"
+#include "brave/components/brave_webtorrent/browser/net/brave_torrent_redirect_network_delegate_helper.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "extensions/browser/extension_system.h"
+#include "extensions/browser/info_map.h"
+#endif
+
 namespace extensions {
 
 BraveExtensionManagement::BraveExtensionManagement(Profile* profile)
@@ -35,9 +45,21 @@ BraveExtensionManagement::BraveExtensionManagement(Profile* profile)
   providers_.push_back(
       std::make_unique<BraveExtensionProvider>());
   RegisterBraveExtensions();
+#if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
+  info_map_ = ExtensionSystem::Get(profile)->info_map();
+  // In case the extension was loaded before we started observing.
+  SetWebtorrentEnabled(ExtensionRegistry::Get(profile)->enabled_extensions()
+                           .Contains(brave_webtorrent_extension_id));
+#endif
 }
 
 BraveExtensionManagement::~BraveExtensionManagement() {
+#if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
+  base::PostTaskWithTraits(
+      FROM_HERE, {content::BrowserThread::IO},
+      base::BindOnce(&webtorrent::ClearWebtorrentEnabledOnIO,
+                     base::RetainedRef(info_map_)));
+#endif
 }
 
 void BraveExtensionManagement::RegisterBraveExtensions() {
@@ -49,11 +71,24 @@ void BraveExtensionManagement::RegisterBraveExtensions() {
 #endif
 }
 
+#if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
+void BraveExtensionManagement::SetWebtorrentEnabled(bool enabled) {
+  base::PostTaskWithTraits(
+      FROM_HERE, {content::BrowserThread::IO},
+      base::BindOnce(&webtorrent::SetWebtorrentEnabledOnIO,
+                     base::RetainedRef(info_map_), enabled));
+}
+#endif
+
 void BraveExtensionManagement::OnExtensionLoaded(
     content::BrowserContext* browser_context,
     const Extension* extension) {
   if (extension->id() == ipfs_companion_extension_id)
     pref_service_->SetBoolean(kIPFSCompanionEnabled, true);
+#if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
+  if (extension->id() == brave_webtorrent_extension_id)
+    SetWebtorrentEnabled(true);
+#endif
 }
 
 void BraveExtensionManagement::OnExtensionUnloaded(
@@ -62,6 +97,10 @@ void BraveExtensionManagement::OnExtensionUnloaded(
     UnloadedExtensionReason reason) {
   if (extension->id() == ipfs_companion_extension_id)
     pref_service_->SetBoolean(kIPFSCompanionEnabled, false);
+#if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
+  if (extension->id() == brave_webtorrent_extension_id)
+    SetWebtorrentEnabled(false);
+#endif
 }
 
 }  // namespace extensions
@@ -6,13 +6,16 @@
 #ifndef BRAVE_BROWSER_EXTENSIONS_BRAVE_EXTENSION_MANAGEMENT_H_
 #define BRAVE_BROWSER_EXTENSIONS_BRAVE_EXTENSION_MANAGEMENT_H_
 
+#include "base/memory/scoped_refptr.h"
 #include "base/scoped_observer.h"
+#include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
 #include "chrome/browser/extensions/extension_management.h"
 #include "extensions/browser/extension_registry_observer.h"
 
 namespace extensions {
 
 class ExtensionRegistry;
+class InfoMap;
 
 class BraveExtensionManagement : public ExtensionManagement,
                                  public ExtensionRegistryObserver {
@@ -22,6 +25,11 @@ class BraveExtensionManagement : public ExtensionManagement,
 
  private:
   void RegisterBraveExtensions();
+#if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
+  // Pushes whether the WebTorrent extension is enabled to the IO thread,
+  // where the torrent redirect network delegate helper reads it.
+  void SetWebtorrentEnabled(bool enabled);
+#endif
 
   // ExtensionRegistryObserver implementation.
   void OnExtensionLoaded(
@@ -34,6 +42,11 @@ class BraveExtensionManagement : public ExtensionManagement,
 
   ScopedObserver<ExtensionRegistry, ExtensionRegistryObserver>
     extension_registry_observer_;
+#if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
+  // Shared with the incognito profile, the IO thread keys the WebTorrent
+  // state by it.
+  scoped_refptr<InfoMap> info_map_;
+#endif
 
   DISALLOW_COPY_AND_ASSIGN(BraveExtensionManagement);
 };
@@ -5,6 +5,7 @@
 
 #include "base/path_service.h"
 #include "base/run_loop.h"
+#include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
@@ -121,7 +122,7 @@ class GreaselionServiceTest : public ExtensionBrowserTest {
     return true;
   }
 
-  bool ScriptsFor(const GURL& url, std::vector<std::string>* scripts) {
+  bool ScriptsFor(const GURL& url, greaselion::GreaselionScripts* scripts) {
     GreaselionService* greaselion_service =
         GreaselionServiceFactory::GetForBrowserContext(profile());
     return greaselion_service->ScriptsFor(url, scripts);
@@ -140,38 +141,38 @@ class GreaselionServiceTest : public ExtensionBrowserTest {
 
 IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, RuleParsing) {
   ASSERT_TRUE(InstallGreaselionExtension());
-  std::vector<std::string> scripts;
+  greaselion::GreaselionScripts scripts;
 
   // URL should match two rules, each with a different script
   // (first rule is an exact match, second rule is a TLD match)
   ASSERT_TRUE(ScriptsFor(GURL("https://www.example.com/"), &scripts));
   ASSERT_EQ(scripts.size(), 2UL);
-  EXPECT_EQ(scripts[0].find("example.com"), 7UL);
-  EXPECT_EQ(scripts[1].find("example.*"), 7UL);
+  EXPECT_EQ(scripts[0]->data.find(base::ASCIIToUTF16("example.com")), 7UL);
+  EXPECT_EQ(scripts[1]->data.find(base::ASCIIToUTF16("example.*")), 7UL);
 
   // URL should match two rules, each with a different script
   // (first rule is still an exact match because 80 is the default port,
   // second rule is a TLD match)
   ASSERT_TRUE(ScriptsFor(GURL("https://www.example.com:80/"), &scripts));
   ASSERT_EQ(scripts.size(), 2UL);
-  EXPECT_EQ(scripts[0].find("example.com"), 7UL);
-  EXPECT_EQ(scripts[1].find("example.*"), 7UL);
+  EXPECT_EQ(scripts[0]->data.find(base::ASCIIToUTF16("example.com")), 7UL);
+  EXPECT_EQ(scripts[1]->data.find(base::ASCIIToUTF16("example.*")), 7UL);
 
   // URL should match one rule with one script (because of TLD matching)
   ASSERT_TRUE(ScriptsFor(GURL("https://www.example.org/"), &scripts));
   ASSERT_EQ(scripts.size(), 1UL);
-  EXPECT_EQ(scripts[0].find("example.*"), 7UL);
+  EXPECT_EQ(scripts[0]->data.find(base::ASCIIToUTF16("example.*")), 7UL);
 
   // URL should match one rule with one script (because 80 is the default port)
   ASSERT_TRUE(ScriptsFor(GURL("https://www.example.org:80/"), &scripts));
   ASSERT_EQ(scripts.size(), 1UL);
-  EXPECT_EQ(scripts[0].find("example.*"), 7UL);
+  EXPECT_EQ(scripts[0]->data.find(base::ASCIIToUTF16("example.*")), 7UL);
 
   // URL should match one rule with one script (because TLD matching works on
   // multi-dotted TLDs)
   ASSERT_TRUE(ScriptsFor(GURL("https://www.example.co.uk/"), &scripts));
   ASSERT_EQ(scripts.size(), 1UL);
-  EXPECT_EQ(scripts[0].find("example.*"), 7UL);
+  EXPECT_EQ(scripts[0]->data.find(base::ASCIIToUTF16("example.*")), 7UL);
 
   // URL should not match any rules (because of scheme)
   ASSERT_FALSE(ScriptsFor(GURL("http://www.example.com/"), &scripts));
@@ -190,7 +191,7 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, RuleParsing) {
   // and wildcard path)
   ASSERT_TRUE(ScriptsFor(GURL("http://www.a.com:9876/simple.html"), &scripts));
   ASSERT_EQ(scripts.size(), 1UL);
-  EXPECT_EQ(scripts[0].find("Altered"), 18UL);
+  EXPECT_EQ(scripts[0]->data.find(base::ASCIIToUTF16("Altered")), 18UL);
 
   // URL should not match because rewards are disabled
   greaselion::GreaselionServiceFactory::GetForBrowserContext(profile())
@@ -9,6 +9,8 @@
 
 #include "brave/browser/importer/brave_in_process_importer_bridge.h"
 #include "chrome/browser/importer/external_process_importer_client.h"
+#include "chrome/common/importer/importer_url_row.h"
+#include "components/favicon_base/favicon_usage_data.h"
 #include "net/cookies/canonical_cookie.h"
 
 struct BraveStats;
@@ -26,6 +28,16 @@ class BraveExternalProcessImporterClient : public ExternalProcessImporterClient
   // Called by the ExternalProcessImporterHost on import cancel.
   void Cancel();
 
+  // ChromeImporter sends its history and favicons in several chunks, each
+  // starting with On*ImportStart(). Every chunk is written as soon as it is
+  // complete instead of being added to the items of the previous ones.
+  void OnHistoryImportStart(uint32_t total_history_rows_count) override;
+  void OnHistoryImportGroup(
+      const std::vector<ImporterURLRow>& history_rows_group,
+      int visit_source) override;
+  void OnFaviconsImportStart(uint32_t total_favicons_count) override;
+  void OnFaviconsImportGroup(
+      const favicon_base::FaviconUsageDataList& favicons_group) override;
   void OnCookiesImportStart(
       uint32_t total_cookies_count) override;
   void OnCookiesImportGroup(
@@ -39,10 +51,22 @@ class BraveExternalProcessImporterClient : public ExternalProcessImporterClient
   void OnWindowsImportReady(
        const ImportedWindowState& windowState) override;
   void OnSettingsImportReady(const SessionStoreSettings& settings) override;
+  void OnImportItemProgress(importer::ImportItem item,
+                            uint32_t imported_count) override;
 
  private:
   ~BraveExternalProcessImporterClient() override;
 
+  // Total number of history rows in the current chunk.
+  size_t total_history_rows_count_;
+
+  std::vector<ImporterURLRow> history_rows_;
+
+  // Total number of favicons in the current chunk.
+  size_t total_favicons_count_;
+
+  favicon_base::FaviconUsageDataList favicons_;
+
   // Total number of cookies to import.
   size_t total_cookies_count_;
 
@@ -9,6 +9,7 @@
 #include "brave/browser/importer/brave_in_process_importer_bridge.h"
 
 #include "brave/browser/importer/brave_importer_lock_dialog.h"
+#include "chrome/browser/importer/importer_progress_observer.h"
 
 BraveExternalProcessImporterHost::BraveExternalProcessImporterHost()
   : ExternalProcessImporterHost(),
@@ -45,6 +46,13 @@ void BraveExternalProcessImporterHost::StartImportSettings(
   LaunchImportIfReady();
 }
 
+void BraveExternalProcessImporterHost::NotifyImportItemProgress(
+    importer::ImportItem item,
+    uint32_t imported_count) {
+  if (observer_)
+    observer_->ImportItemProgress(item, imported_count);
+}
+
 void BraveExternalProcessImporterHost::LaunchImportIfReady() {
   if (waiting_for_bookmarkbar_model_ || template_service_subscription_.get() ||
       !is_source_readable_ || cancelled_)
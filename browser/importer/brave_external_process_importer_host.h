@@ -19,6 +19,10 @@ class BraveExternalProcessImporterHost : public ExternalProcessImporterHost {
       uint16_t items,
       ProfileWriter* writer) override;
 
+  // Called by the bridge as the import of |item| progresses.
+  void NotifyImportItemProgress(importer::ImportItem item,
+                                uint32_t imported_count);
+
  private:
   ~BraveExternalProcessImporterHost() override;
 
@@ -51,4 +51,15 @@ void BraveInProcessImporterBridge::UpdateSettings(
   writer_->UpdateSettings(settings);
 }
 
+void BraveInProcessImporterBridge::NotifyItemProgress(
+    importer::ImportItem item,
+    uint32_t imported_count) {
+  // The host that created this bridge is always a
+  // BraveExternalProcessImporterHost.
+  if (host_) {
+    static_cast<BraveExternalProcessImporterHost*>(host_.get())
+        ->NotifyImportItemProgress(item, imported_count);
+  }
+}
+
 BraveInProcessImporterBridge::~BraveInProcessImporterBridge() {}
@@ -30,6 +30,8 @@ class BraveInProcessImporterBridge : public InProcessImporterBridge {
   void UpdateReferral(const BraveReferral& referral) override;
   void UpdateWindows(const ImportedWindowState& windowState) override;
   void UpdateSettings(const SessionStoreSettings& settings) override;
+  void NotifyItemProgress(importer::ImportItem item,
+                          uint32_t imported_count) override;
 
   void FinishLedgerImport();
   void Cancel();
@@ -5,13 +5,20 @@
 
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/base64url.h"
-#include "base/strings/string_util.h"
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+#include "base/no_destructor.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/net/url_context.h"
+#include "brave/common/brave_switches.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/shield_exceptions.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
@@ -29,78 +36,122 @@ using content::ResourceType;
 
 namespace brave {
 
-std::string GetGoogleAnalyticsPolyfillJS() {
-  static std::string base64_output;
-  if (base64_output.length() != 0)  {
-    return base64_output;
-  }
-  std::string str = ui::ResourceBundle::GetSharedInstance().GetRawDataResource(
-      IDR_BRAVE_GOOGLE_ANALYTICS_POLYFILL).as_string();
-  Base64UrlEncode(str, base::Base64UrlEncodePolicy::OMIT_PADDING,
-      &base64_output);
-  base64_output = std::string(kJSDataURLPrefix) + base64_output;
-  return base64_output;
+namespace {
+
+// What to do with requests that match a pre-work rule.
+enum class PreWorkAction {
+  // Redirect to a polyfill, when shields are up and ads are blocked.
+  kPolyfill,
+  // Redirect to an empty document, always.
+  kBlock,
+};
+
+struct PreWorkRule {
+  URLPattern pattern;
+  PreWorkAction action;
+  std::string new_url_spec;
+};
+
+std::string GetPolyfillDataURL(int resource_id) {
+  std::string base64_output;
+  Base64UrlEncode(
+      ui::ResourceBundle::GetSharedInstance().GetRawDataResource(resource_id),
+      base::Base64UrlEncodePolicy::OMIT_PADDING, &base64_output);
+  return kJSDataURLPrefix + base64_output;
 }
 
-std::string GetGoogleTagManagerPolyfillJS() {
-  static std::string base64_output;
-  if (base64_output.length() != 0)  {
-    return base64_output;
+// The polyfill and blocked resource rules, indexed by host so that requests
+// to any other host are passed on after a single lookup. Built once and only
+// read afterwards, so it can be used from any thread.
+class PreWorkRulesTable {
+ public:
+  PreWorkRulesTable() {
+    AddRule(URLPattern(URLPattern::SCHEME_ALL, kGoogleAnalyticsPattern),
+            PreWorkAction::kPolyfill,
+            GetPolyfillDataURL(IDR_BRAVE_GOOGLE_ANALYTICS_POLYFILL));
+    AddRule(URLPattern(URLPattern::SCHEME_ALL, kGoogleTagManagerPattern),
+            PreWorkAction::kPolyfill,
+            GetPolyfillDataURL(IDR_BRAVE_TAG_MANAGER_POLYFILL));
+    AddRule(URLPattern(URLPattern::SCHEME_ALL, kGoogleTagServicesPattern),
+            PreWorkAction::kPolyfill,
+            GetPolyfillDataURL(IDR_BRAVE_TAG_SERVICES_POLYFILL));
+    // Most blocked resources have been moved to our ad block lists.
+    // This is only for special cases like the PDFjs ping which can
+    // occur before the ad block lists are fully loaded.
+    for (const auto& pattern : GetBlockedResourcePatterns())
+      AddRule(pattern, PreWorkAction::kBlock, kEmptyDataURI);
+  }
+
+  const PreWorkRule* Match(const GURL& url) const {
+    auto it = hosts_.find(url.host_piece());
+    if (it == hosts_.end())
+      return nullptr;
+    for (const auto& rule : it->second) {
+      if (rule.pattern.MatchesURL(url))
+        return &rule;
+    }
+    return nullptr;
   }
-  std::string str = ui::ResourceBundle::GetSharedInstance().GetRawDataResource(
-      IDR_BRAVE_TAG_MANAGER_POLYFILL).as_string();
-  Base64UrlEncode(str, base::Base64UrlEncodePolicy::OMIT_PADDING,
-      &base64_output);
-  base64_output = std::string(kJSDataURLPrefix) + base64_output;
-  return base64_output;
-}
 
-std::string GetGoogleTagServicesPolyfillJS() {
-  static std::string base64_output;
-  if (base64_output.length() != 0)  {
-    return base64_output;
+ private:
+  void AddRule(const URLPattern& pattern,
+               PreWorkAction action,
+               const std::string& new_url_spec) {
+    // Only exact hosts can be looked up.
+    DCHECK(!pattern.host().empty());
+    DCHECK(!pattern.match_subdomains());
+    hosts_[pattern.host()].push_back({pattern, action, new_url_spec});
   }
-  std::string str = ui::ResourceBundle::GetSharedInstance().GetRawDataResource(
-    IDR_BRAVE_TAG_SERVICES_POLYFILL).as_string();
-  Base64UrlEncode(str, base::Base64UrlEncodePolicy::OMIT_PADDING,
-      &base64_output);
-  base64_output = std::string(kJSDataURLPrefix) + base64_output;
-  return base64_output;
+
+  // Transparent, so that hosts can be looked up without copying them.
+  base::flat_map<std::string, std::vector<PreWorkRule>, std::less<>> hosts_;
+
+  DISALLOW_COPY_AND_ASSIGN(PreWorkRulesTable);
+};
+
+// Each |Tag| gets its own table, so tests can build one that no request
+// has touched yet.
+struct RequestRules {};
+struct TestingRules {};
+
+template <typename Tag>
+const PreWorkRule* MatchPreWorkRule(const GURL& url) {
+  static const base::NoDestructor<PreWorkRulesTable> table;
+  return table->Match(url);
 }
 
-bool GetPolyfillForAdBlock(bool allow_brave_shields, bool allow_ads,
-    const GURL& tab_origin, const GURL& gurl, std::string* new_url_spec) {
+template <typename Tag>
+bool GetPolyfill(bool allow_brave_shields,
+                 bool allow_ads,
+                 const GURL& gurl,
+                 std::string* new_url_spec) {
   // Polyfills which are related to adblock should only apply when shields
   // are up.
   if (!allow_brave_shields || allow_ads) {
     return false;
   }
 
-  static URLPattern analytics(URLPattern::SCHEME_ALL,
-      kGoogleAnalyticsPattern);
-  static URLPattern tag_manager(URLPattern::SCHEME_ALL,
-      kGoogleTagManagerPattern);
-  static URLPattern tag_services(URLPattern::SCHEME_ALL,
-      kGoogleTagServicesPattern);
-  if (analytics.MatchesURL(gurl)) {
-    std::string&& data_url = GetGoogleAnalyticsPolyfillJS();
-    *new_url_spec = data_url;
-    return true;
+  const PreWorkRule* rule = MatchPreWorkRule<Tag>(gurl);
+  if (!rule || rule->action != PreWorkAction::kPolyfill) {
+    return false;
   }
 
-  if (tag_manager.MatchesURL(gurl)) {
-    std::string&& data_url = GetGoogleTagManagerPolyfillJS();
-    *new_url_spec = data_url;
-    return true;
-  }
+  *new_url_spec = rule->new_url_spec;
+  return true;
+}
 
-  if (tag_services.MatchesURL(gurl)) {
-    std::string&& data_url = GetGoogleTagServicesPolyfillJS();
-    *new_url_spec = data_url;
-    return true;
-  }
+}  // namespace
+
+bool GetPolyfillForAdBlock(bool allow_brave_shields, bool allow_ads,
+    const GURL& tab_origin, const GURL& gurl, std::string* new_url_spec) {
+  return GetPolyfill<RequestRules>(allow_brave_shields, allow_ads, gurl,
+                                   new_url_spec);
+}
 
-  return false;
+bool GetPolyfillForAdBlockForTesting(bool allow_brave_shields,
+    bool allow_ads, const GURL& gurl, std::string* new_url_spec) {
+  return GetPolyfill<TestingRules>(allow_brave_shields, allow_ads, gurl,
+                                   new_url_spec);
 }
 
 void OnBeforeURLRequestAdBlockTP(
@@ -141,6 +192,23 @@ void OnBeforeURLRequestAdBlockTP(
   }
 }
 
+namespace {
+
+bool ShouldWaitForAdBlockEngine() {
+  static const bool wait_for_ad_block_engine =
+      base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kWaitForAdBlockEngine);
+  return wait_for_ad_block_engine;
+}
+
+void OnAdBlockClientReady(const ResponseCallback& next_callback,
+                          std::shared_ptr<BraveRequestInfo> ctx) {
+  OnBeforeURLRequestAdBlockTP(ctx);
+  next_callback.Run();
+}
+
+}  // namespace
+
 int OnBeforeURLRequest_AdBlockTPPreWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
@@ -149,18 +217,12 @@ int OnBeforeURLRequest_AdBlockTPPreWork(
     return net::OK;
   }
 
-  if (GetPolyfillForAdBlock(ctx->allow_brave_shields, ctx->allow_ads,
-        ctx->tab_origin, ctx->request_url, &ctx->new_url_spec)) {
-    return net::OK;
-  }
-
-  // Most blocked resources have been moved to our ad block lists.
-  // This is only for special cases like the PDFjs ping which can
-  // occur before the ad block lists are fully loaded.
-  if (IsBlockedResource(ctx->request_url)) {
-    ctx->new_url_spec = kEmptyDataURI;
-
-    return net::OK;
+  if (const PreWorkRule* rule = MatchPreWorkRule<RequestRules>(ctx->request_url)) {
+    if (rule->action == PreWorkAction::kBlock ||
+        (ctx->allow_brave_shields && !ctx->allow_ads)) {
+      ctx->new_url_spec = rule->new_url_spec;
+      return net::OK;
+    }
   }
 
   // If the following info isn't available, then proper content settings can't
@@ -171,6 +233,18 @@ int OnBeforeURLRequest_AdBlockTPPreWork(
     return net::OK;
   }
 
+  // Subresources requested while the default engine is still being loaded
+  // are matched once it is in use, rather than let through.
+  brave_shields::AdBlockService* ad_block_service =
+      g_brave_browser_process->ad_block_service();
+  if (ShouldWaitForAdBlockEngine() &&
+      ctx->resource_type != ResourceType::kMainFrame &&
+      ad_block_service->CanWaitForAdBlockClient()) {
+    ad_block_service->WaitForAdBlockClient(
+        base::BindOnce(&OnAdBlockClientReady, next_callback, ctx));
+    return net::ERR_IO_PENDING;
+  }
+
   OnBeforeURLRequestAdBlockTP(ctx);
 
   return net::OK;
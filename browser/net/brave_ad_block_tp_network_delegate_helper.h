@@ -16,6 +16,12 @@ int OnBeforeURLRequest_AdBlockTPPreWork(
 bool GetPolyfillForAdBlock(bool allow_brave_shields, bool allow_ads,
     const GURL& tab_origin, const GURL& gurl, std::string* new_url_spec);
 
+// Like GetPolyfillForAdBlock(), but matches against a separate copy of the
+// rules that only this function uses, so that a test can be the first to
+// use it.
+bool GetPolyfillForAdBlockForTesting(bool allow_brave_shields,
+    bool allow_ads, const GURL& gurl, std::string* new_url_spec);
+
 }  // namespace brave
 
 #endif  // BRAVE_BROWSER_NET_BRAVE_AD_BLOCK_TP_NETWORK_DELEGATE_H_
@@ -9,6 +9,10 @@
 #include <string>
 #include <vector>
 
+#include "base/bind.h"
+#include "base/strings/string_util.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
 #include "chrome/test/base/chrome_render_view_host_test_harness.h"
@@ -16,6 +20,7 @@
 #include "net/url_request/url_request_test_util.h"
 
 using brave::GetPolyfillForAdBlock;
+using brave::GetPolyfillForAdBlockForTesting;
 
 namespace {
 
@@ -183,4 +188,77 @@ TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, GetPolyfill) {
       &out_url_spec));
 }
 
+TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, GetPolyfillDataURL) {
+  GURL tab_origin("https://test.com");
+  std::string analytics_url_spec;
+  ASSERT_TRUE(GetPolyfillForAdBlock(true, false, tab_origin,
+      GURL(kGoogleAnalyticsPattern), &analytics_url_spec));
+  EXPECT_TRUE(base::StartsWith(analytics_url_spec, kJSDataURLPrefix,
+                               base::CompareCase::SENSITIVE));
+  EXPECT_GT(analytics_url_spec.size(), strlen(kJSDataURLPrefix));
+
+  // Each polyfill has its own data URL, which doesn't change.
+  std::string url_spec;
+  ASSERT_TRUE(GetPolyfillForAdBlock(true, false, tab_origin,
+      GURL(kGoogleAnalyticsPattern), &url_spec));
+  EXPECT_EQ(analytics_url_spec, url_spec);
+  ASSERT_TRUE(GetPolyfillForAdBlock(true, false, tab_origin,
+      GURL(kGoogleTagManagerPattern), &url_spec));
+  EXPECT_NE(analytics_url_spec, url_spec);
+
+  // Other paths on the polyfilled hosts are left alone.
+  EXPECT_FALSE(GetPolyfillForAdBlock(true, false, tab_origin,
+      GURL("https://www.google-analytics.com/ga.js"), &url_spec));
+  EXPECT_FALSE(GetPolyfillForAdBlock(true, false, tab_origin,
+      GURL("http://www.google-analytics.com/analytics.js"), &url_spec));
+  // Blocked resources aren't polyfills.
+  EXPECT_FALSE(GetPolyfillForAdBlock(true, false, tab_origin,
+      GURL("https://pdfjs.robwu.nl/ping"), &url_spec));
+}
+
+// The rules are shared by all threads, and built on whichever uses them first.
+// The testing copy of the rules is used, as other tests in this process may
+// already have built the one requests use.
+TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, GetPolyfillFromThreads) {
+  const size_t kThreads = 8;
+  std::vector<std::unique_ptr<base::Thread>> threads;
+  std::vector<std::string> url_specs(kThreads);
+  for (size_t i = 0; i < kThreads; ++i) {
+    threads.push_back(std::make_unique<base::Thread>(
+        "PolyfillThread" + std::to_string(i)));
+    ASSERT_TRUE(threads.back()->Start());
+  }
+  // Hold every thread until all of them are ready, so that they race to
+  // build the rules.
+  base::WaitableEvent start(base::WaitableEvent::ResetPolicy::MANUAL,
+                            base::WaitableEvent::InitialState::NOT_SIGNALED);
+  for (size_t i = 0; i < kThreads; ++i) {
+    threads[i]->task_runner()->PostTask(
+        FROM_HERE, base::BindOnce(
+                       [](base::WaitableEvent* start, std::string* url_spec) {
+                         start->Wait();
+                         EXPECT_TRUE(GetPolyfillForAdBlockForTesting(
+                             true, false, GURL(kGoogleTagServicesPattern),
+                             url_spec));
+                       },
+                       &start, &url_specs[i]));
+  }
+  start.Signal();
+  // Runs the pending tasks before joining.
+  for (auto& thread : threads)
+    thread->Stop();
+
+  for (const auto& url_spec : url_specs) {
+    EXPECT_TRUE(base::StartsWith(url_spec, kJSDataURLPrefix,
+                                 base::CompareCase::SENSITIVE));
+    EXPECT_EQ(url_specs[0], url_spec);
+  }
+  // The testing copy holds the same rules as the one requests use.
+  std::string url_spec;
+  ASSERT_TRUE(GetPolyfillForAdBlock(true, false, GURL("https://test.com"),
+                                    GURL(kGoogleTagServicesPattern),
+                                    &url_spec));
+  EXPECT_EQ(url_spec, url_specs[0]);
+}
+
 }  // namespace
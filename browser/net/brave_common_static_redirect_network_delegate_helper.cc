@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "brave/browser/net/brave_static_request_rules.h"
 #include "brave/common/network_constants.h"
 #include "components/component_updater/component_updater_url_constants.h"
 #include "extensions/buildflags/buildflags.h"
@@ -38,12 +39,16 @@ bool IsUpdaterURL(const GURL& gurl) {
   });
   return std::any_of(
       updater_patterns.begin(), updater_patterns.end(),
-      [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
+      [&gurl](const URLPattern& pattern) { return pattern.MatchesURL(gurl); });
 }
 
 int OnBeforeURLRequest_CommonStaticRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
+  if (!(ctx->static_request_rules & kCommonStaticRedirectRules)) {
+    return net::OK;
+  }
+
   GURL new_url;
   int rc = OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(ctx->request_url,
                                                               &new_url);
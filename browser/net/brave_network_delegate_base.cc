@@ -6,11 +6,13 @@
 #include "brave/browser/net/brave_network_delegate_base.h"
 
 #include <algorithm>
+#include <memory>
 #include <utility>
 
 #include "base/task/post_task.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
@@ -100,7 +102,6 @@ void RemoveTrackableSecurityHeadersForThirdParty(
 BraveNetworkDelegateBase::BraveNetworkDelegateBase(
     extensions::EventRouterForwarder* event_router)
     : ChromeNetworkDelegate(event_router),
-      referral_headers_list_(nullptr),
       allow_google_auth_(true) {
   // Initialize the preference change registrar.
   base::PostTaskWithTraits(
@@ -135,17 +136,22 @@ void BraveNetworkDelegateBase::OnReferralHeadersChanged() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
   if (const base::ListValue* referral_headers =
           g_browser_process->local_state()->GetList(kReferralHeaders)) {
+    // Compile the list here, once per change, rather than on the IO thread
+    // for every request.
     base::PostTaskWithTraits(
         FROM_HERE, {BrowserThread::IO},
-        base::Bind(&BraveNetworkDelegateBase::SetReferralHeaders,
-                   base::Unretained(this), referral_headers->DeepCopy()));
+        base::BindOnce(
+            &BraveNetworkDelegateBase::SetReferralHeaders,
+            base::Unretained(this),
+            std::make_unique<brave::ReferralHeadersMatcher>(
+                *referral_headers)));
   }
 }
 
 void BraveNetworkDelegateBase::SetReferralHeaders(
-    base::ListValue* referral_headers) {
+    std::unique_ptr<brave::ReferralHeadersMatcher> referral_headers) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
-  referral_headers_list_.reset(referral_headers);
+  referral_headers_matcher_ = std::move(referral_headers);
 }
 
 int BraveNetworkDelegateBase::OnBeforeURLRequest(
@@ -156,13 +162,11 @@ int BraveNetworkDelegateBase::OnBeforeURLRequest(
     return ChromeNetworkDelegate::OnBeforeURLRequest(
         request, std::move(callback), new_url);
   }
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
+  auto ctx = std::make_shared<brave::BraveRequestInfo>();
   brave::BraveRequestInfo::FillCTXFromRequest(request, ctx);
   ctx->new_url = new_url;
   ctx->event_type = brave::kOnBeforeRequest;
-  callbacks_[request->identifier()] = std::move(callback);
-  RunNextCallback(request, ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbacks(request, ctx, std::move(callback));
 }
 
 int BraveNetworkDelegateBase::OnBeforeStartTransaction(
@@ -173,14 +177,12 @@ int BraveNetworkDelegateBase::OnBeforeStartTransaction(
     return ChromeNetworkDelegate::OnBeforeStartTransaction(
         request, std::move(callback), headers);
   }
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
+  auto ctx = std::make_shared<brave::BraveRequestInfo>();
   brave::BraveRequestInfo::FillCTXFromRequest(request, ctx);
   ctx->event_type = brave::kOnBeforeStartTransaction;
   ctx->headers = headers;
-  ctx->referral_headers_list = referral_headers_list_.get();
-  callbacks_[request->identifier()] = std::move(callback);
-  RunNextCallback(request, ctx);
-  return net::ERR_IO_PENDING;
+  ctx->referral_headers_matcher = referral_headers_matcher_.get();
+  return StartCallbacks(request, ctx, std::move(callback));
 }
 
 int BraveNetworkDelegateBase::OnHeadersReceived(
@@ -201,30 +203,20 @@ int BraveNetworkDelegateBase::OnHeadersReceived(
         override_response_headers, allowed_unsafe_redirect_url);
   }
 
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
-  callbacks_[request->identifier()] = std::move(callback);
+  auto ctx = std::make_shared<brave::BraveRequestInfo>();
   brave::BraveRequestInfo::FillCTXFromRequest(request, ctx);
   ctx->event_type = brave::kOnHeadersReceived;
   ctx->original_response_headers = original_response_headers;
   ctx->override_response_headers = override_response_headers;
   ctx->allowed_unsafe_redirect_url = allowed_unsafe_redirect_url;
-
-  // Return ERR_IO_PENDING and run callbacks later by posting a task.
-  // URLRequestHttpJob::awaiting_callback_ will be set to true after we
-  // return net::ERR_IO_PENDING here, callbacks need to be run later than this
-  // to set awaiting_callback_ back to false.
-  base::PostTaskWithTraits(
-      FROM_HERE, {BrowserThread::IO},
-      base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
-                 base::Unretained(this), request, ctx));
-  return net::ERR_IO_PENDING;
+  return StartCallbacks(request, ctx, std::move(callback));
 }
 
 bool BraveNetworkDelegateBase::OnCanGetCookies(
     const URLRequest& request,
     const net::CookieList& cookie_list,
     bool allowed_from_caller) {
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
+  auto ctx = std::make_shared<brave::BraveRequestInfo>();
   ctx->allow_google_auth = allow_google_auth_;
   brave::BraveRequestInfo::FillCTXFromRequest(&request, ctx);
   ctx->event_type = brave::kOnCanGetCookies;
@@ -237,7 +229,7 @@ bool BraveNetworkDelegateBase::OnCanSetCookie(
     const net::CanonicalCookie& cookie,
     net::CookieOptions* options,
     bool allowed_from_caller) {
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
+  auto ctx = std::make_shared<brave::BraveRequestInfo>();
   ctx->allow_google_auth = allow_google_auth_;
   brave::BraveRequestInfo::FillCTXFromRequest(&request, ctx);
   ctx->event_type = brave::kOnCanSetCookies;
@@ -248,39 +240,49 @@ bool BraveNetworkDelegateBase::OnCanSetCookie(
 void BraveNetworkDelegateBase::RunCallbackForRequestIdentifier(
     uint64_t request_identifier,
     int rv) {
-  std::map<uint64_t, net::CompletionOnceCallback>::iterator it =
-      callbacks_.find(request_identifier);
-  std::move(it->second).Run(rv);
+  auto it = callbacks_.find(request_identifier);
+  if (it == callbacks_.end()) {
+    return;
+  }
+  net::CompletionOnceCallback callback = std::move(it->second);
+  callbacks_.erase(it);
+  std::move(callback).Run(rv);
 }
 
-void BraveNetworkDelegateBase::RunNextCallback(
+int BraveNetworkDelegateBase::StartCallbacks(
+    URLRequest* request,
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    net::CompletionOnceCallback callback) {
+  // Most requests go through all of the callbacks synchronously, and are
+  // handed on to ChromeNetworkDelegate right away. |callback| is only kept
+  // for the ones that have to wait for a callback that went async.
+  int rv = RunCallbacks(request, ctx);
+  if (rv == net::ERR_IO_PENDING) {
+    callbacks_[ctx->request_identifier] = std::move(callback);
+    return rv;
+  }
+  return OnCallbacksDone(request, ctx, rv, std::move(callback));
+}
+
+int BraveNetworkDelegateBase::RunCallbacks(
     URLRequest* request,
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
 
-  if (!ContainsKey(callbacks_, ctx->request_identifier)) {
-    return;
-  }
-
-  if (request->status().status() == net::URLRequestStatus::CANCELED) {
-    return;
-  }
+  // Bound once for all of the callbacks, only the ones that go async hold on
+  // to it.
+  brave::ResponseCallback next_callback =
+      base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
+                 base::Unretained(this), request, ctx);
 
-  // Continue processing callbacks until we hit one that returns PENDING
+  // Continue processing callbacks until we hit one that doesn't return OK.
   int rv = net::OK;
-
   if (ctx->event_type == brave::kOnBeforeRequest) {
     while (before_url_request_callbacks_.size() !=
            ctx->next_url_request_index) {
-      brave::OnBeforeURLRequestCallback callback =
+      const brave::OnBeforeURLRequestCallback& callback =
           before_url_request_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
-                     base::Unretained(this), request, ctx);
       rv = callback.Run(next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
       if (rv != net::OK) {
         break;
       }
@@ -288,77 +290,91 @@ void BraveNetworkDelegateBase::RunNextCallback(
   } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
     while (before_start_transaction_callbacks_.size() !=
            ctx->next_url_request_index) {
-      brave::OnBeforeStartTransactionCallback callback =
+      const brave::OnBeforeStartTransactionCallback& callback =
           before_start_transaction_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
-                     base::Unretained(this), request, ctx);
       rv = callback.Run(ctx->headers, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
       if (rv != net::OK) {
         break;
       }
     }
   } else if (ctx->event_type == brave::kOnHeadersReceived) {
     while (headers_received_callbacks_.size() != ctx->next_url_request_index) {
-      brave::OnHeadersReceivedCallback callback =
+      const brave::OnHeadersReceivedCallback& callback =
           headers_received_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
-                     base::Unretained(this), request, ctx);
       rv = callback.Run(ctx->original_response_headers,
                         ctx->override_response_headers,
                         ctx->allowed_unsafe_redirect_url, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
       if (rv != net::OK) {
         break;
       }
     }
   }
+  return rv;
+}
 
+int BraveNetworkDelegateBase::OnCallbacksDone(
+    URLRequest* request,
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    int rv,
+    net::CompletionOnceCallback callback) {
   if (rv != net::OK) {
-    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
-    return;
+    return rv;
   }
 
-  net::CompletionOnceCallback wrapped_callback =
-      base::BindOnce(&BraveNetworkDelegateBase::RunCallbackForRequestIdentifier,
-                     base::Unretained(this), ctx->request_identifier);
-
   if (ctx->event_type == brave::kOnBeforeRequest) {
     if (!ctx->new_url_spec.empty() &&
-        (ctx->new_url_spec != ctx->request_url.spec()) &&
-        IsRequestIdentifierValid(ctx->request_identifier)) {
+        (ctx->new_url_spec != ctx->request_url.spec())) {
       *ctx->new_url = GURL(ctx->new_url_spec);
     }
     if (ctx->blocked_by == brave::kAdBlocked) {
       // We are going to intercept this request and block it later in the
       // network stack.
       if (ctx->cancel_request_explicitly) {
-        RunCallbackForRequestIdentifier(ctx->request_identifier,
-            net::ERR_ABORTED);
-        return;
+        return net::ERR_ABORTED;
       }
       request->SetExtraRequestHeaderByName("X-Brave-Block", "", true);
     }
     if (!ctx->new_referrer.is_empty()) {
       request->SetReferrer(ctx->new_referrer.spec());
     }
-    rv = ChromeNetworkDelegate::OnBeforeURLRequest(
-        request, std::move(wrapped_callback), ctx->new_url);
-  } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
-    rv = ChromeNetworkDelegate::OnBeforeStartTransaction(
-        request, std::move(wrapped_callback), ctx->headers);
-  } else if (ctx->event_type == brave::kOnHeadersReceived) {
-    rv = ChromeNetworkDelegate::OnHeadersReceived(
-        request, std::move(wrapped_callback), ctx->original_response_headers,
-        ctx->override_response_headers, ctx->allowed_unsafe_redirect_url);
+    return ChromeNetworkDelegate::OnBeforeURLRequest(
+        request, std::move(callback), ctx->new_url);
+  }
+
+  if (ctx->event_type == brave::kOnBeforeStartTransaction) {
+    return ChromeNetworkDelegate::OnBeforeStartTransaction(
+        request, std::move(callback), ctx->headers);
+  }
+
+  DCHECK_EQ(brave::kOnHeadersReceived, ctx->event_type);
+  return ChromeNetworkDelegate::OnHeadersReceived(
+      request, std::move(callback), ctx->original_response_headers,
+      ctx->override_response_headers, ctx->allowed_unsafe_redirect_url);
+}
+
+void BraveNetworkDelegateBase::RunNextCallback(
+    URLRequest* request,
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+
+  if (!ContainsKey(callbacks_, ctx->request_identifier)) {
+    return;
   }
 
+  if (request->status().status() == net::URLRequestStatus::CANCELED) {
+    return;
+  }
+
+  int rv = RunCallbacks(request, ctx);
+  if (rv == net::ERR_IO_PENDING) {
+    return;
+  }
+
+  rv = OnCallbacksDone(
+      request, ctx, rv,
+      base::BindOnce(
+          &BraveNetworkDelegateBase::RunCallbackForRequestIdentifier,
+          base::Unretained(this), ctx->request_identifier));
   // ChromeNetworkDelegate returns net::ERR_IO_PENDING if an extension is
   // intercepting the request and OK if the request should proceed normally.
   if (rv != net::ERR_IO_PENDING) {
@@ -367,9 +383,7 @@ void BraveNetworkDelegateBase::RunNextCallback(
 }
 
 void BraveNetworkDelegateBase::OnURLRequestDestroyed(URLRequest* request) {
-  if (ContainsKey(callbacks_, request->identifier())) {
-    callbacks_.erase(request->identifier());
-  }
+  callbacks_.erase(request->identifier());
   ChromeNetworkDelegate::OnURLRequestDestroyed(request);
 }
 
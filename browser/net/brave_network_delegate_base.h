@@ -6,11 +6,11 @@
 #ifndef BRAVE_BROWSER_NET_BRAVE_NETWORK_DELEGATE_BASE_H_
 #define BRAVE_BROWSER_NET_BRAVE_NETWORK_DELEGATE_BASE_H_
 
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/files/file_path.h"
 #include "base/strings/string_piece.h"
@@ -21,6 +21,10 @@
 
 class PrefChangeRegistrar;
 
+namespace brave {
+class ReferralHeadersMatcher;
+}
+
 namespace extensions {
 class EventRouterForwarder;
 }
@@ -82,23 +86,38 @@ class BraveNetworkDelegateBase : public ChromeNetworkDelegate {
   void set_allow_google_auth(bool allow);
   const base::FilePath& profile_path() { return profile_path_; }
 
+  // Callbacks that return net::ERR_IO_PENDING have to run |next_callback|
+  // asynchronously.
   std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
   std::vector<brave::OnBeforeStartTransactionCallback>
       before_start_transaction_callbacks_;
   std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
 
  private:
+  int StartCallbacks(net::URLRequest* request,
+                     std::shared_ptr<brave::BraveRequestInfo> ctx,
+                     net::CompletionOnceCallback callback);
+  // Runs the callbacks that are left for |ctx|'s event, until one of them
+  // doesn't return net::OK.
+  int RunCallbacks(net::URLRequest* request,
+                   std::shared_ptr<brave::BraveRequestInfo> ctx);
+  int OnCallbacksDone(net::URLRequest* request,
+                      std::shared_ptr<brave::BraveRequestInfo> ctx,
+                      int rv,
+                      net::CompletionOnceCallback callback);
   void InitPrefChangeRegistrarOnUI();
-  void SetReferralHeaders(base::ListValue* referral_headers);
+  void SetReferralHeaders(
+      std::unique_ptr<brave::ReferralHeadersMatcher> referral_headers);
   void OnReferralHeadersChanged();
 
-  // TODO(iefremov): actually, we don't have to keep the list here, since
+  // TODO(iefremov): actually, we don't have to keep the matcher here, since
   // it is global for the whole browser and could live a singletonce in the
   // rewards service. Eliminating this will also help to avoid using
   // PrefChangeRegistrar and corresponding |base::Unretained| usages, that are
   // illegal.
-  std::unique_ptr<base::ListValue> referral_headers_list_;
-  std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
+  std::unique_ptr<brave::ReferralHeadersMatcher> referral_headers_matcher_;
+  // Requests waiting for a callback that went async, or for an extension.
+  base::flat_map<uint64_t, net::CompletionOnceCallback> callbacks_;
   std::unique_ptr<PrefChangeRegistrar, content::BrowserThread::DeleteOnUIThread>
       pref_change_registrar_;
 
@@ -0,0 +1,138 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_network_delegate_base.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/run_loop.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/browser/net/url_context.h"
+#include "chrome/test/base/scoped_testing_local_state.h"
+#include "chrome/test/base/testing_browser_process.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "net/http/http_response_headers.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "net/url_request/url_request_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+// npm run test -- brave_unit_tests --filter=BraveNetworkDelegateBasePerfTest.*
+
+namespace {
+
+const int kIterations = 1000;
+const int kRequests = 10;
+// About as many as the profile network delegate has per event.
+const int kCallbacksPerEvent = 6;
+
+int OnBeforeURLRequest_NoOp(const brave::ResponseCallback& next_callback,
+                            std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  return net::OK;
+}
+
+int OnBeforeStartTransaction_NoOp(
+    net::HttpRequestHeaders* headers,
+    const brave::ResponseCallback& next_callback,
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  return net::OK;
+}
+
+int OnHeadersReceived_NoOp(
+    const net::HttpResponseHeaders* original_response_headers,
+    scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
+    GURL* allowed_unsafe_redirect_url,
+    const brave::ResponseCallback& next_callback,
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  return net::OK;
+}
+
+// Callbacks that leave all requests alone, so that only the cost of running
+// them is measured.
+class NoOpBraveNetworkDelegate : public BraveNetworkDelegateBase {
+ public:
+  NoOpBraveNetworkDelegate() : BraveNetworkDelegateBase(nullptr) {
+    for (int i = 0; i < kCallbacksPerEvent; ++i) {
+      before_url_request_callbacks_.push_back(
+          base::Bind(&OnBeforeURLRequest_NoOp));
+      before_start_transaction_callbacks_.push_back(
+          base::Bind(&OnBeforeStartTransaction_NoOp));
+      headers_received_callbacks_.push_back(
+          base::Bind(&OnHeadersReceived_NoOp));
+    }
+  }
+  ~NoOpBraveNetworkDelegate() override {}
+};
+
+class BraveNetworkDelegateBasePerfTest : public testing::Test {
+ public:
+  BraveNetworkDelegateBasePerfTest()
+      : local_state_(TestingBrowserProcess::GetGlobal()),
+        thread_bundle_(content::TestBrowserThreadBundle::IO_MAINLOOP),
+        context_(new net::TestURLRequestContext(true)) {}
+  ~BraveNetworkDelegateBasePerfTest() override {}
+  void SetUp() override {
+    context_->Init();
+    delegate_.reset(new NoOpBraveNetworkDelegate());
+    // Let the delegate initialize.
+    base::RunLoop().RunUntilIdle();
+    for (int i = 0; i < kRequests; ++i) {
+      requests_.push_back(context_->CreateRequest(
+          GURL("https://www.example.com/" + std::to_string(i)), net::IDLE,
+          &test_delegate_, TRAFFIC_ANNOTATION_FOR_TESTS));
+    }
+  }
+  void TearDown() override {
+    requests_.clear();
+    delegate_.reset();
+  }
+
+ protected:
+  std::unique_ptr<NoOpBraveNetworkDelegate> delegate_;
+  std::vector<std::unique_ptr<net::URLRequest>> requests_;
+
+ private:
+  ScopedTestingLocalState local_state_;
+  content::TestBrowserThreadBundle thread_bundle_;
+  std::unique_ptr<net::TestURLRequestContext> context_;
+  net::TestDelegate test_delegate_;
+};
+
+}  // namespace
+
+// All three events of a request that none of the callbacks hold up.
+TEST_F(BraveNetworkDelegateBasePerfTest, RequestEvents) {
+  scoped_refptr<net::HttpResponseHeaders> response_headers =
+      new net::HttpResponseHeaders("HTTP/1.1 200 OK");
+
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kIterations; ++i) {
+    for (const auto& request : requests_) {
+      GURL new_url;
+      EXPECT_EQ(net::OK, delegate_->OnBeforeURLRequest(
+                             request.get(), base::DoNothing(), &new_url));
+
+      net::HttpRequestHeaders headers;
+      EXPECT_EQ(net::OK, delegate_->OnBeforeStartTransaction(
+                             request.get(), base::DoNothing(), &headers));
+
+      scoped_refptr<net::HttpResponseHeaders> override_response_headers;
+      GURL allowed_unsafe_redirect_url;
+      EXPECT_EQ(net::OK,
+                delegate_->OnHeadersReceived(
+                    request.get(), base::DoNothing(), response_headers.get(),
+                    &override_response_headers,
+                    &allowed_unsafe_redirect_url));
+    }
+  }
+  perf_test::PrintResult(
+      "network_delegate", "", "per_request",
+      timer.Elapsed().InMicrosecondsF() / (kIterations * requests_.size()),
+      "us", true);
+}
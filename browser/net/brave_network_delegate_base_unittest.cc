@@ -5,10 +5,16 @@
 
 #include "brave/browser/net/brave_network_delegate_base.h"
 
+#include <memory>
 #include <string>
 
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "brave/browser/net/url_context.h"
 #include "chrome/test/base/chrome_render_view_host_test_harness.h"
+#include "chrome/test/base/scoped_testing_local_state.h"
+#include "chrome/test/base/testing_browser_process.h"
 #include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
 #include "net/url_request/url_request_test_util.h"
 #include "url/gurl.h"
@@ -37,19 +43,104 @@ const char kRawHeaders[] =
     "report-uri=\"https://www.pkp.org/hpkp-report\"\n"
     "X-XSS-Protection: 0";
 
+const char kRedirectURL[] = "https://brave.com/";
+
+class TestBraveNetworkDelegate : public BraveNetworkDelegateBase {
+ public:
+  TestBraveNetworkDelegate() : BraveNetworkDelegateBase(nullptr) {}
+  ~TestBraveNetworkDelegate() override {}
+
+  void AddBeforeURLRequestCallback(
+      const brave::OnBeforeURLRequestCallback& callback) {
+    before_url_request_callbacks_.push_back(callback);
+  }
+};
+
+int OnBeforeURLRequest_Redirect(const brave::ResponseCallback& next_callback,
+                                std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  ctx->new_url_spec = kRedirectURL;
+  return net::OK;
+}
+
+int OnBeforeURLRequest_Async(const brave::ResponseCallback& next_callback,
+                             std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE, next_callback);
+  return net::ERR_IO_PENDING;
+}
+
+void OnRequestCompleted(int* result, int rv) {
+  *result = rv;
+}
+
 class BraveNetworkDelegateBaseTest : public testing::Test {
  public:
   BraveNetworkDelegateBaseTest()
-      : thread_bundle_(content::TestBrowserThreadBundle::IO_MAINLOOP),
+      : local_state_(TestingBrowserProcess::GetGlobal()),
+        thread_bundle_(content::TestBrowserThreadBundle::IO_MAINLOOP),
         context_(new net::TestURLRequestContext(true)) {}
   ~BraveNetworkDelegateBaseTest() override {}
-  void SetUp() override { context_->Init(); }
+  void SetUp() override {
+    context_->Init();
+    delegate_.reset(new TestBraveNetworkDelegate());
+    // Let the delegate initialize.
+    base::RunLoop().RunUntilIdle();
+  }
+
+  net::TestURLRequestContext* context() { return context_.get(); }
+  TestBraveNetworkDelegate* delegate() { return delegate_.get(); }
 
  private:
+  ScopedTestingLocalState local_state_;
   content::TestBrowserThreadBundle thread_bundle_;
   std::unique_ptr<net::TestURLRequestContext> context_;
+  std::unique_ptr<TestBraveNetworkDelegate> delegate_;
 };
 
+TEST_F(BraveNetworkDelegateBaseTest, RunsCallbacksSynchronously) {
+  delegate()->AddBeforeURLRequestCallback(
+      base::Bind(&OnBeforeURLRequest_Redirect));
+  net::TestDelegate test_delegate;
+  std::unique_ptr<net::URLRequest> request = context()->CreateRequest(
+      GURL(kFirstPartyDomain), net::IDLE, &test_delegate,
+      TRAFFIC_ANNOTATION_FOR_TESTS);
+
+  GURL new_url;
+  int result = net::ERR_IO_PENDING;
+  EXPECT_EQ(net::OK, delegate()->OnBeforeURLRequest(
+                         request.get(),
+                         base::BindOnce(&OnRequestCompleted, &result),
+                         &new_url));
+  EXPECT_EQ(GURL(kRedirectURL), new_url);
+  // The request was handed on without waiting.
+  EXPECT_EQ(net::ERR_IO_PENDING, result);
+  EXPECT_FALSE(delegate()->IsRequestIdentifierValid(request->identifier()));
+}
+
+TEST_F(BraveNetworkDelegateBaseTest, WaitsForAsyncCallbacks) {
+  delegate()->AddBeforeURLRequestCallback(
+      base::Bind(&OnBeforeURLRequest_Async));
+  delegate()->AddBeforeURLRequestCallback(
+      base::Bind(&OnBeforeURLRequest_Redirect));
+  net::TestDelegate test_delegate;
+  std::unique_ptr<net::URLRequest> request = context()->CreateRequest(
+      GURL(kFirstPartyDomain), net::IDLE, &test_delegate,
+      TRAFFIC_ANNOTATION_FOR_TESTS);
+
+  GURL new_url;
+  int result = net::ERR_IO_PENDING;
+  EXPECT_EQ(net::ERR_IO_PENDING,
+            delegate()->OnBeforeURLRequest(
+                request.get(), base::BindOnce(&OnRequestCompleted, &result),
+                &new_url));
+  EXPECT_TRUE(new_url.is_empty());
+  EXPECT_TRUE(delegate()->IsRequestIdentifierValid(request->identifier()));
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(net::OK, result);
+  EXPECT_EQ(GURL(kRedirectURL), new_url);
+  EXPECT_FALSE(delegate()->IsRequestIdentifierValid(request->identifier()));
+}
+
 TEST_F(BraveNetworkDelegateBaseTest, RemoveTrackableSecurityHeaders) {
   net::TestDelegate test_delegate;
   GURL request_url(kThirdPartyDomain);
@@ -0,0 +1,144 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
+#include "brave/browser/net/brave_common_static_redirect_network_delegate_helper.h"
+#include "brave/browser/net/brave_site_hacks_network_delegate_helper.h"
+#include "brave/browser/net/brave_static_redirect_network_delegate_helper.h"
+#include "brave/browser/net/brave_static_request_rules.h"
+#include "brave/browser/net/url_context.h"
+#include "brave/browser/translate/buildflags/buildflags.h"
+#include "brave/common/network_constants.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "net/url_request/url_request_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE)
+#include "brave/browser/net/brave_translate_redirect_network_delegate_helper.h"
+#endif
+
+// npm run test -- brave_unit_tests --filter=BraveNetworkDelegateHelpersPerfTest.*
+
+namespace {
+
+const int kIterations = 1000;
+
+// Mostly requests to hosts without any rules, like a page load makes.
+const char* const kRequestURLs[] = {
+    "https://www.example.com/",
+    "https://www.example.com/app.js",
+    "https://cdn.example.net/styles/main.css",
+    "https://cdn.example.net/images/logo.png",
+    "https://fonts.example.org/roboto.woff2",
+    "https://api.example.com/v1/feed?page=2",
+    "https://static.example.com/vendor.js",
+    "https://www.forbes.com/",
+    "https://www.google-analytics.com/analytics.js",
+    "https://clients4.google.com/chrome-sync/dev",
+    "https://translate.googleapis.com/translate_static/js/element/main.js",
+};
+
+class BraveNetworkDelegateHelpersPerfTest : public testing::Test {
+ public:
+  BraveNetworkDelegateHelpersPerfTest()
+      : thread_bundle_(content::TestBrowserThreadBundle::IO_MAINLOOP),
+        context_(new net::TestURLRequestContext(true)) {}
+  ~BraveNetworkDelegateHelpersPerfTest() override {}
+  void SetUp() override {
+    context_->Init();
+    for (const char* url : kRequestURLs) {
+      requests_.push_back(context_->CreateRequest(
+          GURL(url), net::IDLE, &test_delegate_,
+          TRAFFIC_ANNOTATION_FOR_TESTS));
+    }
+  }
+
+ protected:
+  std::vector<std::unique_ptr<net::URLRequest>> requests_;
+
+ private:
+  content::TestBrowserThreadBundle thread_bundle_;
+  std::unique_ptr<net::TestURLRequestContext> context_;
+  net::TestDelegate test_delegate_;
+};
+
+}  // namespace
+
+// The helpers of both network delegates that don't need browser wide
+// services, run the way BraveNetworkDelegateBase runs them.
+TEST_F(BraveNetworkDelegateHelpersPerfTest, CallbackChain) {
+  std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks =
+      {
+          base::Bind(brave::OnBeforeURLRequest_SiteHacksWork),
+          base::Bind(brave::OnBeforeURLRequest_StaticRedirectWork),
+          base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork),
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE)
+          base::Bind(brave::OnBeforeURLRequest_TranslateRedirectWork),
+#endif
+      };
+  brave::ResponseCallback next_callback;
+
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kIterations; ++i) {
+    for (const auto& request : requests_) {
+      std::shared_ptr<brave::BraveRequestInfo> ctx(
+          new brave::BraveRequestInfo());
+      brave::BraveRequestInfo::FillCTXFromRequest(request.get(), ctx);
+      for (const auto& callback : before_url_request_callbacks)
+        EXPECT_EQ(net::OK, callback.Run(next_callback, ctx));
+
+      net::HttpRequestHeaders headers;
+      headers.SetHeader(kUserAgentHeader, "Chrome");
+      EXPECT_EQ(net::OK, brave::OnBeforeStartTransaction_SiteHacksWork(
+                             &headers, next_callback, ctx));
+    }
+  }
+  perf_test::PrintResult(
+      "callback_chain", "", "per_request",
+      timer.Elapsed().InMicrosecondsF() / (kIterations * requests_.size()),
+      "us", true);
+}
+
+TEST_F(BraveNetworkDelegateHelpersPerfTest, StaticRequestRules) {
+  uint32_t rules = brave::kNoStaticRequestRules;
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kIterations; ++i) {
+    for (const auto& request : requests_)
+      rules |= brave::GetStaticRequestRules(request->url());
+  }
+  perf_test::PrintResult(
+      "static_request_rules", "", "per_request",
+      timer.Elapsed().InMicrosecondsF() / (kIterations * requests_.size()),
+      "us", true);
+  EXPECT_NE(brave::kNoStaticRequestRules, rules);
+}
+
+TEST_F(BraveNetworkDelegateHelpersPerfTest, PolyfillForAdBlock) {
+  GURL tab_origin("https://www.example.com/");
+  size_t polyfills = 0;
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kIterations; ++i) {
+    for (const auto& request : requests_) {
+      std::string new_url_spec;
+      if (brave::GetPolyfillForAdBlock(true, false, tab_origin, request->url(),
+                                       &new_url_spec)) {
+        polyfills++;
+      }
+    }
+  }
+  perf_test::PrintResult(
+      "polyfill_for_ad_block", "", "per_request",
+      timer.Elapsed().InMicrosecondsF() / (kIterations * requests_.size()),
+      "us", true);
+  EXPECT_EQ(static_cast<size_t>(kIterations), polyfills);
+}
@@ -11,6 +11,7 @@
 #include "base/json/json_reader.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
 #include "chrome/test/base/chrome_render_view_host_test_harness.h"
 #include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
 #include "net/url_request/url_request_test_util.h"
@@ -89,7 +90,8 @@ TEST_F(BraveReferralsNetworkDelegateHelperTest,
       new brave::BraveRequestInfo());
   brave::BraveRequestInfo::FillCTXFromRequest(request.get(),
                                               brave_request_info);
-  brave_request_info->referral_headers_list = referral_headers_list;
+  brave::ReferralHeadersMatcher matcher(*referral_headers_list);
+  brave_request_info->referral_headers_matcher = &matcher;
   int ret = brave::OnBeforeStartTransaction_ReferralsWork(
       &headers, callback, brave_request_info);
 
@@ -123,7 +125,8 @@ TEST_F(BraveReferralsNetworkDelegateHelperTest,
   brave::ResponseCallback callback;
   std::shared_ptr<brave::BraveRequestInfo> brave_request_info(
       new brave::BraveRequestInfo());
-  brave_request_info->referral_headers_list = referral_headers_list;
+  brave::ReferralHeadersMatcher matcher(*referral_headers_list);
+  brave_request_info->referral_headers_matcher = &matcher;
   int ret = brave::OnBeforeStartTransaction_ReferralsWork(
       &headers, callback, brave_request_info);
 
@@ -132,4 +135,30 @@ TEST_F(BraveReferralsNetworkDelegateHelperTest,
   EXPECT_EQ(ret, net::OK);
 }
 
+TEST_F(BraveReferralsNetworkDelegateHelperTest, MatcherMatchesDomainSuffix) {
+  base::Optional<base::Value> referral_headers =
+      base::JSONReader().ReadToValue(kTestReferralHeaders);
+  ASSERT_TRUE(referral_headers);
+  ASSERT_TRUE(referral_headers->is_list());
+
+  base::ListValue* referral_headers_list = nullptr;
+  referral_headers->GetAsList(&referral_headers_list);
+  brave::ReferralHeadersMatcher matcher(*referral_headers_list);
+
+  const brave::ReferralHeadersMatcher::Headers* headers =
+      matcher.GetMatchingHeaders(GURL("http://a.b.xxlmag.com/path"));
+  ASSERT_TRUE(headers);
+  EXPECT_EQ(headers->size(), 1UL);
+  EXPECT_EQ(headers->front().first, kBravePartnerHeader);
+  EXPECT_EQ(headers->front().second, "townsquare");
+
+  headers = matcher.GetMatchingHeaders(GURL("https://barrons.com"));
+  ASSERT_TRUE(headers);
+  EXPECT_EQ(headers->size(), 2UL);
+
+  EXPECT_FALSE(matcher.GetMatchingHeaders(GURL("https://notbarrons.com")));
+  EXPECT_FALSE(matcher.GetMatchingHeaders(GURL("https://barrons.com.evil")));
+  EXPECT_FALSE(matcher.GetMatchingHeaders(GURL("ftp://barrons.com")));
+}
+
 }  // namespace
@@ -10,6 +10,7 @@
 
 #include "base/sequenced_task_runner.h"
 #include "base/strings/string_util.h"
+#include "brave/browser/net/brave_static_request_rules.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/shield_exceptions.h"
 #include "brave/common/url_constants.h"
@@ -73,8 +74,9 @@ void CheckForCookieOverride(const GURL& url, const URLPattern& pattern,
 
 bool IsBlockTwitterSiteHack(std::shared_ptr<BraveRequestInfo> ctx,
                             net::HttpRequestHeaders* headers) {
-  URLPattern redirectURLPattern(URLPattern::SCHEME_ALL, kTwitterRedirectURL);
-  URLPattern referrerPattern(URLPattern::SCHEME_ALL, kTwitterReferrer);
+  static URLPattern redirectURLPattern(URLPattern::SCHEME_ALL,
+                                       kTwitterRedirectURL);
+  static URLPattern referrerPattern(URLPattern::SCHEME_ALL, kTwitterReferrer);
   if (redirectURLPattern.MatchesURL(ctx->request_url)) {
     std::string referrer;
     if (headers->GetHeader(kRefererHeader, &referrer) &&
@@ -89,8 +91,12 @@ int OnBeforeStartTransaction_SiteHacksWork(
     net::HttpRequestHeaders* headers,
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
-  CheckForCookieOverride(ctx->request_url,
-      URLPattern(URLPattern::SCHEME_ALL, kForbesPattern), headers,
+  if (!(ctx->static_request_rules & kSiteHackHeaderRules)) {
+    return net::OK;
+  }
+
+  static URLPattern forbes_pattern(URLPattern::SCHEME_ALL, kForbesPattern);
+  CheckForCookieOverride(ctx->request_url, forbes_pattern, headers,
       kForbesExtraCookies);
   if (IsBlockTwitterSiteHack(ctx, headers)) {
     return net::ERR_ABORTED;
@@ -8,6 +8,7 @@
 #include <memory>
 #include <vector>
 
+#include "brave/browser/net/brave_static_request_rules.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/translate_network_constants.h"
@@ -15,21 +16,9 @@
 
 namespace brave {
 
-int OnBeforeURLRequest_StaticRedirectWork(
-    const ResponseCallback& next_callback,
-    std::shared_ptr<BraveRequestInfo> ctx) {
-  GURL new_url;
-  int rc = OnBeforeURLRequest_StaticRedirectWorkForGURL(ctx->request_url,
-                                                        &new_url);
-  if (!new_url.is_empty()) {
-    ctx->new_url_spec = new_url.spec();
-  }
-  return rc;
-}
+namespace {
 
-int OnBeforeURLRequest_StaticRedirectWorkForGURL(
-    const GURL& request_url,
-    GURL* new_url) {
+bool GetStaticRedirectURL(const GURL& request_url, GURL* new_url) {
   GURL::Replacements replacements;
   static URLPattern geo_pattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern);
   static URLPattern safeBrowsing_pattern(URLPattern::SCHEME_HTTPS,
@@ -54,54 +43,54 @@ int OnBeforeURLRequest_StaticRedirectWorkForGURL(
 #endif
   if (geo_pattern.MatchesURL(request_url)) {
     *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
-    return net::OK;
+    return true;
   }
 
   if (safeBrowsing_pattern.MatchesHost(request_url)) {
     replacements.SetHostStr(SAFEBROWSING_ENDPOINT);
     *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
+    return true;
   }
 
   if (safebrowsingfilecheck_pattern.MatchesHost(request_url)) {
     replacements.SetHostStr(kBraveSafeBrowsingFileCheckProxy);
     *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
+    return true;
   }
 
   if (crxDownload_pattern.MatchesURL(request_url)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr("crxdownload.brave.com");
     *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
+    return true;
   }
 
   if (crlSet_pattern1.MatchesURL(request_url)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr("crlsets.brave.com");
     *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
+    return true;
   }
 
   if (crlSet_pattern2.MatchesURL(request_url)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr("crlsets.brave.com");
     *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
+    return true;
   }
 
   if (crlSet_pattern3.MatchesURL(request_url)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr("crlsets.brave.com");
     *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
+    return true;
   }
 
   if (crlSet_pattern4.MatchesURL(request_url)) {
     replacements.SetSchemeStr("https");
     replacements.SetHostStr("crlsets.brave.com");
     *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
+    return true;
   }
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE)
   if (translate_pattern.MatchesURL(request_url)) {
@@ -109,17 +98,21 @@ int OnBeforeURLRequest_StaticRedirectWorkForGURL(
     replacements.SetPathStr(request_url.path_piece());
     *new_url =
       GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements);
-    return net::OK;
+    return true;
   }
 
   if (translate_language_pattern.MatchesURL(request_url)) {
     *new_url = GURL(kBraveTranslateLanguageEndpoint);
-    return net::OK;
+    return true;
   }
 #endif
 
+  return false;
+}
+
 #if !defined(NDEBUG)
-  GURL gurl = request_url;
+void CheckSystemRequestIsAllowed(const GURL& request_url) {
+  const GURL& gurl = request_url;
   static std::vector<URLPattern> allowed_patterns({
       // Brave updates
       URLPattern(URLPattern::SCHEME_HTTPS, "https://go-updater.brave.com/*"),
@@ -175,7 +168,7 @@ int OnBeforeURLRequest_StaticRedirectWorkForGURL(
   // allowed patterns
   bool is_url_allowed =
       std::any_of(allowed_patterns.begin(), allowed_patterns.end(),
-                  [&gurl](URLPattern pattern) {
+                  [&gurl](const URLPattern& pattern) {
                     if (pattern.MatchesURL(gurl)) {
                       return true;
                     }
@@ -190,10 +183,40 @@ int OnBeforeURLRequest_StaticRedirectWorkForGURL(
   // http://192.168.0.27:60000/upnp/dev/e16bf493-ed87-5798-ffff-ffffeb4f1c34/desc
   // And also I don't know where they're from, but there's always 3 requests
   // similar to this: http://vijscbncpv/
+}
+#endif
+
+void StaticRedirectWork(const GURL& request_url,
+                        uint32_t static_request_rules,
+                        GURL* new_url) {
+  if ((static_request_rules & kStaticRedirectRules) &&
+      GetStaticRedirectURL(request_url, new_url)) {
+    return;
+  }
+#if !defined(NDEBUG)
+  CheckSystemRequestIsAllowed(request_url);
 #endif
+}
+
+}  // namespace
 
+int OnBeforeURLRequest_StaticRedirectWork(
+    const ResponseCallback& next_callback,
+    std::shared_ptr<BraveRequestInfo> ctx) {
+  GURL new_url;
+  StaticRedirectWork(ctx->request_url, ctx->static_request_rules, &new_url);
+  if (!new_url.is_empty()) {
+    ctx->new_url_spec = new_url.spec();
+  }
   return net::OK;
 }
 
+int OnBeforeURLRequest_StaticRedirectWorkForGURL(
+    const GURL& request_url,
+    GURL* new_url) {
+  StaticRedirectWork(request_url, GetStaticRequestRules(request_url),
+                     new_url);
+  return net::OK;
+}
 
 }  // namespace brave
@@ -0,0 +1,157 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_static_request_rules.h"
+
+#include <functional>
+#include <string>
+
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
+#include "brave/browser/translate/buildflags/buildflags.h"
+#include "brave/common/network_constants.h"
+#include "brave/common/shield_exceptions.h"
+#include "brave/common/translate_network_constants.h"
+#include "components/component_updater/component_updater_url_constants.h"
+#include "extensions/buildflags/buildflags.h"
+#include "extensions/common/url_pattern.h"
+#include "url/gurl.h"
+
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+#include "extensions/common/extension_urls.h"
+#endif
+
+namespace brave {
+
+namespace {
+
+const int kHttpAndHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+struct PatternRules {
+  int valid_schemes;
+  const char* pattern;
+  StaticRequestRules rules;
+};
+
+// Has to be kept in sync with the patterns the helpers match requests
+// against.
+const PatternRules kPatternRules[] = {
+    // brave_static_redirect_network_delegate_helper.cc
+    {URLPattern::SCHEME_HTTPS, kGeoLocationsPattern, kStaticRedirectRules},
+    {URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix, kStaticRedirectRules},
+    {URLPattern::SCHEME_HTTPS, kSafeBrowsingFileCheckPrefix,
+     kStaticRedirectRules},
+    {kHttpAndHttps, kCRLSetPrefix1, kStaticRedirectRules},
+    {kHttpAndHttps, kCRLSetPrefix2, kStaticRedirectRules},
+    {kHttpAndHttps, kCRLSetPrefix3, kStaticRedirectRules},
+    {kHttpAndHttps, kCRLSetPrefix4, kStaticRedirectRules},
+    {kHttpAndHttps, kCRXDownloadPrefix, kStaticRedirectRules},
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE)
+    {URLPattern::SCHEME_HTTPS, kTranslateElementJSPattern,
+     kStaticRedirectRules},
+    {URLPattern::SCHEME_HTTPS, kTranslateLanguagePattern,
+     kStaticRedirectRules},
+#endif
+
+    // brave_common_static_redirect_network_delegate_helper.cc
+    {URLPattern::SCHEME_HTTPS, component_updater::kUpdaterJSONDefaultUrl,
+     kCommonStaticRedirectRules},
+    {URLPattern::SCHEME_HTTP, component_updater::kUpdaterJSONFallbackUrl,
+     kCommonStaticRedirectRules},
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+    {URLPattern::SCHEME_HTTPS, extension_urls::kChromeWebstoreUpdateURL,
+     kCommonStaticRedirectRules},
+#endif
+    {kHttpAndHttps, kChromeCastPrefix, kCommonStaticRedirectRules},
+    {kHttpAndHttps, kClients4Prefix, kCommonStaticRedirectRules},
+
+    // brave_site_hacks_network_delegate_helper.cc, see also
+    // GetUAWhitelistPatterns().
+    {URLPattern::SCHEME_ALL, kForbesPattern, kSiteHackHeaderRules},
+    {URLPattern::SCHEME_ALL, kTwitterRedirectURL, kSiteHackHeaderRules},
+
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE)
+    // brave_translate_redirect_network_delegate_helper.cc
+    {URLPattern::SCHEME_HTTPS, kTranslateGen204Pattern,
+     kTranslateRedirectRules},
+    {URLPattern::SCHEME_HTTPS, kTranslateElementMainCSSPattern,
+     kTranslateRedirectRules},
+    {URLPattern::SCHEME_HTTPS, kTranslateBrandingPNGPattern,
+     kTranslateRedirectRules},
+    {URLPattern::SCHEME_HTTPS, kTranslateElementMainJSPattern,
+     kTranslateRedirectRules},
+    {URLPattern::SCHEME_HTTPS, kTranslateMainJSPattern,
+     kTranslateRedirectRules},
+    {URLPattern::SCHEME_HTTPS, kTranslateRequestPattern,
+     kTranslateRedirectRules},
+#endif
+};
+
+class StaticRequestRulesTable {
+ public:
+  StaticRequestRulesTable() : all_hosts_rules_(kNoStaticRequestRules) {
+    for (const auto& pattern_rules : kPatternRules) {
+      // Only hosts matter here, the wildcard makes plain URLs like the
+      // updater ones valid patterns.
+      AddRules(URLPattern(pattern_rules.valid_schemes,
+                          std::string(pattern_rules.pattern) + "*"),
+               pattern_rules.rules);
+    }
+    for (const auto& pattern : GetUAWhitelistPatterns())
+      AddRules(pattern, kSiteHackHeaderRules);
+  }
+
+  uint32_t Get(base::StringPiece host) const {
+    uint32_t rules = all_hosts_rules_;
+    auto it = hosts_.find(host);
+    if (it != hosts_.end())
+      rules |= it->second.host_rules | it->second.subdomain_rules;
+
+    for (size_t dot = host.find('.'); dot != base::StringPiece::npos;
+         dot = host.find('.', dot + 1)) {
+      it = hosts_.find(host.substr(dot + 1));
+      if (it != hosts_.end())
+        rules |= it->second.subdomain_rules;
+    }
+    return rules;
+  }
+
+ private:
+  struct HostRules {
+    // Rules for the host itself.
+    uint32_t host_rules = kNoStaticRequestRules;
+    // Rules for the host and all of its subdomains.
+    uint32_t subdomain_rules = kNoStaticRequestRules;
+  };
+
+  void AddRules(const URLPattern& pattern, uint32_t rules) {
+    if (pattern.host().empty()) {
+      all_hosts_rules_ |= rules;
+      return;
+    }
+    HostRules& host_rules = hosts_[pattern.host()];
+    if (pattern.match_subdomains())
+      host_rules.subdomain_rules |= rules;
+    else
+      host_rules.host_rules |= rules;
+  }
+
+  // Transparent, so that hosts can be looked up without copying them.
+  base::flat_map<std::string, HostRules, std::less<>> hosts_;
+  uint32_t all_hosts_rules_;
+
+  DISALLOW_COPY_AND_ASSIGN(StaticRequestRulesTable);
+};
+
+}  // namespace
+
+uint32_t GetStaticRequestRules(const GURL& url) {
+  static const base::NoDestructor<StaticRequestRulesTable> table;
+  return table->Get(url.host_piece());
+}
+
+}  // namespace brave
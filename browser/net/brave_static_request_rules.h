@@ -0,0 +1,35 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_BRAVE_STATIC_REQUEST_RULES_H_
+#define BRAVE_BROWSER_NET_BRAVE_STATIC_REQUEST_RULES_H_
+
+#include <stdint.h>
+
+class GURL;
+
+namespace brave {
+
+// The network delegate helpers whose rules only apply to requests to a fixed
+// set of hosts.
+enum StaticRequestRules : uint32_t {
+  kNoStaticRequestRules = 0,
+  kStaticRedirectRules = 1 << 0,
+  kCommonStaticRedirectRules = 1 << 1,
+  kSiteHackHeaderRules = 1 << 2,
+  kTranslateRedirectRules = 1 << 3,
+  kAllStaticRequestRules = kStaticRedirectRules | kCommonStaticRedirectRules |
+                           kSiteHackHeaderRules | kTranslateRedirectRules,
+};
+
+// Returns which of the helpers have rules for the host of |url|, as a mask of
+// StaticRequestRules. The hosts of all of the helpers' patterns are compiled
+// into one table on first use, which the host and its parent domains are then
+// looked up in without allocating.
+uint32_t GetStaticRequestRules(const GURL& url);
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_BRAVE_STATIC_REQUEST_RULES_H_
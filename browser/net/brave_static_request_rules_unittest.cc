@@ -0,0 +1,65 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_static_request_rules.h"
+
+#include "brave/browser/translate/buildflags/buildflags.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=BraveStaticRequestRulesTest.*
+
+namespace brave {
+
+TEST(BraveStaticRequestRulesTest, MatchesHosts) {
+  EXPECT_EQ(kStaticRedirectRules,
+            GetStaticRequestRules(GURL("https://sb-ssl.google.com/")));
+  EXPECT_EQ(kStaticRedirectRules,
+            GetStaticRequestRules(GURL("https://dl.google.com/release2/")));
+  EXPECT_EQ(kCommonStaticRedirectRules,
+            GetStaticRequestRules(GURL("https://clients4.google.com/")));
+  EXPECT_EQ(kSiteHackHeaderRules,
+            GetStaticRequestRules(GURL("https://www.forbes.com/")));
+  EXPECT_EQ(kSiteHackHeaderRules,
+            GetStaticRequestRules(GURL("https://mobile.twitter.com/")));
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE)
+  EXPECT_EQ(kStaticRedirectRules | kTranslateRedirectRules,
+            GetStaticRequestRules(GURL("https://translate.googleapis.com/")));
+  EXPECT_EQ(kTranslateRedirectRules,
+            GetStaticRequestRules(GURL("https://www.gstatic.com/")));
+#endif
+}
+
+TEST(BraveStaticRequestRulesTest, MatchesSubdomains) {
+  // *://*.gvt1.com/ patterns.
+  EXPECT_EQ(kStaticRedirectRules | kCommonStaticRedirectRules,
+            GetStaticRequestRules(GURL("http://redirector.gvt1.com/")));
+  EXPECT_EQ(kStaticRedirectRules | kCommonStaticRedirectRules,
+            GetStaticRequestRules(GURL("http://r1.sn-n4v7sn7y.gvt1.com/")));
+  EXPECT_EQ(kStaticRedirectRules | kCommonStaticRedirectRules,
+            GetStaticRequestRules(GURL("http://gvt1.com/")));
+  // https://*.netflix.com/*, from the user agent whitelist.
+  EXPECT_EQ(kSiteHackHeaderRules,
+            GetStaticRequestRules(GURL("https://www.netflix.com/")));
+  // Only the host itself, not its subdomains.
+  EXPECT_EQ(kNoStaticRequestRules,
+            GetStaticRequestRules(GURL("https://a.www.forbes.com/")));
+}
+
+TEST(BraveStaticRequestRulesTest, NoRules) {
+  EXPECT_EQ(kNoStaticRequestRules,
+            GetStaticRequestRules(GURL("https://brianbondy.com/")));
+  EXPECT_EQ(kNoStaticRequestRules,
+            GetStaticRequestRules(GURL("https://forbes.com/")));
+  EXPECT_EQ(kNoStaticRequestRules,
+            GetStaticRequestRules(GURL("https://google.com/")));
+  EXPECT_EQ(kNoStaticRequestRules,
+            GetStaticRequestRules(GURL("https://gvt1.com.evil.com/")));
+  EXPECT_EQ(kNoStaticRequestRules,
+            GetStaticRequestRules(GURL("data:text/plain,")));
+  EXPECT_EQ(kNoStaticRequestRules, GetStaticRequestRules(GURL()));
+}
+
+}  // namespace brave
@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "brave/browser/net/brave_static_request_rules.h"
 #include "brave/common/translate_network_constants.h"
 #include "extensions/common/url_pattern.h"
 
@@ -23,7 +24,7 @@ bool IsTranslateScriptRequest(const GURL& gurl) {
       URLPattern(URLPattern::SCHEME_HTTPS, kTranslateMainJSPattern),
       });
   return std::any_of(translate_patterns.begin(), translate_patterns.end(),
-      [&gurl](URLPattern pattern) {
+      [&gurl](const URLPattern& pattern) {
       return pattern.MatchesURL(gurl);
       });
 }
@@ -34,7 +35,7 @@ bool IsTranslateResourceRequest(const GURL& gurl) {
       URLPattern(URLPattern::SCHEME_HTTPS, kTranslateBrandingPNGPattern),
       });
   return std::any_of(translate_patterns.begin(), translate_patterns.end(),
-      [&gurl](URLPattern pattern) {
+      [&gurl](const URLPattern& pattern) {
       return pattern.MatchesURL(gurl);
       });
 }
@@ -57,6 +58,10 @@ bool IsTranslateGen204Request(const GURL& gurl) {
 int OnBeforeURLRequest_TranslateRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
+  if (!(ctx->static_request_rules & kTranslateRedirectRules)) {
+    return net::OK;
+  }
+
   GURL::Replacements replacements;
 
   // Abort those gen204 requests triggered by translate element library.
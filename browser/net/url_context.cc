@@ -9,7 +9,6 @@
 #include <memory>
 #include <string>
 
-#include "brave/common/extensions/extension_constants.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/url_constants.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -24,7 +23,7 @@
 #include "net/base/upload_data_stream.h"
 
 #if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
-#include "extensions/browser/info_map.h"
+#include "brave/components/brave_webtorrent/browser/net/brave_torrent_redirect_network_delegate_helper.h"
 #endif
 
 namespace brave {
@@ -46,8 +45,7 @@ bool IsWebTorrentDisabled(content::ResourceContext* resource_context) {
     return false;
   }
 
-  return !infoMap->extensions().Contains(brave_webtorrent_extension_id) ||
-    infoMap->disabled_extensions().Contains(brave_webtorrent_extension_id);
+  return !webtorrent::IsWebtorrentEnabledOnIO(infoMap);
 #else
   return true;
 #endif  // BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
@@ -88,6 +86,7 @@ void BraveRequestInfo::FillCTXFromRequest(const net::URLRequest* request,
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
   ctx->request_identifier = request->identifier();
   ctx->request_url = request->url();
+  ctx->static_request_rules = GetStaticRequestRules(ctx->request_url);
   if (request->initiator().has_value()) {
     ctx->initiator_url = request->initiator()->GetURL();
   }
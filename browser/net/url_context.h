@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 
+#include "brave/browser/net/brave_static_request_rules.h"
 #include "chrome/browser/net/chrome_network_delegate.h"
 #include "content/public/common/resource_type.h"
 #include "net/url_request/url_request.h"
@@ -18,6 +19,7 @@ class BraveNetworkDelegateBase;
 
 namespace brave {
 
+class ReferralHeadersMatcher;
 struct BraveRequestInfo;
 using ResponseCallback = base::Callback<void()>;
 
@@ -75,9 +77,12 @@ struct BraveRequestInfo {
   scoped_refptr<net::HttpResponseHeaders>* override_response_headers = nullptr;
   GURL* allowed_unsafe_redirect_url = nullptr;
   BraveNetworkDelegateEventType event_type = kUnknownEventType;
-  const base::ListValue* referral_headers_list = nullptr;
+  const ReferralHeadersMatcher* referral_headers_matcher = nullptr;
   BlockedBy blocked_by = kNotBlocked;
   bool cancel_request_explicitly = false;
+  // The helpers that have rules for the host of |request_url|, a mask of
+  // StaticRequestRules. Helpers without any skip the request.
+  uint32_t static_request_rules = kAllStaticRequestRules;
   // Default to invalid type for resource_type, so delegate helpers
   // can properly detect that the info couldn't be obtained.
   static constexpr content::ResourceType kInvalidResourceType =
@@ -54,4 +54,9 @@ const char kEnableSmartTrackingProtection[] =
 
 const char kFastWidevineBundleUpdate[] = "fast-widevine-bundle-update";
 
+// Holds back subresource requests made before the default ad-block engine is
+// loaded, for a few seconds at most, rather than letting them through
+// unfiltered.
+const char kWaitForAdBlockEngine[] = "wait-for-ad-block-engine";
+
 }  // namespace switches
@@ -29,6 +29,8 @@ class BraveMockImporterBridge : public MockImporterBridge {
                void(const BraveLedger&));
   MOCK_METHOD1(UpdateWindows,
                void(const ImportedWindowState&));
+  MOCK_METHOD2(NotifyItemProgress,
+               void(importer::ImportItem, uint32_t));
 
  private:
   ~BraveMockImporterBridge() override;
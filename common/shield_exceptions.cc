@@ -9,33 +9,47 @@
 #include <map>
 #include <vector>
 
+#include "base/no_destructor.h"
 #include "extensions/common/url_pattern.h"
 #include "url/gurl.h"
 
 namespace brave {
 
+const std::vector<URLPattern>& GetUAWhitelistPatterns() {
+  static const base::NoDestructor<std::vector<URLPattern>> whitelist_patterns(
+      std::vector<URLPattern>({
+          URLPattern(URLPattern::SCHEME_ALL, "https://*.adobe.com/*"),
+          URLPattern(URLPattern::SCHEME_ALL, "https://*.duckduckgo.com/*"),
+          URLPattern(URLPattern::SCHEME_ALL, "https://*.brave.com/*"),
+          // For Widevine
+          URLPattern(URLPattern::SCHEME_ALL, "https://*.netflix.com/*")
+      }));
+  return *whitelist_patterns;
+}
+
 bool IsUAWhitelisted(const GURL& gurl) {
-  static std::vector<URLPattern> whitelist_patterns({
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.adobe.com/*"),
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.duckduckgo.com/*"),
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.brave.com/*"),
-    // For Widevine
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.netflix.com/*")
-  });
+  const std::vector<URLPattern>& whitelist_patterns = GetUAWhitelistPatterns();
   return std::any_of(whitelist_patterns.begin(), whitelist_patterns.end(),
-      [&gurl](URLPattern pattern){
+      [&gurl](const URLPattern& pattern){
         return pattern.MatchesURL(gurl);
       });
 }
 
+const std::vector<URLPattern>& GetBlockedResourcePatterns() {
+  static const base::NoDestructor<std::vector<URLPattern>> blocked_patterns(
+      std::vector<URLPattern>({
+          URLPattern(URLPattern::SCHEME_ALL, "https://pdfjs.robwu.nl/*")
+      }));
+  return *blocked_patterns;
+}
+
 bool IsBlockedResource(const GURL& gurl) {
-  static std::vector<URLPattern> blocked_patterns({
-      URLPattern(URLPattern::SCHEME_ALL, "https://pdfjs.robwu.nl/*")
-  });
+  const std::vector<URLPattern>& blocked_patterns =
+      GetBlockedResourcePatterns();
   return std::any_of(blocked_patterns.begin(), blocked_patterns.end(),
-                     [&gurl](URLPattern pattern){
-                       return pattern.MatchesURL(gurl);
-                     });
+      [&gurl](const URLPattern& pattern){
+        return pattern.MatchesURL(gurl);
+      });
 }
 
 bool IsWhitelistedCookieException(const GURL& firstPartyOrigin,
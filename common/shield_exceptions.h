@@ -6,11 +6,16 @@
 #ifndef BRAVE_COMMON_SHIELD_EXCEPTIONS_H_
 #define BRAVE_COMMON_SHIELD_EXCEPTIONS_H_
 
+#include <vector>
+
 class GURL;
+class URLPattern;
 
 namespace brave {
 
+const std::vector<URLPattern>& GetUAWhitelistPatterns();
 bool IsUAWhitelisted(const GURL& gurl);
+const std::vector<URLPattern>& GetBlockedResourcePatterns();
 bool IsBlockedResource(const GURL& gurl);
 bool IsWhitelistedCookieException(const GURL& firstPartyOrigin,
                                   const GURL& subresourceUrl,
@@ -5,9 +5,12 @@
 
 #include "brave/components/brave_ads/browser/ads_service_impl.h"
 
+#include <string.h>
+
 #include <limits>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/command_line.h"
 #include "base/files/file_util.h"
 #include "base/files/important_file_writer.h"
@@ -17,6 +20,7 @@
 #include "base/sequenced_task_runner.h"
 #include "base/task_runner_util.h"
 #include "base/task/post_task.h"
+#include "base/time/default_tick_clock.h"
 #include "base/time/time.h"
 #include "base/i18n/time_formatting.h"
 #include "bat/ads/ads.h"
@@ -326,6 +330,7 @@ AdsServiceImpl::AdsServiceImpl(Profile* profile)
       retry_viewing_ad_with_id_(""),
       next_timer_id_(0),
       remove_onboarding_timer_id_(0),
+      ads_settings_version_(0),
       bundle_state_backend_(
           new BundleStateDatabase(base_path_.AppendASCII("bundle_state"))),
       display_service_(NotificationDisplayService::GetForProfile(profile_)),
@@ -334,8 +339,12 @@ AdsServiceImpl::AdsServiceImpl(Profile* profile)
 #if !defined(OS_ANDROID)
       last_idle_state_(ui::IdleState::IDLE_STATE_ACTIVE),
       is_foreground_(!!chrome::FindBrowserWithActiveWindow()),
+      idle_monitor_(this, base::DefaultTickClock::GetInstance()),
 #endif
-      bat_ads_client_binding_(new bat_ads::AdsClientMojoBridge(this)) {
+      // Unretained is safe, the bridge is owned by the binding
+      bat_ads_client_binding_(new bat_ads::AdsClientMojoBridge(this,
+          base::BindRepeating(&AdsServiceImpl::LoadUserModelRegionForLocale,
+                              base::Unretained(this)))) {
   DCHECK(!profile_->IsOffTheRecord());
 
   MigratePrefs();
@@ -351,6 +360,12 @@ AdsServiceImpl::AdsServiceImpl(Profile* profile)
   profile_pref_change_registrar_.Add(prefs::kIdleThreshold,
       base::Bind(&AdsServiceImpl::OnPrefsChanged, base::Unretained(this)));
 
+  profile_pref_change_registrar_.Add(prefs::kAdsPerHour,
+      base::Bind(&AdsServiceImpl::OnPrefsChanged, base::Unretained(this)));
+
+  profile_pref_change_registrar_.Add(prefs::kAdsPerDay,
+      base::Bind(&AdsServiceImpl::OnPrefsChanged, base::Unretained(this)));
+
   auto* display_service_impl =
       static_cast<NotificationDisplayServiceImpl*>(display_service_);
 
@@ -525,6 +540,7 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(bool success) {
   }
 
   BackgroundHelper::GetInstance()->AddObserver(this);
+  net::NetworkChangeNotifier::AddNetworkChangeObserver(this);
 
   bat_ads::mojom::BatAdsClientAssociatedPtrInfo client_ptr_info;
   bat_ads_client_binding_.Bind(mojo::MakeRequest(&client_ptr_info));
@@ -532,6 +548,9 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(bool success) {
   bat_ads_service_->Create(std::move(client_ptr_info), MakeRequest(&bat_ads_),
       base::BindOnce(&AdsServiceImpl::OnCreate, AsWeakPtr()));
 
+  // Queued behind Create(), so bat_ads has the settings before Initialize()
+  UpdateAdsSettings();
+
   MaybeShowMyFirstAdNotification();
 }
 
@@ -688,20 +707,16 @@ void AdsServiceImpl::OnShutdownBatAds(const int32_t result) {
 }
 
 void AdsServiceImpl::ResetTimer() {
-  idle_poll_timer_.Stop();
-  idle_poll_timer_.Start(FROM_HERE,
-                         base::TimeDelta::FromSeconds(1),
-                         this,
-                         &AdsServiceImpl::CheckIdleState);
-}
-
-void AdsServiceImpl::CheckIdleState() {
 #if !defined(OS_ANDROID)
-  ProcessIdleState(ui::CalculateIdleState(GetIdleThreshold()));
+  idle_monitor_.Start(GetIdleThreshold());
 #endif
 }
 
 #if !defined(OS_ANDROID)
+void AdsServiceImpl::OnIdleStateChanged(ui::IdleState idle_state) {
+  ProcessIdleState(idle_state);
+}
+
 void AdsServiceImpl::ProcessIdleState(ui::IdleState idle_state) {
   if (!connected() || idle_state == last_idle_state_)
     return;
@@ -717,13 +732,19 @@ void AdsServiceImpl::ProcessIdleState(ui::IdleState idle_state) {
 
 void AdsServiceImpl::Shutdown() {
   BackgroundHelper::GetInstance()->RemoveObserver(this);
+  net::NetworkChangeNotifier::RemoveNetworkChangeObserver(this);
 
   for (auto* const loader : url_loaders_) {
     delete loader;
   }
   url_loaders_.clear();
 
-  idle_poll_timer_.Stop();
+#if !defined(OS_ANDROID)
+  idle_monitor_.Stop();
+  VLOG(1) << "Idle monitor woke up " << idle_monitor_.wakeup_count()
+          << " times, polling would have woken up "
+          << idle_monitor_.polling_wakeup_count() << " times";
+#endif
 
   bat_ads_.reset();
   bat_ads_client_binding_.Close();
@@ -1099,6 +1120,8 @@ bool AdsServiceImpl::PrefExists(
 void AdsServiceImpl::OnPrefsChanged(const std::string& pref) {
   if (pref == prefs::kEnabled ||
       pref == brave_rewards::prefs::kBraveRewardsEnabled) {
+    UpdateAdsSettings();
+
     if (IsAdsEnabled()) {
       RemoveOnboarding();
 
@@ -1108,9 +1131,35 @@ void AdsServiceImpl::OnPrefsChanged(const std::string& pref) {
     }
   } else if (pref == prefs::kIdleThreshold) {
     ResetTimer();
+  } else if (pref == prefs::kAdsPerHour || pref == prefs::kAdsPerDay) {
+    UpdateAdsSettings();
   }
 }
 
+void AdsServiceImpl::UpdateAdsSettings() {
+  if (!connected()) {
+    return;
+  }
+
+  auto settings = bat_ads::mojom::AdsSettings::New();
+  settings->version = ++ads_settings_version_;
+  settings->is_ads_enabled = IsAdsEnabled();
+  settings->ads_locale = GetAdsLocale();
+  settings->ads_per_hour = GetAdsPerHour();
+  settings->ads_per_day = GetAdsPerDay();
+  settings->is_foreground = IsForeground();
+  settings->is_network_connection_available = IsNetworkConnectionAvailable();
+  settings->is_notifications_available = IsNotificationsAvailable();
+  settings->locales = GetLocales();
+
+  bat_ads_->OnSettingsChanged(std::move(settings));
+}
+
+void AdsServiceImpl::OnNetworkChanged(
+    net::NetworkChangeNotifier::ConnectionType type) {
+  UpdateAdsSettings();
+}
+
 bool AdsServiceImpl::IsSupportedRegion() const {
   auto locale = LocaleHelper::GetInstance()->GetLocale();
   return ads::Ads::IsSupportedRegion(locale);
@@ -1177,6 +1226,10 @@ void AdsServiceImpl::ChangeLocale(const std::string& locale) {
     return;
   }
 
+  // The ads library reads the ads locale and the supported locales from the
+  // mirrored settings, so push them before it switches locale
+  UpdateAdsSettings();
+
   bat_ads_->ChangeLocale(locale);
 }
 
@@ -1206,14 +1259,30 @@ bool AdsServiceImpl::IsNotificationsAvailable() const {
 
 void AdsServiceImpl::LoadUserModelForLocale(
     const std::string& locale,
-    ads::OnLoadCallback callback) const {
+    ads::OnLoadUserModelCallback callback) const {
+  // bat_ads gets the user model from LoadUserModelRegionForLocale()
+  NOTREACHED();
+  callback(ads::Result::FAILED, nullptr, 0);
+}
+
+base::ReadOnlySharedMemoryRegion AdsServiceImpl::LoadUserModelRegionForLocale(
+    const std::string& locale) {
   base::StringPiece user_model_raw =
       ui::ResourceBundle::GetSharedInstance().GetRawDataResource(
           GetUserModelResourceId(locale));
+  if (user_model_raw.empty())
+    return base::ReadOnlySharedMemoryRegion();
+
+  // Not kept here, the region goes away once bat_ads has copied the model
+  // out of it
+  base::MappedReadOnlyRegion user_model =
+      base::ReadOnlySharedMemoryRegion::Create(user_model_raw.size());
+  if (!user_model.IsValid())
+    return base::ReadOnlySharedMemoryRegion();
 
-  std::string user_model;
-  user_model_raw.CopyToString(&user_model);
-  callback(ads::Result::SUCCESS, user_model);
+  memcpy(user_model.mapping.memory(), user_model_raw.data(),
+         user_model_raw.size());
+  return std::move(user_model.region);
 }
 
 void AdsServiceImpl::OnURLsDeleted(
@@ -1606,12 +1675,14 @@ void AdsServiceImpl::OnURLLoaderComplete(
 
 void AdsServiceImpl::OnBackground() {
   if (connected()) {
+    UpdateAdsSettings();
     bat_ads_->OnBackground();
   }
 }
 
 void AdsServiceImpl::OnForeground() {
   if (connected()) {
+    UpdateAdsSettings();
     bat_ads_->OnForeground();
   }
 }
@@ -15,6 +15,7 @@
 
 #include "base/containers/flat_set.h"
 #include "base/files/file_path.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/weak_ptr.h"
 #include "base/timer/timer.h"
 #include "bat/ads/ads_client.h"
@@ -27,8 +28,10 @@
 #include "components/history/core/browser/history_service_observer.h"
 #include "components/prefs/pref_change_registrar.h"
 #include "mojo/public/cpp/bindings/associated_binding.h"
+#include "net/base/network_change_notifier.h"
 
 #if !defined(OS_ANDROID)
+#include "brave/components/brave_ads/browser/idle_monitor.h"
 #include "ui/base/idle/idle.h"
 #endif
 
@@ -58,6 +61,10 @@ class AdsServiceImpl : public AdsService,
                        public ads::AdsClient,
                        public history::HistoryServiceObserver,
                        BackgroundHelper::Observer,
+                       net::NetworkChangeNotifier::NetworkChangeObserver,
+#if !defined(OS_ANDROID)
+                       IdleMonitor::Observer,
+#endif
                        public base::SupportsWeakPtr<AdsServiceImpl> {
  public:
   explicit AdsServiceImpl(Profile* profile);
@@ -102,9 +109,11 @@ class AdsServiceImpl : public AdsService,
   bool IsTesting() const;
   void Stop();
   void ResetTimer();
-  void CheckIdleState();
 #if !defined(OS_ANDROID)
   void ProcessIdleState(ui::IdleState idle_state);
+
+  // IdleMonitor::Observer implementation
+  void OnIdleStateChanged(ui::IdleState idle_state) override;
 #endif
   int GetIdleThreshold();
   void OnShow(Profile* profile, const std::string& notification_id);
@@ -163,7 +172,7 @@ class AdsServiceImpl : public AdsService,
   bool IsNotificationsAvailable() const override;
   void LoadUserModelForLocale(
       const std::string& locale,
-      ads::OnLoadCallback callback) const override;
+      ads::OnLoadUserModelCallback callback) const override;
   bool IsNetworkConnectionAvailable() override;
 
   // history::HistoryServiceObserver
@@ -229,6 +238,13 @@ class AdsServiceImpl : public AdsService,
 
   void OnPrefsChanged(const std::string& pref);
 
+  // Pushes the settings bat_ads mirrors, see bat_ads::mojom::AdsSettings
+  void UpdateAdsSettings();
+
+  // net::NetworkChangeNotifier::NetworkChangeObserver implementation
+  void OnNetworkChanged(
+      net::NetworkChangeNotifier::ConnectionType type) override;
+
   void OnCreate();
   void OnInitialize(const int32_t result);
   void ShutdownBatAds();
@@ -259,6 +275,9 @@ class AdsServiceImpl : public AdsService,
 
   uint32_t next_timer_id();
 
+  base::ReadOnlySharedMemoryRegion LoadUserModelRegionForLocale(
+      const std::string& locale);
+
   // are we still connected to the ads lib
   bool connected();
 
@@ -271,6 +290,7 @@ class AdsServiceImpl : public AdsService,
   std::string retry_viewing_ad_with_id_;
   uint32_t next_timer_id_;
   uint32_t remove_onboarding_timer_id_;
+  uint64_t ads_settings_version_;
   std::unique_ptr<BundleStateDatabase> bundle_state_backend_;
   NotificationDisplayService* display_service_;  // NOT OWNED
   brave_rewards::RewardsService* rewards_service_;  // NOT OWNED
@@ -278,10 +298,9 @@ class AdsServiceImpl : public AdsService,
 #if !defined(OS_ANDROID)
   ui::IdleState last_idle_state_;
   bool is_foreground_;
+  IdleMonitor idle_monitor_;
 #endif
 
-  base::RepeatingTimer idle_poll_timer_;
-
   PrefChangeRegistrar profile_pref_change_registrar_;
 
   mojo::AssociatedBinding<bat_ads::mojom::BatAdsClient> bat_ads_client_binding_;
@@ -6,8 +6,10 @@
 #include "brave/components/brave_ads/browser/ads_tab_helper.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
+#include "base/strings/string_util.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
 #include "chrome/browser/dom_distiller/dom_distiller_service_factory.h"
@@ -30,6 +32,14 @@
 
 namespace brave_ads {
 
+namespace {
+
+// The start of a page is enough to classify it, and keeps long pages from
+// costing more to send and classify.
+const size_t kMaximumPageTextSize = 32 * 1024;
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(SessionTabHelper::IdForTab(web_contents)),
@@ -94,7 +104,7 @@ void AdsTabHelper::DocumentOnLoadCompletedInMainFrame() {
           std::move(source_page_handle));
 
   auto options = dom_distiller::proto::DomDistillerOptions();
-  // options.set_extract_text_only(true);
+  options.set_extract_text_only(true);
   // options.set_debug_level(1);
 
   auto* distiller_page_ptr = distiller_page.get();
@@ -120,8 +130,12 @@ void AdsTabHelper::OnWebContentsDistillationDone(
       distiller_result->has_distilled_content() &&
       distiller_result->has_markup_info() &&
       distiller_result->distilled_content().has_html()) {
-    ads_service_->ClassifyPage(url.spec(),
-                               distiller_result->distilled_content().html());
+    std::string text;
+    base::TruncateUTF8ToByteSize(
+        base::CollapseWhitespaceASCII(
+            distiller_result->distilled_content().html(), true),
+        kMaximumPageTextSize, &text);
+    ads_service_->ClassifyPage(url.spec(), text);
   } else {
     // TODO(bridiver) - fall back to web_contents()->GenerateMHTML or ignore?
   }
@@ -7,12 +7,18 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <map>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/bind.h"
 #include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 #include "sql/meta_table.h"
 #include "sql/statement.h"
@@ -22,8 +28,61 @@ namespace brave_ads {
 
 namespace {
 
-const int kCurrentVersionNumber = 2;
-const int kCompatibleVersionNumber = 2;
+const int kCurrentVersionNumber = 3;
+const int kCompatibleVersionNumber = 3;
+
+// Rows bound by one multi-row insert. With twelve columns per row this stays
+// well below SQLite's limit of 999 variables per statement.
+const size_t kAdInfoRowsPerInsert = 50;
+
+// The catalog is saved every time it is refreshed, so the file is only
+// compacted once in a while rather than after every save.
+constexpr base::TimeDelta kVacuumInterval = base::TimeDelta::FromDays(7);
+const char kLastVacuumTimeKey[] = "last_vacuum_time";
+
+const char kAdInfoColumnDefinitions[] =
+    "("
+    "creative_set_id LONGVARCHAR,"
+    "advertiser LONGVARCHAR,"
+    "notification_text TEXT,"
+    "notification_url LONGVARCHAR,"
+    "start_timestamp INTEGER,"
+    "end_timestamp INTEGER,"
+    "uuid LONGVARCHAR,"
+    "region VARCHAR,"
+    "campaign_id LONGVARCHAR,"
+    "daily_cap INTEGER DEFAULT 0 NOT NULL,"
+    "per_day INTEGER DEFAULT 0 NOT NULL,"
+    "total_max INTEGER DEFAULT 0 NOT NULL,"
+    "PRIMARY KEY(region, uuid))";
+
+// Ads are compared against the local wall clock, the same way the datetime
+// strings were compared against datetime('now', 'localtime'). So the local
+// time is converted as if it were UTC, like the stored timestamps are.
+int64_t GetLocalTimeT(base::Time time) {
+  base::Time::Exploded exploded;
+  time.LocalExplode(&exploded);
+  base::Time local_time;
+  if (!base::Time::FromUTCExploded(exploded, &local_time))
+    return time.ToTimeT();
+  return local_time.ToTimeT();
+}
+
+std::string BuildInsertNewAdInfoSQL(size_t rows) {
+  std::string sql =
+      "INSERT OR REPLACE INTO new_ad_info "
+      "(creative_set_id, advertiser, notification_text, "
+      "notification_url, start_timestamp, end_timestamp, uuid, "
+      "campaign_id, daily_cap, per_day, total_max, region) "
+      "VALUES ";
+  for (size_t i = 0; i < rows; ++i) {
+    if (i > 0)
+      sql.append(", ");
+    sql.append("(?, ?, ?, ?, CAST(strftime('%s', ?) AS INTEGER), "
+               "CAST(strftime('%s', ?) AS INTEGER), ?, ?, ?, ?, ?, ?)");
+  }
+  return sql;
+}
 
 }  // namespace
 
@@ -36,6 +95,16 @@ BundleStateDatabase::BundleStateDatabase(const base::FilePath& db_path) :
 BundleStateDatabase::~BundleStateDatabase() {
 }
 
+BundleStateDatabase::CachedAdInfo::CachedAdInfo() = default;
+
+BundleStateDatabase::CachedAdInfo::CachedAdInfo(const CachedAdInfo& other) =
+    default;
+
+BundleStateDatabase::CachedAdInfo::CachedAdInfo(CachedAdInfo&& other) =
+    default;
+
+BundleStateDatabase::CachedAdInfo::~CachedAdInfo() = default;
+
 bool BundleStateDatabase::Init() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -50,6 +119,7 @@ bool BundleStateDatabase::Init() {
     db_.Close();
     meta_table_.Reset();
   }
+  ads_for_category_cache_.clear();
 
   if (!db_.Open(db_path_))
     return false;
@@ -64,7 +134,8 @@ bool BundleStateDatabase::Init() {
   if (!CreateCategoryTable() ||
       !CreateAdInfoTable() ||
       !CreateAdInfoCategoryTable() ||
-      !CreateAdInfoCategoryNameIndex())
+      !CreateAdInfoCategoryNameIndex() ||
+      !CreateAdInfoUuidIndex())
     return false;
 
   // Version check.
@@ -99,21 +170,6 @@ bool BundleStateDatabase::CreateCategoryTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateCategoryTable() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(
-      GetDB().GetCachedStatement(SQL_FROM_HERE, "DELETE FROM category"));
-  return sql.Run();
-}
-
-
 bool BundleStateDatabase::CreateAdInfoTable() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -121,40 +177,23 @@ bool BundleStateDatabase::CreateAdInfoTable() {
   if (GetDB().DoesTableExist(name))
     return true;
 
-  // Update InsertOrUpdateAdInfo() if you add anything here
+  // Update InsertNewAdInfoRows() and UpdateAdInfo() if you add anything here
   std::string sql;
   sql.append("CREATE TABLE ");
   sql.append(name);
-  sql.append(
-      "("
-      "creative_set_id LONGVARCHAR,"
-      "advertiser LONGVARCHAR,"
-      "notification_text TEXT,"
-      "notification_url LONGVARCHAR,"
-      "start_timestamp DATETIME,"
-      "end_timestamp DATETIME,"
-      "uuid LONGVARCHAR,"
-      "region VARCHAR,"
-      "campaign_id LONGVARCHAR,"
-      "daily_cap INTEGER DEFAULT 0 NOT NULL,"
-      "per_day INTEGER DEFAULT 0 NOT NULL,"
-      "total_max INTEGER DEFAULT 0 NOT NULL,"
-      "PRIMARY KEY(region, uuid))");
+  sql.append(kAdInfoColumnDefinitions);
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateAdInfoTable() {
+bool BundleStateDatabase::CreateNewAdInfoTable() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(
-      GetDB().GetCachedStatement(SQL_FROM_HERE, "DELETE FROM ad_info"));
-  return sql.Run();
+  // Staging table for the catalog being saved, which UpdateAdInfo() diffs
+  // against ad_info. It is a TEMP table, so it never reaches the file.
+  std::string sql;
+  sql.append("CREATE TEMP TABLE IF NOT EXISTS new_ad_info");
+  sql.append(kAdInfoColumnDefinitions);
+  return GetDB().Execute(sql.c_str());
 }
 
 bool BundleStateDatabase::CreateAdInfoCategoryTable() {
@@ -183,26 +222,22 @@ bool BundleStateDatabase::CreateAdInfoCategoryTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateAdInfoCategoryTable() {
+bool BundleStateDatabase::CreateAdInfoCategoryNameIndex() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(GetDB().GetCachedStatement(SQL_FROM_HERE,
-      "DELETE FROM ad_info_category"));
-  return sql.Run();
+  return GetDB().Execute(
+      "CREATE INDEX IF NOT EXISTS ad_info_category_category_name_index "
+      "ON ad_info_category (category_name)");
 }
 
-bool BundleStateDatabase::CreateAdInfoCategoryNameIndex() {
+bool BundleStateDatabase::CreateAdInfoUuidIndex() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
+  // Covers the join from ad_info_category in GetAdsForCategory() together
+  // with its time range.
   return GetDB().Execute(
-      "CREATE INDEX IF NOT EXISTS ad_info_category_category_name_index "
-      "ON ad_info_category (category_name)");
+      "CREATE INDEX IF NOT EXISTS ad_info_uuid_timestamp_index "
+      "ON ad_info (uuid, end_timestamp, start_timestamp)");
 }
 
 bool BundleStateDatabase::SaveBundleState(
@@ -215,106 +250,244 @@ bool BundleStateDatabase::SaveBundleState(
   if (!initialized)
     return false;
 
+  ads_for_category_cache_.clear();
+
   if (!GetDB().BeginTransaction())
     return false;
 
-  // we are completely replacing here so first truncate all the tables
-  if (!TruncateAdInfoCategoryTable() ||
-      !TruncateAdInfoTable() ||
-      !TruncateCategoryTable()) {
+  // Only rows that differ from the stored catalog are written, so a refresh
+  // which changes a few creatives only touches a few rows.
+  int rows_written = 0;
+  if (!CreateNewAdInfoTable() ||
+      !InsertNewAdInfo(bundle_state) ||
+      !UpdateAdInfo(&rows_written) ||
+      !UpdateCategories(bundle_state, &rows_written) ||
+      !UpdateAdInfoCategories(bundle_state, &rows_written)) {
     GetDB().RollbackTransaction();
     return false;
   }
 
-  auto categories = bundle_state.categories;
-  for (std::map<std::string, std::vector<ads::AdInfo>>::iterator it =
-      categories.begin();  it != categories.end(); ++it) {
-    auto category = it->first;
-    if (!InsertOrUpdateCategory(category)) {
-      GetDB().RollbackTransaction();
-      return false;
-    }
+  if (!GetDB().CommitTransaction())
+    return false;
+
+  last_save_rows_written_ = rows_written;
+  VLOG(1) << "Saved ads bundle state, " << rows_written << " rows written";
 
-    auto ads = it->second;
-    for (std::vector<ads::AdInfo>::iterator ad_it = ads.begin();
-        ad_it != ads.end(); ++ad_it) {
-      auto ad_info = *ad_it;
-      if (!InsertOrUpdateAdInfo(ad_info) ||
-          !InsertOrUpdateAdInfoCategory(ad_info, category)) {
-        GetDB().RollbackTransaction();
-        return false;
-      }
+  VacuumIfNeeded();
+  return true;
+}
+
+bool BundleStateDatabase::InsertNewAdInfo(
+    const ads::BundleState& bundle_state) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement clear_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM new_ad_info"));
+  if (!clear_statement.Run())
+    return false;
+
+  std::vector<AdInfoRegion> rows;
+  for (const auto& category : bundle_state.categories) {
+    for (const auto& info : category.second) {
+      for (const auto& region : info.regions)
+        rows.emplace_back(&info, &region);
     }
   }
 
-  if (GetDB().CommitTransaction()) {
-    Vacuum();
-    return true;
+  base::span<const AdInfoRegion> remaining(rows);
+  while (!remaining.empty()) {
+    const size_t count = std::min(remaining.size(), kAdInfoRowsPerInsert);
+    if (!InsertNewAdInfoRows(remaining.first(count)))
+      return false;
+    remaining = remaining.subspan(count);
   }
 
-  return false;
+  return true;
 }
 
-bool BundleStateDatabase::InsertOrUpdateCategory(const std::string& category) {
+bool BundleStateDatabase::InsertNewAdInfoRows(
+    base::span<const AdInfoRegion> rows) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK_LE(rows.size(), kAdInfoRowsPerInsert);
+
+  sql::Statement statement;
+  if (rows.size() == kAdInfoRowsPerInsert) {
+    static const base::NoDestructor<std::string> sql(
+        BuildInsertNewAdInfoSQL(kAdInfoRowsPerInsert));
+    statement.Assign(GetDB().GetCachedStatement(SQL_FROM_HERE, sql->c_str()));
+  } else {
+    statement.Assign(
+        GetDB().GetUniqueStatement(
+            BuildInsertNewAdInfoSQL(rows.size()).c_str()));
+  }
 
-  bool initialized = Init();
-  DCHECK(initialized);
+  int column = 0;
+  for (const auto& row : rows) {
+    const ads::AdInfo& info = *row.first;
+    statement.BindString(column++, info.creative_set_id);
+    statement.BindString(column++, info.advertiser);
+    statement.BindString(column++, info.notification_text);
+    statement.BindString(column++, info.notification_url);
+    statement.BindString(column++, info.start_timestamp);
+    statement.BindString(column++, info.end_timestamp);
+    statement.BindString(column++, info.uuid);
+    statement.BindString(column++, info.campaign_id);
+    statement.BindInt(column++, info.daily_cap);
+    statement.BindInt(column++, info.per_day);
+    statement.BindInt(column++, info.total_max);
+    statement.BindString(column++, *row.second);
+  }
 
-  if (!initialized)
+  return statement.Run();
+}
+
+bool BundleStateDatabase::UpdateAdInfo(int* rows_written) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement delete_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM ad_info WHERE NOT EXISTS ("
+      "SELECT 1 FROM new_ad_info AS n "
+      "WHERE n.region = ad_info.region AND n.uuid = ad_info.uuid)"));
+  if (!delete_statement.Run())
+    return false;
+  *rows_written += GetDB().GetLastChangeCount();
+
+  sql::Statement update_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "INSERT OR REPLACE INTO ad_info "
+      "(creative_set_id, advertiser, notification_text, "
+      "notification_url, start_timestamp, end_timestamp, uuid, "
+      "campaign_id, daily_cap, per_day, total_max, region) "
+      "SELECT n.creative_set_id, n.advertiser, n.notification_text, "
+      "n.notification_url, n.start_timestamp, n.end_timestamp, n.uuid, "
+      "n.campaign_id, n.daily_cap, n.per_day, n.total_max, n.region "
+      "FROM new_ad_info AS n "
+      "LEFT JOIN ad_info AS ai "
+      "ON ai.region = n.region AND ai.uuid = n.uuid "
+      "WHERE ai.uuid IS NULL OR "
+      "ai.creative_set_id IS NOT n.creative_set_id OR "
+      "ai.advertiser IS NOT n.advertiser OR "
+      "ai.notification_text IS NOT n.notification_text OR "
+      "ai.notification_url IS NOT n.notification_url OR "
+      "ai.start_timestamp IS NOT n.start_timestamp OR "
+      "ai.end_timestamp IS NOT n.end_timestamp OR "
+      "ai.campaign_id IS NOT n.campaign_id OR "
+      "ai.daily_cap IS NOT n.daily_cap OR "
+      "ai.per_day IS NOT n.per_day OR "
+      "ai.total_max IS NOT n.total_max"));
+  if (!update_statement.Run())
     return false;
+  *rows_written += GetDB().GetLastChangeCount();
 
-  sql::Statement ad_info_statement(
-      GetDB().GetCachedStatement(SQL_FROM_HERE,
-          "INSERT OR REPLACE INTO category "
-          "(name) "
-          "VALUES (?)"));
+  sql::Statement clear_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "DELETE FROM new_ad_info"));
+  return clear_statement.Run();
+}
 
-  ad_info_statement.BindString(0, category);
+bool BundleStateDatabase::UpdateCategories(
+    const ads::BundleState& bundle_state,
+    int* rows_written) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  return ad_info_statement.Run();
+  std::set<std::string> stored_categories;
+  sql::Statement select_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT name FROM category"));
+  while (select_statement.Step())
+    stored_categories.insert(select_statement.ColumnString(0));
+
+  for (const auto& category : stored_categories) {
+    if (bundle_state.categories.count(category))
+      continue;
+
+    sql::Statement delete_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+        "DELETE FROM category WHERE name = ?"));
+    delete_statement.BindString(0, category);
+    if (!delete_statement.Run())
+      return false;
+    *rows_written += GetDB().GetLastChangeCount();
+  }
+
+  for (const auto& category : bundle_state.categories) {
+    if (stored_categories.count(category.first))
+      continue;
+
+    if (!InsertOrUpdateCategory(category.first))
+      return false;
+    *rows_written += GetDB().GetLastChangeCount();
+  }
+
+  return true;
 }
 
-bool BundleStateDatabase::InsertOrUpdateAdInfo(const ads::AdInfo& info) {
+bool BundleStateDatabase::UpdateAdInfoCategories(
+    const ads::BundleState& bundle_state,
+    int* rows_written) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  bool initialized = Init();
-  DCHECK(initialized);
+  // (ad_info_uuid, category_name)
+  std::set<std::pair<std::string, std::string>> stored_ad_info_categories;
+  sql::Statement select_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT ad_info_uuid, category_name FROM ad_info_category"));
+  while (select_statement.Step()) {
+    stored_ad_info_categories.emplace(select_statement.ColumnString(0),
+                                      select_statement.ColumnString(1));
+  }
 
-  if (!initialized)
-    return false;
+  std::set<std::pair<std::string, std::string>> ad_info_categories;
+  for (const auto& category : bundle_state.categories) {
+    for (const auto& info : category.second)
+      ad_info_categories.emplace(info.uuid, category.first);
+  }
+
+  for (const auto& ad_info_category : stored_ad_info_categories) {
+    if (ad_info_categories.count(ad_info_category))
+      continue;
 
-  for (auto it = info.regions.begin(); it != info.regions.end(); ++it) {
-    sql::Statement ad_info_statement(
-        GetDB().GetCachedStatement(SQL_FROM_HERE,
-            "INSERT OR REPLACE INTO ad_info "
-            "(creative_set_id, advertiser, notification_text, "
-            "notification_url, start_timestamp, end_timestamp, uuid, "
-            "campaign_id, daily_cap, per_day, total_max, region) "
-            "VALUES (?, ?, ?, ?, datetime(?), datetime(?), ?, ?, ?, ?, ?, ?)"));
-
-    ad_info_statement.BindString(0, info.creative_set_id);
-    ad_info_statement.BindString(1, info.advertiser);
-    ad_info_statement.BindString(2, info.notification_text);
-    ad_info_statement.BindString(3, info.notification_url);
-    ad_info_statement.BindString(4, info.start_timestamp);
-    ad_info_statement.BindString(5, info.end_timestamp);
-    ad_info_statement.BindString(6, info.uuid);
-    ad_info_statement.BindString(7, info.campaign_id);
-    ad_info_statement.BindInt(8, info.daily_cap);
-    ad_info_statement.BindInt(9, info.per_day);
-    ad_info_statement.BindInt(10, info.total_max);
-    ad_info_statement.BindString(11, *it);
-    if (!ad_info_statement.Run()) {
+    sql::Statement delete_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+        "DELETE FROM ad_info_category "
+        "WHERE ad_info_uuid = ? AND category_name = ?"));
+    delete_statement.BindString(0, ad_info_category.first);
+    delete_statement.BindString(1, ad_info_category.second);
+    if (!delete_statement.Run())
+      return false;
+    *rows_written += GetDB().GetLastChangeCount();
+  }
+
+  for (const auto& ad_info_category : ad_info_categories) {
+    if (stored_ad_info_categories.count(ad_info_category))
+      continue;
+
+    if (!InsertOrUpdateAdInfoCategory(ad_info_category.first,
+                                      ad_info_category.second)) {
       return false;
     }
+    *rows_written += GetDB().GetLastChangeCount();
   }
 
   return true;
 }
 
+bool BundleStateDatabase::InsertOrUpdateCategory(const std::string& category) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  bool initialized = Init();
+  DCHECK(initialized);
+
+  if (!initialized)
+    return false;
+
+  sql::Statement ad_info_statement(
+      GetDB().GetCachedStatement(SQL_FROM_HERE,
+          "INSERT OR REPLACE INTO category "
+          "(name) "
+          "VALUES (?)"));
+
+  ad_info_statement.BindString(0, category);
+
+  return ad_info_statement.Run();
+}
+
 bool BundleStateDatabase::InsertOrUpdateAdInfoCategory(
-    const ads::AdInfo& ad_info,
+    const std::string& ad_info_uuid,
     const std::string& category) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -330,7 +503,7 @@ bool BundleStateDatabase::InsertOrUpdateAdInfoCategory(
           "(ad_info_uuid, category_name) "
           "VALUES (?, ?)"));
 
-  ad_info_statement.BindString(0, ad_info.uuid);
+  ad_info_statement.BindString(0, ad_info_uuid);
   ad_info_statement.BindString(1, category);
 
   return ad_info_statement.Run();
@@ -347,24 +520,51 @@ bool BundleStateDatabase::GetAdsForCategory(
   if (!initialized)
     return false;
 
+  const int64_t now = GetLocalTimeT(base::Time::Now());
+
+  auto it = ads_for_category_cache_.find(category);
+  if (it == ads_for_category_cache_.end()) {
+    std::vector<CachedAdInfo> cached_ads;
+    if (!GetUnexpiredAdsForCategory(category, now, &cached_ads))
+      return false;
+    it = ads_for_category_cache_.emplace(category, std::move(cached_ads)).first;
+  }
+
+  // Ads which have expired since the category was cached are skipped here,
+  // so the cache only has to be dropped when the bundle changes.
+  for (const auto& cached_ad : it->second) {
+    if (cached_ad.start_timestamp <= now && cached_ad.end_timestamp >= now)
+      ads->push_back(cached_ad.info);
+  }
+
+  return true;
+}
+
+bool BundleStateDatabase::GetUnexpiredAdsForCategory(
+    const std::string& category,
+    int64_t now,
+    std::vector<CachedAdInfo>* ads) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
   sql::Statement info_sql(
-      db_.GetUniqueStatement(
+      db_.GetCachedStatement(SQL_FROM_HERE,
           "SELECT ai.creative_set_id, ai.advertiser, "
           "ai.notification_text, ai.notification_url, "
-          "ai.start_timestamp, ai.end_timestamp, "
+          "datetime(ai.start_timestamp, 'unixepoch'), "
+          "datetime(ai.end_timestamp, 'unixepoch'), "
           "ai.uuid, ai.region, ai.campaign_id, ai.daily_cap, "
-          "ai.per_day, ai.total_max FROM ad_info AS ai "
+          "ai.per_day, ai.total_max, "
+          "ai.start_timestamp, ai.end_timestamp FROM ad_info AS ai "
           "INNER JOIN ad_info_category AS aic "
           "ON aic.ad_info_uuid = ai.uuid "
           "WHERE aic.category_name = ? and "
-          "ai.start_timestamp <= strftime('%Y-%m-%d %H:%M', "
-          "datetime('now','localtime')) and "
-          "ai.end_timestamp >= strftime('%Y-%m-%d %H:%M', "
-          "datetime('now','localtime'));"));
+          "ai.end_timestamp >= ?"));
   info_sql.BindString(0, category);
+  info_sql.BindInt64(1, now);
 
   while (info_sql.Step()) {
-    ads::AdInfo info;
+    CachedAdInfo cached_ad;
+    ads::AdInfo& info = cached_ad.info;
     info.creative_set_id = info_sql.ColumnString(0);
     info.advertiser = info_sql.ColumnString(1);
     info.notification_text = info_sql.ColumnString(2);
@@ -376,10 +576,12 @@ bool BundleStateDatabase::GetAdsForCategory(
     info.daily_cap = info_sql.ColumnInt(9);
     info.per_day = info_sql.ColumnInt(10);
     info.total_max = info_sql.ColumnInt(11);
-    ads->emplace_back(info);
+    cached_ad.start_timestamp = info_sql.ColumnInt64(12);
+    cached_ad.end_timestamp = info_sql.ColumnInt64(13);
+    ads->push_back(std::move(cached_ad));
   }
 
-  return true;
+  return info_sql.Succeeded();
 }
 
 // static
@@ -398,9 +600,27 @@ void BundleStateDatabase::Vacuum() {
   ignore_result(db_.Execute("VACUUM"));
 }
 
+void BundleStateDatabase::VacuumIfNeeded() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  int64_t last_vacuum_time = 0;
+  meta_table_.GetValue(kLastVacuumTimeKey, &last_vacuum_time);
+
+  const base::Time now = base::Time::Now();
+  const base::Time last_vacuum = base::Time::FromDeltaSinceWindowsEpoch(
+      base::TimeDelta::FromMicroseconds(last_vacuum_time));
+  if (now >= last_vacuum && now - last_vacuum < kVacuumInterval)
+    return;
+
+  Vacuum();
+  meta_table_.SetValue(kLastVacuumTimeKey,
+                       now.ToDeltaSinceWindowsEpoch().InMicroseconds());
+}
+
 void BundleStateDatabase::OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  ads_for_category_cache_.clear();
   db_.TrimMemory();
 }
 
@@ -458,27 +678,89 @@ bool BundleStateDatabase::MigrateV1toV2() {
   return false;
 }
 
+bool BundleStateDatabase::MigrateV2toV3() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Timestamps are stored as seconds since the epoch instead of datetime
+  // strings, so ads can be selected with an indexed integer comparison.
+  sql::Transaction transaction(&GetDB());
+  if (!transaction.Begin())
+    return false;
+
+  // The converted rows go into a new table which then replaces ad_info.
+  // Renaming ad_info out of the way instead would make SQLite 3.26 and later
+  // point ad_info_category's foreign key at the renamed table, which is then
+  // dropped.
+  std::string sql = "CREATE TABLE ad_info_new";
+  sql.append(kAdInfoColumnDefinitions);
+  if (!GetDB().Execute(sql.c_str()))
+    return false;
+
+  const std::string columns_insert =
+      "creative_set_id, advertiser, notification_text, notification_url, "
+      "start_timestamp, end_timestamp, uuid, region, campaign_id, "
+      "daily_cap, per_day, total_max";
+
+  const std::string columns_select =
+      "creative_set_id, advertiser, notification_text, notification_url, "
+      "CAST(strftime('%s', start_timestamp) AS INTEGER), "
+      "CAST(strftime('%s', end_timestamp) AS INTEGER), "
+      "uuid, region, campaign_id, daily_cap, per_day, total_max";
+
+  sql = "INSERT INTO ad_info_new (" + columns_insert + ") "
+        "SELECT " + columns_select + " FROM ad_info;";
+  sql.append("DROP TABLE ad_info;");
+  sql.append("ALTER TABLE ad_info_new RENAME TO ad_info;");
+  if (!GetDB().Execute(sql.c_str()))
+    return false;
+
+  if (!CreateAdInfoUuidIndex())
+    return false;
+
+  // Older versions would write datetime strings into the integer columns.
+  if (!meta_table_.SetCompatibleVersionNumber(kCompatibleVersionNumber))
+    return false;
+
+  return transaction.Commit();
+}
+
+bool BundleStateDatabase::Migrate(int version) {
+  switch (version) {
+    case 2: {
+      return MigrateV1toV2();
+    }
+    case 3: {
+      return MigrateV2toV3();
+    }
+    default:
+      return false;
+  }
+}
+
 sql::InitStatus BundleStateDatabase::EnsureCurrentVersion() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   // We can't read databases newer than we were designed for.
   if (meta_table_.GetCompatibleVersionNumber() > GetCurrentVersion()) {
-    LOG(WARNING) << "Publisher info database is too new.";
+    LOG(WARNING) << "Bundle state database is too new.";
     return sql::INIT_TOO_NEW;
   }
 
   const int old_version = meta_table_.GetVersionNumber();
-  const int cur_version = GetCurrentVersion();
-
-  // Migration from version 1 to version 2
-  if (old_version == 1 && cur_version == 2) {
-    if (!MigrateV1toV2()) {
-      LOG(ERROR) << "DB: Error with MigrateV1toV2";
+  const int current_version = GetCurrentVersion();
+  const int start_version = old_version + 1;
+
+  int migrated_version = old_version;
+  for (auto i = start_version; i <= current_version; i++) {
+    if (!Migrate(i)) {
+      LOG(ERROR) << "DB: Error with MigrateV" << (i - 1) << "toV" << i;
+      break;
     }
 
-    meta_table_.SetVersionNumber(cur_version);
+    migrated_version = i;
   }
 
+  meta_table_.SetVersionNumber(migrated_version);
   return sql::INIT_OK;
 }
 
@@ -7,13 +7,17 @@
 #define BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_BUNDLE_STATE_DATABASE_H_
 
 #include <stddef.h>
+#include <stdint.h>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 #include <memory>
 
 #include "bat/ads/ad_info.h"
 #include "bat/ads/bundle_state.h"
 #include "base/compiler_specific.h"
+#include "base/containers/span.h"
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/memory_pressure_listener.h"
@@ -36,7 +40,10 @@ class BundleStateDatabase {
     db_.set_error_callback(error_callback);
   }
 
+  // Writes only the categories and ads which changed since the last save.
   bool SaveBundleState(const ads::BundleState& bundle_state);
+  // Returns the ads of |category| which are running now. The unexpired ads
+  // of each category are kept in memory until the next SaveBundleState().
   bool GetAdsForCategory(
       const std::string& category,
       std::vector<ads::AdInfo>* ads);
@@ -48,9 +55,25 @@ class BundleStateDatabase {
   // unused space in the file. It can be VERY SLOW.
   void Vacuum();
 
+  // Number of rows inserted, replaced or deleted by the last successful
+  // SaveBundleState().
+  int last_save_rows_written() const { return last_save_rows_written_; }
+
   std::string GetDiagnosticInfo(int extended_error, sql::Statement* statement);
 
  private:
+  struct CachedAdInfo {
+    CachedAdInfo();
+    CachedAdInfo(const CachedAdInfo& other);
+    CachedAdInfo(CachedAdInfo&& other);
+    ~CachedAdInfo();
+
+    ads::AdInfo info;
+    // Seconds since the epoch.
+    int64_t start_timestamp = 0;
+    int64_t end_timestamp = 0;
+  };
+
   bool Init();
   void OnMemoryPressure(
       base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
@@ -59,27 +82,50 @@ class BundleStateDatabase {
   bool CreateAdInfoTable();
   bool CreateAdInfoCategoryTable();
   bool CreateAdInfoCategoryNameIndex();
-
-  bool TruncateCategoryTable();
-  bool TruncateAdInfoTable();
-  bool TruncateAdInfoCategoryTable();
+  bool CreateAdInfoUuidIndex();
+  bool CreateNewAdInfoTable();
+
+  // An ad and one of its regions, which together make one ad_info row.
+  using AdInfoRegion = std::pair<const ads::AdInfo*, const std::string*>;
+
+  bool InsertNewAdInfo(const ads::BundleState& bundle_state);
+  bool InsertNewAdInfoRows(base::span<const AdInfoRegion> rows);
+  bool UpdateAdInfo(int* rows_written);
+  bool UpdateCategories(
+      const ads::BundleState& bundle_state,
+      int* rows_written);
+  bool UpdateAdInfoCategories(
+      const ads::BundleState& bundle_state,
+      int* rows_written);
 
   bool InsertOrUpdateCategory(const std::string& category);
-  bool InsertOrUpdateAdInfo(const ads::AdInfo& info);
   bool InsertOrUpdateAdInfoCategory(
-      const ads::AdInfo& ad_info,
+      const std::string& ad_info_uuid,
       const std::string& category);
 
+  bool GetUnexpiredAdsForCategory(
+      const std::string& category,
+      int64_t now,
+      std::vector<CachedAdInfo>* ads);
+
+  // Vacuums at most once per vacuum interval.
+  void VacuumIfNeeded();
+
   sql::Database& GetDB();
   sql::MetaTable& GetMetaTable();
 
   bool MigrateV1toV2();
+  bool MigrateV2toV3();
+  bool Migrate(int version);
   sql::InitStatus EnsureCurrentVersion();
 
   sql::Database db_;
   sql::MetaTable meta_table_;
   const base::FilePath db_path_;
   bool initialized_;
+  int last_save_rows_written_ = 0;
+
+  std::map<std::string, std::vector<CachedAdInfo>> ads_for_category_cache_;
 
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
@@ -0,0 +1,273 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "brave/components/brave_ads/browser/bundle_state_database.h"
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "build/build_config.h"
+#include "sql/database.h"
+#include "sql/meta_table.h"
+#include "sql/statement.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BundleStateDatabaseTest.*
+
+namespace brave_ads {
+
+namespace {
+
+ads::AdInfo CreateAdInfo(const std::string& uuid,
+                         const std::vector<std::string>& regions) {
+  ads::AdInfo info;
+  info.creative_set_id = "creative-set-" + uuid;
+  info.campaign_id = "campaign-" + uuid;
+  info.start_timestamp = "2000-01-01T00:00:00Z";
+  info.end_timestamp = "2100-01-01T00:00:00Z";
+  info.daily_cap = 1;
+  info.per_day = 2;
+  info.total_max = 3;
+  info.regions = regions;
+  info.advertiser = "advertiser";
+  info.notification_text = "text " + uuid;
+  info.notification_url = "https://brave.com/" + uuid;
+  info.uuid = uuid;
+  return info;
+}
+
+#if defined(OS_POSIX)
+// Sets the local time zone for the lifetime of the object.
+class ScopedTimeZone {
+ public:
+  explicit ScopedTimeZone(const char* time_zone) {
+    const char* old_time_zone = getenv("TZ");
+    if (old_time_zone) {
+      had_time_zone_ = true;
+      old_time_zone_ = old_time_zone;
+    }
+    setenv("TZ", time_zone, 1);
+    tzset();
+  }
+
+  ~ScopedTimeZone() {
+    if (had_time_zone_)
+      setenv("TZ", old_time_zone_.c_str(), 1);
+    else
+      unsetenv("TZ");
+    tzset();
+  }
+
+ private:
+  bool had_time_zone_ = false;
+  std::string old_time_zone_;
+};
+#endif  // defined(OS_POSIX)
+
+}  // namespace
+
+class BundleStateDatabaseTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    database_ = std::make_unique<BundleStateDatabase>(db_path());
+  }
+
+  std::vector<std::string> GetAdUuidsForCategory(const std::string& category) {
+    std::vector<ads::AdInfo> ads;
+    EXPECT_TRUE(database_->GetAdsForCategory(category, &ads));
+    std::vector<std::string> uuids;
+    for (const auto& ad : ads)
+      uuids.push_back(ad.uuid + ":" + ad.notification_text);
+    std::sort(uuids.begin(), uuids.end());
+    return uuids;
+  }
+
+  base::FilePath db_path() const {
+    return temp_dir_.GetPath().AppendASCII("BundleStateDatabaseTest.db");
+  }
+
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<BundleStateDatabase> database_;
+};
+
+TEST_F(BundleStateDatabaseTest, SaveBundleStateWritesOnlyChanges) {
+  ads::BundleState bundle_state;
+  bundle_state.categories["Technology"] = {
+      CreateAdInfo("1", {"US", "CA"}), CreateAdInfo("2", {"US"})};
+  bundle_state.categories["Travel"] = {CreateAdInfo("3", {"US"})};
+
+  // 4 ad_info rows, 2 categories and 3 ad_info_category rows.
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+  EXPECT_EQ(9, database_->last_save_rows_written());
+  EXPECT_EQ(std::vector<std::string>({"1:text 1", "1:text 1", "2:text 2"}),
+            GetAdUuidsForCategory("Technology"));
+
+  // Saving the same catalog again leaves every row alone.
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+  EXPECT_EQ(0, database_->last_save_rows_written());
+
+  // Change one ad, drop another and its category.
+  bundle_state.categories["Technology"][1].notification_text = "changed";
+  bundle_state.categories.erase("Travel");
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+  // 1 replaced and 1 deleted ad_info row, 1 deleted category and 1 deleted
+  // ad_info_category row.
+  EXPECT_EQ(4, database_->last_save_rows_written());
+  EXPECT_EQ(std::vector<std::string>({"1:text 1", "1:text 1", "2:changed"}),
+            GetAdUuidsForCategory("Technology"));
+  EXPECT_TRUE(GetAdUuidsForCategory("Travel").empty());
+
+  // Removing a region deletes only that row.
+  bundle_state.categories["Technology"][0].regions = {"US"};
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+  EXPECT_EQ(1, database_->last_save_rows_written());
+  EXPECT_EQ(std::vector<std::string>({"1:text 1", "2:changed"}),
+            GetAdUuidsForCategory("Technology"));
+}
+
+TEST_F(BundleStateDatabaseTest, SaveBundleStateInMultipleInserts) {
+  // More rows than a single multi-row insert binds.
+  ads::BundleState bundle_state;
+  auto& ads = bundle_state.categories["Technology"];
+  for (int i = 0; i < 120; ++i)
+    ads.push_back(CreateAdInfo(std::to_string(i), {"US"}));
+
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+  EXPECT_EQ(120 + 1 + 120, database_->last_save_rows_written());
+  EXPECT_EQ(120u, GetAdUuidsForCategory("Technology").size());
+
+  ads.pop_back();
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+  EXPECT_EQ(2, database_->last_save_rows_written());
+  EXPECT_EQ(119u, GetAdUuidsForCategory("Technology").size());
+}
+
+TEST_F(BundleStateDatabaseTest, GetAdsForCategorySkipsAdsNotRunning) {
+  ads::BundleState bundle_state;
+  ads::AdInfo expired = CreateAdInfo("expired", {"US"});
+  expired.end_timestamp = "2001-01-01T00:00:00Z";
+  ads::AdInfo upcoming = CreateAdInfo("upcoming", {"US"});
+  upcoming.start_timestamp = "2099-01-01T00:00:00Z";
+  bundle_state.categories["Technology"] = {
+      CreateAdInfo("running", {"US"}), expired, upcoming};
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+
+  std::vector<ads::AdInfo> ads;
+  ASSERT_TRUE(database_->GetAdsForCategory("Technology", &ads));
+  ASSERT_EQ(1u, ads.size());
+  EXPECT_EQ("running", ads[0].uuid);
+  EXPECT_EQ("2000-01-01 00:00:00", ads[0].start_timestamp);
+  EXPECT_EQ("2100-01-01 00:00:00", ads[0].end_timestamp);
+
+  // Served from the cache the second time.
+  ads.clear();
+  ASSERT_TRUE(database_->GetAdsForCategory("Technology", &ads));
+  ASSERT_EQ(1u, ads.size());
+  EXPECT_EQ("running", ads[0].uuid);
+}
+
+#if defined(OS_POSIX)
+TEST_F(BundleStateDatabaseTest, GetAdsForCategoryUsesLocalTime) {
+  // Ten hours behind UTC.
+  ScopedTimeZone time_zone("UTC+10");
+
+  // Ended an hour ago in UTC, but the local clock hasn't got there yet.
+  base::Time::Exploded exploded;
+  (base::Time::Now() - base::TimeDelta::FromHours(1)).UTCExplode(&exploded);
+  ads::AdInfo info = CreateAdInfo("1", {"US"});
+  info.end_timestamp = base::StringPrintf(
+      "%04d-%02d-%02dT%02d:%02d:%02dZ", exploded.year, exploded.month,
+      exploded.day_of_month, exploded.hour, exploded.minute, exploded.second);
+
+  ads::BundleState bundle_state;
+  bundle_state.categories["Technology"] = {info};
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+
+  std::vector<ads::AdInfo> ads;
+  ASSERT_TRUE(database_->GetAdsForCategory("Technology", &ads));
+  ASSERT_EQ(1u, ads.size());
+  EXPECT_EQ("1", ads[0].uuid);
+}
+#endif  // defined(OS_POSIX)
+
+TEST_F(BundleStateDatabaseTest, MigrateV2toV3) {
+  {
+    sql::Database db;
+    ASSERT_TRUE(db.Open(db_path()));
+    sql::MetaTable meta_table;
+    ASSERT_TRUE(meta_table.Init(&db, 2, 2));
+    ASSERT_TRUE(db.Execute(
+        "CREATE TABLE ad_info ("
+        "creative_set_id LONGVARCHAR, advertiser LONGVARCHAR,"
+        "notification_text TEXT, notification_url LONGVARCHAR,"
+        "start_timestamp DATETIME, end_timestamp DATETIME,"
+        "uuid LONGVARCHAR, region VARCHAR, campaign_id LONGVARCHAR,"
+        "daily_cap INTEGER DEFAULT 0 NOT NULL,"
+        "per_day INTEGER DEFAULT 0 NOT NULL,"
+        "total_max INTEGER DEFAULT 0 NOT NULL,"
+        "PRIMARY KEY(region, uuid));"
+        "CREATE TABLE category (name LONGVARCHAR PRIMARY KEY);"
+        "CREATE TABLE ad_info_category ("
+        "ad_info_uuid LONGVARCHAR NOT NULL,"
+        "category_name LONGVARCHAR NOT NULL,"
+        "UNIQUE(ad_info_uuid, category_name) ON CONFLICT REPLACE,"
+        "CONSTRAINT fk_ad_info_uuid"
+        "    FOREIGN KEY (ad_info_uuid)"
+        "    REFERENCES ad_info (uuid)"
+        "    ON DELETE CASCADE,"
+        "CONSTRAINT fk_category_name"
+        "    FOREIGN KEY (category_name)"
+        "    REFERENCES category (name)"
+        "    ON DELETE CASCADE);"
+        "INSERT INTO ad_info VALUES ('creative-set-1', 'advertiser', 'text 1',"
+        "'https://brave.com/1', datetime('2000-01-01T00:00:00Z'),"
+        "datetime('2100-01-01T00:00:00Z'), '1', 'US', 'campaign-1', 1, 2, 3);"
+        "INSERT INTO category VALUES ('Technology');"
+        "INSERT INTO ad_info_category VALUES ('1', 'Technology');"));
+  }
+
+  std::vector<ads::AdInfo> ads;
+  ASSERT_TRUE(database_->GetAdsForCategory("Technology", &ads));
+  ASSERT_EQ(1u, ads.size());
+  EXPECT_EQ("1", ads[0].uuid);
+  EXPECT_EQ("2000-01-01 00:00:00", ads[0].start_timestamp);
+  EXPECT_EQ("2100-01-01 00:00:00", ads[0].end_timestamp);
+  EXPECT_EQ(3u, ads[0].total_max);
+  EXPECT_EQ(3, BundleStateDatabase::GetCurrentVersion());
+
+  // ad_info_category still references ad_info, not a table the migration
+  // dropped.
+  {
+    sql::Database db;
+    ASSERT_TRUE(db.Open(db_path()));
+    sql::Statement statement(db.GetUniqueStatement(
+        "SELECT sql FROM sqlite_master WHERE name = 'ad_info_category'"));
+    ASSERT_TRUE(statement.Step());
+    const std::string schema = statement.ColumnString(0);
+    EXPECT_NE(std::string::npos, schema.find("REFERENCES ad_info (uuid)"));
+    EXPECT_EQ(std::string::npos, schema.find("ad_info_old"));
+    EXPECT_EQ(std::string::npos, schema.find("ad_info_new"));
+    EXPECT_TRUE(db.DoesTableExist("ad_info"));
+    EXPECT_FALSE(db.DoesTableExist("ad_info_new"));
+  }
+
+  // The same catalog saved again after the migration is unchanged.
+  ads::BundleState bundle_state;
+  bundle_state.categories["Technology"] = {CreateAdInfo("1", {"US"})};
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+  EXPECT_EQ(0, database_->last_save_rows_written());
+}
+
+}  // namespace brave_ads
@@ -0,0 +1,94 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/browser/idle_monitor.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/time/tick_clock.h"
+
+namespace brave_ads {
+
+namespace {
+
+constexpr base::TimeDelta kIdlePollInterval = base::TimeDelta::FromSeconds(1);
+
+}  // namespace
+
+IdleMonitor::IdleMonitor(Observer* observer,
+                         const base::TickClock* tick_clock)
+    : observer_(observer),
+      tick_clock_(tick_clock),
+      idle_threshold_in_seconds_(0),
+      idle_state_(ui::IdleState::IDLE_STATE_ACTIVE),
+      wakeup_count_(0),
+      timer_(tick_clock),
+      idle_time_callback_(base::BindRepeating(&ui::CalculateIdleTime)),
+      is_locked_callback_(base::BindRepeating(&ui::CheckIdleStateIsLocked)) {
+  DCHECK(observer_);
+}
+
+IdleMonitor::~IdleMonitor() {}
+
+void IdleMonitor::Start(int idle_threshold_in_seconds) {
+  idle_threshold_in_seconds_ = idle_threshold_in_seconds;
+  if (first_start_time_.is_null())
+    first_start_time_ = tick_clock_->NowTicks();
+
+  timer_.Start(FROM_HERE, kIdlePollInterval,
+               base::BindOnce(&IdleMonitor::CheckIdleState,
+                              base::Unretained(this)));
+}
+
+void IdleMonitor::Stop() {
+  timer_.Stop();
+}
+
+uint64_t IdleMonitor::polling_wakeup_count() const {
+  if (first_start_time_.is_null())
+    return 0;
+
+  return (tick_clock_->NowTicks() - first_start_time_) / kIdlePollInterval;
+}
+
+void IdleMonitor::SetIdleStateCallbacksForTesting(
+    const base::RepeatingCallback<int()>& idle_time_callback,
+    const base::RepeatingCallback<bool()>& is_locked_callback) {
+  idle_time_callback_ = idle_time_callback;
+  is_locked_callback_ = is_locked_callback;
+}
+
+void IdleMonitor::CheckIdleState() {
+  wakeup_count_++;
+
+  // Same rules as ui::CalculateIdleState()
+  const int idle_time_in_seconds = idle_time_callback_.Run();
+  ui::IdleState idle_state = ui::IdleState::IDLE_STATE_ACTIVE;
+  if (is_locked_callback_.Run())
+    idle_state = ui::IdleState::IDLE_STATE_LOCKED;
+  else if (idle_time_in_seconds >= idle_threshold_in_seconds_)
+    idle_state = ui::IdleState::IDLE_STATE_IDLE;
+
+  base::TimeDelta delay = kIdlePollInterval;
+  if (idle_state == ui::IdleState::IDLE_STATE_ACTIVE) {
+    // Without further input the user goes idle when the threshold is
+    // reached, and any input only pushes that further out
+    delay = std::max(delay, base::TimeDelta::FromSeconds(
+        idle_threshold_in_seconds_ - idle_time_in_seconds));
+  }
+  timer_.Start(FROM_HERE, delay,
+               base::BindOnce(&IdleMonitor::CheckIdleState,
+                              base::Unretained(this)));
+
+  if (idle_state == idle_state_)
+    return;
+
+  idle_state_ = idle_state;
+  observer_->OnIdleStateChanged(idle_state);
+}
+
+}  // namespace brave_ads
@@ -0,0 +1,78 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_IDLE_MONITOR_H_
+#define BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_IDLE_MONITOR_H_
+
+#include <stdint.h>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "ui/base/idle/idle.h"
+
+namespace base {
+class TickClock;
+}  // namespace base
+
+namespace brave_ads {
+
+// Tells an observer when the user goes idle, locks the screen or becomes
+// active again.
+//
+// Desktop platforms don't notify about idle time, so the monitor still asks
+// ui::CalculateIdleTime(), but only when the state can next change. While
+// the user is active it wakes up once, at the moment the idle threshold
+// would be crossed without further input. Becoming active again has no such
+// deadline, so it is polled for while idle or locked.
+class IdleMonitor {
+ public:
+  class Observer {
+   public:
+    virtual void OnIdleStateChanged(ui::IdleState idle_state) = 0;
+
+   protected:
+    virtual ~Observer() {}
+  };
+
+  IdleMonitor(Observer* observer, const base::TickClock* tick_clock);
+  ~IdleMonitor();
+
+  // Starts monitoring, or restarts it with a new threshold.
+  void Start(int idle_threshold_in_seconds);
+  void Stop();
+
+  ui::IdleState idle_state() const { return idle_state_; }
+
+  // The number of times the idle state was checked since the first Start(),
+  // and the number of checks polling once a second would have made instead.
+  uint64_t wakeup_count() const { return wakeup_count_; }
+  uint64_t polling_wakeup_count() const;
+
+  void SetIdleStateCallbacksForTesting(
+      const base::RepeatingCallback<int()>& idle_time_callback,
+      const base::RepeatingCallback<bool()>& is_locked_callback);
+
+ private:
+  void CheckIdleState();
+
+  Observer* observer_;  // NOT OWNED
+  const base::TickClock* tick_clock_;  // NOT OWNED
+  int idle_threshold_in_seconds_;
+  ui::IdleState idle_state_;
+  uint64_t wakeup_count_;
+  base::TimeTicks first_start_time_;
+  base::OneShotTimer timer_;
+
+  base::RepeatingCallback<int()> idle_time_callback_;
+  base::RepeatingCallback<bool()> is_locked_callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(IdleMonitor);
+};
+
+}  // namespace brave_ads
+
+#endif  // BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_IDLE_MONITOR_H_
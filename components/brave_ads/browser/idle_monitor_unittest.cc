@@ -0,0 +1,116 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <vector>
+
+#include "brave/components/brave_ads/browser/idle_monitor.h"
+
+#include "base/bind.h"
+#include "base/test/scoped_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=IdleMonitorTest.*
+
+namespace brave_ads {
+
+class IdleMonitorTest : public ::testing::Test,
+                        public IdleMonitor::Observer {
+ protected:
+  IdleMonitorTest()
+      : scoped_task_environment_(
+            base::test::ScopedTaskEnvironment::MainThreadType::MOCK_TIME),
+        idle_monitor_(this, scoped_task_environment_.GetMockTickClock()) {
+    idle_monitor_.SetIdleStateCallbacksForTesting(
+        base::BindRepeating(&IdleMonitorTest::GetIdleTime,
+                            base::Unretained(this)),
+        base::BindRepeating(&IdleMonitorTest::IsLocked,
+                            base::Unretained(this)));
+  }
+
+  // IdleMonitor::Observer implementation
+  void OnIdleStateChanged(ui::IdleState idle_state) override {
+    idle_states_.push_back(idle_state);
+  }
+
+  // Simulates the user's input, |last_input_time_| being when it last
+  // happened.
+  void UserInput() {
+    last_input_time_ = scoped_task_environment_.NowTicks();
+  }
+
+  int GetIdleTime() {
+    return (scoped_task_environment_.NowTicks() - last_input_time_)
+        .InSeconds();
+  }
+
+  bool IsLocked() { return is_locked_; }
+
+  void FastForwardBy(int seconds) {
+    scoped_task_environment_.FastForwardBy(
+        base::TimeDelta::FromSeconds(seconds));
+  }
+
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
+  IdleMonitor idle_monitor_;
+  std::vector<ui::IdleState> idle_states_;
+  base::TimeTicks last_input_time_;
+  bool is_locked_ = false;
+};
+
+TEST_F(IdleMonitorTest, WakesUpOnlyAtThresholdWhileActive) {
+  UserInput();
+  idle_monitor_.Start(15);
+
+  // The first check is made after one second, the next one when the user
+  // would reach the threshold.
+  FastForwardBy(1);
+  EXPECT_EQ(1u, idle_monitor_.wakeup_count());
+  UserInput();
+  FastForwardBy(14);
+  EXPECT_EQ(2u, idle_monitor_.wakeup_count());
+  EXPECT_TRUE(idle_states_.empty());
+  EXPECT_EQ(ui::IdleState::IDLE_STATE_ACTIVE, idle_monitor_.idle_state());
+
+  // No input since the last check.
+  FastForwardBy(1);
+  EXPECT_EQ(3u, idle_monitor_.wakeup_count());
+  ASSERT_EQ(1u, idle_states_.size());
+  EXPECT_EQ(ui::IdleState::IDLE_STATE_IDLE, idle_states_[0]);
+
+  // Polled while idle.
+  FastForwardBy(5);
+  EXPECT_EQ(8u, idle_monitor_.wakeup_count());
+  UserInput();
+  FastForwardBy(1);
+  ASSERT_EQ(2u, idle_states_.size());
+  EXPECT_EQ(ui::IdleState::IDLE_STATE_ACTIVE, idle_states_[1]);
+
+  EXPECT_EQ(22u, idle_monitor_.polling_wakeup_count());
+  EXPECT_LT(idle_monitor_.wakeup_count(),
+            idle_monitor_.polling_wakeup_count());
+}
+
+TEST_F(IdleMonitorTest, ReportsLocked) {
+  UserInput();
+  idle_monitor_.Start(15);
+  FastForwardBy(1);
+
+  is_locked_ = true;
+  FastForwardBy(15);
+  ASSERT_EQ(1u, idle_states_.size());
+  EXPECT_EQ(ui::IdleState::IDLE_STATE_LOCKED, idle_states_[0]);
+}
+
+TEST_F(IdleMonitorTest, Stop) {
+  UserInput();
+  idle_monitor_.Start(15);
+  idle_monitor_.Stop();
+
+  FastForwardBy(60);
+  EXPECT_EQ(0u, idle_monitor_.wakeup_count());
+  EXPECT_TRUE(idle_states_.empty());
+}
+
+}  // namespace brave_ads
@@ -38,7 +38,11 @@ class BraveComponent {
                 const std::string& component_id,
                 const std::string& component_base64_public_key);
   bool Unregister();
-  scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
+  // The sequence component files are read and parsed on, unless a component
+  // needs one of its own.
+  virtual scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
+
+  const std::string& component_name() const { return component_name_; }
 
  protected:
   virtual void OnComponentReady(const std::string& component_id,
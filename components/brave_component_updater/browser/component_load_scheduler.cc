@@ -0,0 +1,173 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/process/process_info.h"
+#include "base/system/sys_info.h"
+#include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
+
+namespace brave_component_updater {
+
+namespace {
+
+// Leaves a core to the rest of startup, but always loads two components in
+// parallel so that one large DAT can't hold up all the others.
+size_t GetDefaultMaxConcurrentLoads() {
+  return std::max(2, base::SysInfo::NumberOfProcessors() - 1);
+}
+
+base::TaskPriority GetTaskPriority(ComponentLoadScheduler::Priority priority) {
+  return priority == ComponentLoadScheduler::Priority::kHigh
+             ? base::TaskPriority::USER_BLOCKING
+             : base::TaskPriority::USER_VISIBLE;
+}
+
+}  // namespace
+
+ComponentLoadScheduler::PendingLoad::PendingLoad() = default;
+ComponentLoadScheduler::PendingLoad::PendingLoad(PendingLoad&& other) =
+    default;
+ComponentLoadScheduler::PendingLoad&
+ComponentLoadScheduler::PendingLoad::operator=(PendingLoad&& other) = default;
+ComponentLoadScheduler::PendingLoad::~PendingLoad() = default;
+
+// static
+ComponentLoadScheduler* ComponentLoadScheduler::GetInstance() {
+  static base::NoDestructor<ComponentLoadScheduler> instance(
+      GetDefaultMaxConcurrentLoads());
+  return instance.get();
+}
+
+ComponentLoadScheduler::ComponentLoadScheduler(size_t max_concurrent_loads)
+    : max_concurrent_loads_(max_concurrent_loads),
+      running_loads_(0),
+      next_load_id_(0),
+      weak_factory_(this) {
+  DCHECK_GT(max_concurrent_loads_, 0u);
+  // Created on first use, which doesn't have to be on the sequence it is
+  // then used on.
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+ComponentLoadScheduler::~ComponentLoadScheduler() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+void ComponentLoadScheduler::ScheduleLoad(
+    const std::string& component_name,
+    Priority priority,
+    base::OnceClosure load,
+    base::OnceClosure reply,
+    scoped_refptr<base::SequencedTaskRunner> task_runner) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  PendingLoad pending_load;
+  pending_load.id = next_load_id_++;
+  pending_load.component_name = component_name;
+  pending_load.priority = priority;
+  pending_load.load = std::move(load);
+  pending_load.reply = std::move(reply);
+  pending_load.task_runner = std::move(task_runner);
+  pending_load.schedule_time = base::TimeTicks::Now();
+  TRACE_EVENT_ASYNC_BEGIN1("browser", "ComponentLoad", pending_load.id,
+                           "component", component_name);
+
+  pending_loads_[static_cast<size_t>(priority)].push_back(
+      std::move(pending_load));
+  MaybeStartLoads();
+}
+
+void ComponentLoadScheduler::MaybeStartLoads() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  for (auto& queue : pending_loads_) {
+    while (running_loads_ < max_concurrent_loads_ && !queue.empty()) {
+      PendingLoad load = std::move(queue.front());
+      queue.pop_front();
+      StartLoad(std::move(load));
+    }
+  }
+}
+
+void ComponentLoadScheduler::StartLoad(PendingLoad load) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  running_loads_++;
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  TRACE_EVENT_ASYNC_STEP_INTO0("browser", "ComponentLoad", load.id,
+                               "Loading");
+
+  auto reply = base::BindOnce(&ComponentLoadScheduler::OnLoadComplete,
+                              weak_factory_.GetWeakPtr(), load.id,
+                              load.component_name, load.schedule_time,
+                              start_time, std::move(load.reply));
+  if (load.task_runner) {
+    load.task_runner->PostTaskAndReply(FROM_HERE, std::move(load.load),
+                                       std::move(reply));
+    return;
+  }
+
+  base::PostTaskWithTraitsAndReply(
+      FROM_HERE,
+      {base::MayBlock(), GetTaskPriority(load.priority),
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      std::move(load.load), std::move(reply));
+}
+
+void ComponentLoadScheduler::OnLoadComplete(
+    uint64_t load_id,
+    const std::string& component_name,
+    base::TimeTicks schedule_time,
+    base::TimeTicks start_time,
+    base::OnceClosure reply) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK_GT(running_loads_, 0u);
+
+  running_loads_--;
+  MaybeStartLoads();
+
+  std::move(reply).Run();
+
+  TRACE_EVENT_ASYNC_END1("browser", "ComponentLoad", load_id,
+                         "component", component_name);
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const base::Time process_creation_time =
+      base::CurrentProcessInfo::CreationTime();
+  if (!process_creation_time.is_null()) {
+    VLOG(1) << component_name << " ready "
+            << (base::Time::Now() - process_creation_time).InMilliseconds()
+            << " ms after launch";
+  }
+  VLOG(1) << component_name << " waited "
+          << (start_time - schedule_time).InMilliseconds()
+          << " ms and loaded in " << (now - start_time).InMilliseconds()
+          << " ms";
+  if (running_loads_ != 0 || pending_loads() != 0)
+    return;
+
+  VLOG(1) << "All scheduled component loads are done";
+  std::vector<base::OnceClosure> idle_callbacks;
+  idle_callbacks.swap(idle_callbacks_for_testing_);
+  for (auto& callback : idle_callbacks)
+    std::move(callback).Run();
+}
+
+void ComponentLoadScheduler::RunWhenIdleForTesting(
+    base::OnceClosure callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (running_loads_ == 0 && pending_loads() == 0) {
+    std::move(callback).Run();
+    return;
+  }
+  idle_callbacks_for_testing_.push_back(std::move(callback));
+}
+
+}  // namespace brave_component_updater
@@ -0,0 +1,140 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_COMPONENT_LOAD_SCHEDULER_H_
+#define BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_COMPONENT_LOAD_SCHEDULER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/containers/circular_deque.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "base/sequence_checker.h"
+#include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
+
+namespace brave_component_updater {
+
+// Loads the data files of ready components, e.g. deserializing a DAT, off
+// the calling sequence. Independent loads run in parallel on the thread
+// pool, but at most |max_concurrent_loads| at a time so that startup isn't
+// flooded with disk reads, and high priority loads are started before any
+// waiting normal priority ones.
+//
+// Each load is traced as a "ComponentLoad" async event and logs when its
+// component became ready relative to process launch, so it can be seen
+// when shields are fully armed.
+class ComponentLoadScheduler {
+ public:
+  enum class Priority {
+    kHigh,
+    kNormal,
+  };
+
+  static ComponentLoadScheduler* GetInstance();
+
+  explicit ComponentLoadScheduler(size_t max_concurrent_loads);
+  ~ComponentLoadScheduler();
+
+  // Runs |load| once a slot is free, then |reply| on the calling sequence.
+  // |load| runs on |task_runner| when it has to be sequenced with other work
+  // posted there, and on the thread pool otherwise.
+  void ScheduleLoad(
+      const std::string& component_name,
+      Priority priority,
+      base::OnceClosure load,
+      base::OnceClosure reply,
+      scoped_refptr<base::SequencedTaskRunner> task_runner = nullptr);
+
+  // Like ScheduleLoad(), passing the result of |load| to |reply|.
+  template <typename T>
+  void ScheduleLoadWithResult(
+      const std::string& component_name,
+      Priority priority,
+      base::OnceCallback<T()> load,
+      base::OnceCallback<void(T)> reply,
+      scoped_refptr<base::SequencedTaskRunner> task_runner = nullptr) {
+    // |reply| owns the result and only runs after |load| has set it.
+    auto result = std::make_unique<base::Optional<T>>();
+    base::Optional<T>* result_ptr = result.get();
+    ScheduleLoad(
+        component_name, priority,
+        base::BindOnce(&RunLoadAndStoreResult<T>, std::move(load),
+                       result_ptr),
+        base::BindOnce(&ReplyWithResult<T>, std::move(reply),
+                       std::move(result)),
+        std::move(task_runner));
+  }
+
+  size_t running_loads() const { return running_loads_; }
+  size_t pending_loads() const {
+    return pending_loads_[0].size() + pending_loads_[1].size();
+  }
+
+  // Runs |callback| once no loads are running or waiting, and all replies
+  // have run.
+  void RunWhenIdleForTesting(base::OnceClosure callback);
+
+ private:
+  struct PendingLoad {
+    PendingLoad();
+    PendingLoad(PendingLoad&& other);
+    PendingLoad& operator=(PendingLoad&& other);
+    ~PendingLoad();
+
+    uint64_t id;
+    std::string component_name;
+    Priority priority;
+    base::OnceClosure load;
+    base::OnceClosure reply;
+    scoped_refptr<base::SequencedTaskRunner> task_runner;
+    base::TimeTicks schedule_time;
+  };
+
+  template <typename T>
+  static void RunLoadAndStoreResult(base::OnceCallback<T()> load,
+                                    base::Optional<T>* result) {
+    result->emplace(std::move(load).Run());
+  }
+
+  template <typename T>
+  static void ReplyWithResult(base::OnceCallback<void(T)> reply,
+                              std::unique_ptr<base::Optional<T>> result) {
+    std::move(reply).Run(std::move(**result));
+  }
+
+  void MaybeStartLoads();
+  void StartLoad(PendingLoad load);
+  void OnLoadComplete(uint64_t load_id,
+                      const std::string& component_name,
+                      base::TimeTicks schedule_time,
+                      base::TimeTicks start_time,
+                      base::OnceClosure reply);
+
+  const size_t max_concurrent_loads_;
+  size_t running_loads_;
+  uint64_t next_load_id_;
+  // Indexed by Priority.
+  base::circular_deque<PendingLoad> pending_loads_[2];
+  std::vector<base::OnceClosure> idle_callbacks_for_testing_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<ComponentLoadScheduler> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(ComponentLoadScheduler);
+};
+
+}  // namespace brave_component_updater
+
+#endif  // BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_COMPONENT_LOAD_SCHEDULER_H_
@@ -0,0 +1,92 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/task/post_task.h"
+#include "base/test/scoped_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=ComponentLoadSchedulerTest.*
+
+namespace brave_component_updater {
+
+class ComponentLoadSchedulerTest : public ::testing::Test {
+ protected:
+  void Schedule(ComponentLoadScheduler* scheduler,
+                const std::string& component_name,
+                ComponentLoadScheduler::Priority priority) {
+    scheduler->ScheduleLoad(
+        component_name, priority, base::DoNothing(),
+        base::BindOnce(&ComponentLoadSchedulerTest::OnLoaded,
+                       base::Unretained(this), component_name));
+  }
+
+  void OnLoaded(const std::string& component_name) {
+    loaded_.push_back(component_name);
+  }
+
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
+  std::vector<std::string> loaded_;
+};
+
+TEST_F(ComponentLoadSchedulerTest, StartsHighPriorityLoadsFirst) {
+  ComponentLoadScheduler scheduler(1);
+  Schedule(&scheduler, "A", ComponentLoadScheduler::Priority::kNormal);
+  Schedule(&scheduler, "B", ComponentLoadScheduler::Priority::kNormal);
+  Schedule(&scheduler, "C", ComponentLoadScheduler::Priority::kHigh);
+  EXPECT_EQ(1u, scheduler.running_loads());
+  EXPECT_EQ(2u, scheduler.pending_loads());
+
+  // A was already running when C was scheduled.
+  scoped_task_environment_.RunUntilIdle();
+  EXPECT_EQ(std::vector<std::string>({"A", "C", "B"}), loaded_);
+  EXPECT_EQ(0u, scheduler.running_loads());
+  EXPECT_EQ(0u, scheduler.pending_loads());
+}
+
+TEST_F(ComponentLoadSchedulerTest, BoundsConcurrentLoads) {
+  ComponentLoadScheduler scheduler(2);
+  for (const char* component_name : {"A", "B", "C", "D"}) {
+    Schedule(&scheduler, component_name,
+             ComponentLoadScheduler::Priority::kNormal);
+  }
+  EXPECT_EQ(2u, scheduler.running_loads());
+  EXPECT_EQ(2u, scheduler.pending_loads());
+
+  scoped_task_environment_.RunUntilIdle();
+  EXPECT_EQ(4u, loaded_.size());
+  EXPECT_EQ(0u, scheduler.running_loads());
+}
+
+TEST_F(ComponentLoadSchedulerTest, RepliesWithResult) {
+  ComponentLoadScheduler scheduler(1);
+  auto task_runner =
+      base::CreateSequencedTaskRunnerWithTraits({base::MayBlock()});
+  std::unique_ptr<std::string> result;
+  scheduler.ScheduleLoadWithResult<std::unique_ptr<std::string>>(
+      "A", ComponentLoadScheduler::Priority::kHigh,
+      base::BindOnce([]() { return std::make_unique<std::string>("data"); }),
+      base::BindOnce(
+          [](std::unique_ptr<std::string>* result,
+             std::unique_ptr<std::string> data) {
+            *result = std::move(data);
+          },
+          &result),
+      task_runner);
+
+  scoped_task_environment_.RunUntilIdle();
+  ASSERT_TRUE(result);
+  EXPECT_EQ("data", *result);
+}
+
+}  // namespace brave_component_updater
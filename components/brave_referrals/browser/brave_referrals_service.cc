@@ -22,6 +22,7 @@
 #include "brave_base/random.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/first_run/first_run.h"
 #include "chrome/browser/net/system_network_context_manager.h"
@@ -33,7 +34,6 @@
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
-#include "extensions/common/url_pattern.h"
 #include "net/base/load_flags.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 #include "services/network/public/cpp/resource_request.h"
@@ -134,41 +134,6 @@ void BraveReferralsService::Stop() {
   initialized_ = false;
 }
 
-// static
-bool BraveReferralsService::GetMatchingReferralHeaders(
-    const base::ListValue& referral_headers_list,
-    const base::DictionaryValue** request_headers_dict,
-    const GURL& url) {
-  // If the domain for this request matches one of our target domains,
-  // set the associated custom headers.
-  for (const auto& headers_value : referral_headers_list) {
-    const base::Value* domains_list =
-        headers_value.FindKeyOfType("domains", base::Value::Type::LIST);
-    if (!domains_list) {
-      LOG(WARNING) << "Failed to retrieve 'domains' key from referral headers";
-      continue;
-    }
-    const base::Value* headers_dict =
-        headers_value.FindKeyOfType("headers", base::Value::Type::DICTIONARY);
-    if (!headers_dict) {
-      LOG(WARNING) << "Failed to retrieve 'headers' key from referral headers";
-      continue;
-    }
-    for (const auto& domain_value : domains_list->GetList()) {
-      URLPattern url_pattern(URLPattern::SCHEME_HTTPS |
-                             URLPattern::SCHEME_HTTP);
-      url_pattern.SetScheme("*");
-      url_pattern.SetHost(domain_value.GetString());
-      url_pattern.SetPath("/*");
-      url_pattern.SetMatchSubdomains(true);
-      if (!url_pattern.MatchesURL(url))
-        continue;
-      return headers_dict->GetAsDictionary(request_headers_dict);
-    }
-  }
-  return false;
-}
-
 void BraveReferralsService::OnFetchReferralHeadersTimerFired() {
   FetchReferralHeaders();
 }
@@ -586,15 +551,16 @@ std::string BraveReferralsService::FormatExtraHeaders(
   if (!referral_headers->GetAsList(&referral_headers_list))
     return std::string();
 
-  const base::DictionaryValue* request_headers_dict = nullptr;
-  if (!GetMatchingReferralHeaders(*referral_headers_list, &request_headers_dict,
-                                  url))
+  ReferralHeadersMatcher matcher(*referral_headers_list);
+  const ReferralHeadersMatcher::Headers* request_headers =
+      matcher.GetMatchingHeaders(url);
+  if (!request_headers)
     return std::string();
 
   std::string extra_headers;
-  for (const auto& it : request_headers_dict->DictItems()) {
+  for (const auto& it : *request_headers) {
     extra_headers += base::StringPrintf("%s: %s\r\n", it.first.c_str(),
-                                        it.second.GetString().c_str());
+                                        it.second.c_str());
   }
   if (!extra_headers.empty())
     extra_headers += "\r\n";
@@ -0,0 +1,89 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_referrals/browser/referral_headers_matcher.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/strings/string_util.h"
+#include "base/values.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+ReferralHeadersMatcher::ReferralHeadersMatcher() = default;
+
+ReferralHeadersMatcher::ReferralHeadersMatcher(
+    const base::ListValue& referral_headers_list) {
+  // Domain index for each entry of |domains_|, recorded so that |domain_map_|
+  // is only built once |domains_| won't reallocate anymore.
+  std::vector<size_t> domain_headers_index;
+  for (const auto& headers_value : referral_headers_list) {
+    const base::Value* domains_list =
+        headers_value.FindKeyOfType("domains", base::Value::Type::LIST);
+    if (!domains_list) {
+      LOG(WARNING) << "Failed to retrieve 'domains' key from referral headers";
+      continue;
+    }
+    const base::Value* headers_dict =
+        headers_value.FindKeyOfType("headers", base::Value::Type::DICTIONARY);
+    if (!headers_dict) {
+      LOG(WARNING) << "Failed to retrieve 'headers' key from referral headers";
+      continue;
+    }
+
+    Headers headers;
+    for (const auto& it : headers_dict->DictItems()) {
+      if (!it.second.is_string())
+        continue;
+      headers.emplace_back(it.first, it.second.GetString());
+    }
+    headers_.push_back(std::move(headers));
+
+    for (const auto& domain_value : domains_list->GetList()) {
+      if (!domain_value.is_string() || domain_value.GetString().empty())
+        continue;
+      domains_.push_back(base::ToLowerASCII(domain_value.GetString()));
+      domain_headers_index.push_back(headers_.size() - 1);
+    }
+  }
+
+  domain_map_.reserve(domains_.size());
+  for (size_t i = 0; i < domains_.size(); ++i) {
+    // emplace() keeps the existing value, so a domain listed by several
+    // entries resolves to the first of them.
+    domain_map_.emplace(domains_[i], domain_headers_index[i]);
+  }
+}
+
+ReferralHeadersMatcher::~ReferralHeadersMatcher() = default;
+
+const ReferralHeadersMatcher::Headers*
+ReferralHeadersMatcher::GetMatchingHeaders(const GURL& url) const {
+  if (domain_map_.empty() || !url.SchemeIsHTTPOrHTTPS())
+    return nullptr;
+
+  base::StringPiece host = url.host_piece();
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+
+  // Entries listed earlier win, even when a later entry lists a more
+  // specific domain, so keep looking after the first match.
+  size_t match = headers_.size();
+  while (!host.empty()) {
+    auto it = domain_map_.find(host);
+    if (it != domain_map_.end())
+      match = std::min(match, it->second);
+    size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+
+  return match < headers_.size() ? &headers_[match] : nullptr;
+}
+
+}  // namespace brave
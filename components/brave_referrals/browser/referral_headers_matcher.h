@@ -0,0 +1,60 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+class GURL;
+
+namespace base {
+class ListValue;
+}
+
+namespace brave {
+
+// Compiled form of the referral headers list stored in kReferralHeaders.
+// It is built once whenever the pref changes, and maps every listed domain
+// to the header set of the first list entry containing it. Matching a URL is
+// a walk over the dot-separated suffixes of its host with one hash lookup per
+// suffix, so it does not allocate and can run for every request on the IO
+// thread.
+class ReferralHeadersMatcher {
+ public:
+  using Headers = std::vector<std::pair<std::string, std::string>>;
+
+  ReferralHeadersMatcher();
+  explicit ReferralHeadersMatcher(const base::ListValue& referral_headers_list);
+  ~ReferralHeadersMatcher();
+
+  // Returns the headers for the first referral headers entry with a domain
+  // equal to |url|'s host or one of its parent domains, or nullptr if
+  // there is none. Only http and https URLs can match.
+  const Headers* GetMatchingHeaders(const GURL& url) const;
+
+  bool empty() const { return domain_map_.empty(); }
+
+ private:
+  // Owns the strings that the keys of |domain_map_| point into. It is filled
+  // completely before |domain_map_| is built and is never modified after.
+  std::vector<std::string> domains_;
+  std::vector<Headers> headers_;
+  // Maps a domain to the index of its entry in |headers_|.
+  std::unordered_map<base::StringPiece, size_t, base::StringPieceHash>
+      domain_map_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReferralHeadersMatcher);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REFERRALS_BROWSER_REFERRAL_HEADERS_MATCHER_H_
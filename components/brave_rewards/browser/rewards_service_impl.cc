@@ -53,6 +53,7 @@
 #include "brave/components/brave_rewards/browser/switches.h"
 #include "brave/components/brave_rewards/browser/wallet_properties.h"
 #include "brave/components/services/bat_ledger/public/cpp/ledger_client_mojo_proxy.h"
+#include "brave/components/services/bat_ledger/public/cpp/ledger_state_file_util.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service_factory.h"
 #include "chrome/browser/browser_process_impl.h"
 #include "chrome/browser/favicon/favicon_service_factory.h"
@@ -186,17 +187,12 @@ std::string URLMethodToRequestType(ledger::URL_METHOD method) {
   }
 }
 
-std::string LoadStateOnFileTaskRunner(
-    const base::FilePath& path) {
-  std::string data;
-  bool success = base::ReadFileToString(path, &data);
-
-  // Make sure the file isn't empty.
-  if (!success || data.empty()) {
-    LOG(ERROR) << "Failed to read file: " << path.MaybeAsASCII();
-    return std::string();
-  }
-  return data;
+std::pair<base::FilePath, base::File>
+CreateTemporaryStateFileOnFileTaskRunner(const base::FilePath& path) {
+  base::FilePath temporary_path;
+  base::File file =
+      bat_ledger::CreateTemporaryLedgerStateFile(path, &temporary_path);
+  return std::make_pair(temporary_path, std::move(file));
 }
 
 bool SaveMediaPublisherInfoOnFileTaskRunner(
@@ -396,7 +392,8 @@ const base::FilePath::StringType kRewardsStatePath("rewards_service");
 
 RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
     : profile_(profile),
-      bat_ledger_client_binding_(new bat_ledger::LedgerClientMojoProxy(this)),
+      bat_ledger_client_binding_(
+          new bat_ledger::LedgerClientMojoProxy(this, this)),
 #if BUILDFLAG(ENABLE_EXTENSIONS)
       extension_rewards_service_observer_(
           std::make_unique<ExtensionRewardsServiceObserver>(profile_)),
@@ -416,7 +413,8 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
       private_observer_(
           std::make_unique<ExtensionRewardsServiceObserver>(profile_)),
 #endif
-      next_timer_id_(0) {
+      next_timer_id_(0),
+      next_temporary_state_file_token_(0) {
   file_task_runner_->PostTask(
       FROM_HERE, base::BindOnce(&EnsureRewardsBaseDirectoryExists,
                                 rewards_base_path_));
@@ -426,6 +424,11 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
 }
 
 RewardsServiceImpl::~RewardsServiceImpl() {
+  for (const auto& temporary_state_file : temporary_state_files_) {
+    file_task_runner_->PostTask(FROM_HERE,
+        base::BindOnce(base::IgnoreResult(&base::DeleteFile),
+                       temporary_state_file.second.first, false));
+  }
   file_task_runner_->DeleteSoon(FROM_HERE, publisher_info_backend_.release());
   StopNotificationTimers();
 }
@@ -977,105 +980,105 @@ void RewardsServiceImpl::OnReconcileComplete(ledger::Result result,
                                  probi);
 }
 
-void RewardsServiceImpl::LoadLedgerState(
-    ledger::OnLoadCallback callback) {
-  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::BindOnce(&LoadStateOnFileTaskRunner, ledger_state_path_),
-      base::BindOnce(&RewardsServiceImpl::OnLedgerStateLoaded,
-                     AsWeakPtr(),
-                     std::move(callback)));
-}
-
-void RewardsServiceImpl::OnLedgerStateLoaded(
-    ledger::OnLoadCallback callback,
-    const std::string& data) {
-  if (!Connected())
-    return;
-
-  callback(data.empty() ? ledger::Result::NO_LEDGER_STATE
-                        : ledger::Result::LEDGER_OK,
-                        data);
+const base::FilePath& RewardsServiceImpl::GetStateFilePath(
+    bat_ledger::mojom::LedgerStateFile state_file) const {
+  switch (state_file) {
+    case bat_ledger::mojom::LedgerStateFile::LEDGER_STATE:
+      return ledger_state_path_;
+    case bat_ledger::mojom::LedgerStateFile::PUBLISHER_STATE:
+      return publisher_state_path_;
+    case bat_ledger::mojom::LedgerStateFile::PUBLISHER_LIST:
+      return publisher_list_path_;
+  }
 
-  bat_ledger_->GetRewardsMainEnabled(
-      base::BindOnce(&RewardsServiceImpl::StartNotificationTimers,
-        AsWeakPtr()));
+  NOTREACHED();
+  return ledger_state_path_;
 }
 
-void RewardsServiceImpl::LoadPublisherState(
-    ledger::OnLoadCallback callback) {
-  if (!profile_->GetPrefs()->GetBoolean(prefs::kBraveRewardsEnabledMigrated)) {
+void RewardsServiceImpl::OpenStateFile(
+    bat_ledger::mojom::LedgerStateFile state_file,
+    bat_ledger::mojom::BatLedgerClient::OpenStateFileCallback callback) {
+  if (state_file == bat_ledger::mojom::LedgerStateFile::PUBLISHER_STATE &&
+      !profile_->GetPrefs()->GetBoolean(prefs::kBraveRewardsEnabledMigrated)) {
     bat_ledger_->GetRewardsMainEnabled(
         base::BindOnce(&RewardsServiceImpl::SetRewardsMainEnabledPref,
           AsWeakPtr()));
   }
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::BindOnce(&LoadStateOnFileTaskRunner, publisher_state_path_),
-      base::BindOnce(&RewardsServiceImpl::OnPublisherStateLoaded,
+      base::BindOnce(&bat_ledger::OpenLedgerStateFile,
+                     GetStateFilePath(state_file)),
+      base::BindOnce(&RewardsServiceImpl::OnOpenStateFile,
                      AsWeakPtr(),
+                     state_file,
                      std::move(callback)));
 }
 
-void RewardsServiceImpl::OnPublisherStateLoaded(
-    ledger::OnLoadCallback callback,
-    const std::string& data) {
+void RewardsServiceImpl::OnOpenStateFile(
+    bat_ledger::mojom::LedgerStateFile state_file,
+    bat_ledger::mojom::BatLedgerClient::OpenStateFileCallback callback,
+    base::File file) {
   if (!Connected())
     return;
 
-  callback(
-      data.empty() ? ledger::Result::NO_PUBLISHER_STATE
-                   : ledger::Result::LEDGER_OK,
-      data);
-}
-
-void RewardsServiceImpl::SaveLedgerState(const std::string& ledger_state,
-                                      ledger::LedgerCallbackHandler* handler) {
-  base::ImportantFileWriter writer(
-      ledger_state_path_, file_task_runner_);
-
-  writer.RegisterOnNextWriteCallbacks(
-      base::Closure(),
-      base::Bind(
-        &PostWriteCallback,
-        base::Bind(&RewardsServiceImpl::OnLedgerStateSaved, AsWeakPtr(),
-            base::Unretained(handler)),
-        base::SequencedTaskRunnerHandle::Get()));
+  std::move(callback).Run(std::move(file));
 
-  writer.WriteNow(std::make_unique<std::string>(ledger_state));
+  if (state_file == bat_ledger::mojom::LedgerStateFile::LEDGER_STATE) {
+    bat_ledger_->GetRewardsMainEnabled(
+        base::BindOnce(&RewardsServiceImpl::StartNotificationTimers,
+          AsWeakPtr()));
+  }
 }
 
-void RewardsServiceImpl::OnLedgerStateSaved(
-    ledger::LedgerCallbackHandler* handler,
-    bool success) {
-  if (!Connected())
-    return;
-
-  handler->OnLedgerStateSaved(success ? ledger::Result::LEDGER_OK
-                                      : ledger::Result::NO_LEDGER_STATE);
+void RewardsServiceImpl::CreateTemporaryStateFile(
+    bat_ledger::mojom::LedgerStateFile state_file,
+    bat_ledger::mojom::BatLedgerClient::CreateTemporaryStateFileCallback
+        callback) {
+  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&CreateTemporaryStateFileOnFileTaskRunner,
+                     GetStateFilePath(state_file)),
+      base::BindOnce(&RewardsServiceImpl::OnCreateTemporaryStateFile,
+                     AsWeakPtr(),
+                     state_file,
+                     std::move(callback)));
 }
 
-void RewardsServiceImpl::SavePublisherState(const std::string& publisher_state,
-                                      ledger::LedgerCallbackHandler* handler) {
-  base::ImportantFileWriter writer(publisher_state_path_, file_task_runner_);
-
-  writer.RegisterOnNextWriteCallbacks(
-      base::Closure(),
-      base::Bind(
-        &PostWriteCallback,
-        base::Bind(&RewardsServiceImpl::OnPublisherStateSaved, AsWeakPtr(),
-            base::Unretained(handler)),
-        base::SequencedTaskRunnerHandle::Get()));
+void RewardsServiceImpl::OnCreateTemporaryStateFile(
+    bat_ledger::mojom::LedgerStateFile state_file,
+    bat_ledger::mojom::BatLedgerClient::CreateTemporaryStateFileCallback
+        callback,
+    std::pair<base::FilePath, base::File> temporary_file) {
+  if (!temporary_file.second.IsValid()) {
+    std::move(callback).Run(base::File(), 0);
+    return;
+  }
 
-  writer.WriteNow(std::make_unique<std::string>(publisher_state));
+  // bat_ledger can only name the file it wrote by its token, never by path
+  const uint64_t token = ++next_temporary_state_file_token_;
+  temporary_state_files_[token] =
+      std::make_pair(temporary_file.first, GetStateFilePath(state_file));
+  std::move(callback).Run(std::move(temporary_file.second), token);
 }
 
-void RewardsServiceImpl::OnPublisherStateSaved(
-    ledger::LedgerCallbackHandler* handler,
-    bool success) {
-  if (!Connected())
+void RewardsServiceImpl::FinishTemporaryStateFile(
+    uint64_t token,
+    bool replace_state_file,
+    bat_ledger::mojom::BatLedgerClient::FinishTemporaryStateFileCallback
+        callback) {
+  auto it = temporary_state_files_.find(token);
+  if (it == temporary_state_files_.end()) {
+    std::move(callback).Run(false);
     return;
+  }
 
-  handler->OnPublisherStateSaved(success ? ledger::Result::LEDGER_OK
-                                         : ledger::Result::LEDGER_ERROR);
+  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&bat_ledger::ReplaceLedgerStateFile,
+                     it->second.first,
+                     it->second.second,
+                     replace_state_file),
+      std::move(callback));
+
+  temporary_state_files_.erase(it);
 }
 
 void RewardsServiceImpl::LoadNicewareList(
@@ -1841,33 +1844,6 @@ void RewardsServiceImpl::TriggerOnRewardsMainEnabled(
     observer.OnRewardsMainEnabled(this, rewards_main_enabled);
 }
 
-void RewardsServiceImpl::SavePublishersList(const std::string& publishers_list,
-                                      ledger::LedgerCallbackHandler* handler) {
-  base::ImportantFileWriter writer(
-      publisher_list_path_, file_task_runner_);
-
-  writer.RegisterOnNextWriteCallbacks(
-      base::Closure(),
-      base::Bind(
-        &PostWriteCallback,
-        base::Bind(&RewardsServiceImpl::OnPublishersListSaved, AsWeakPtr(),
-            base::Unretained(handler)),
-        base::SequencedTaskRunnerHandle::Get()));
-
-  writer.WriteNow(std::make_unique<std::string>(publishers_list));
-}
-
-void RewardsServiceImpl::OnPublishersListSaved(
-    ledger::LedgerCallbackHandler* handler,
-    bool success) {
-  if (!Connected()) {
-    return;
-  }
-
-  handler->OnPublishersListSaved(success ? ledger::Result::LEDGER_OK
-                                         : ledger::Result::LEDGER_ERROR);
-}
-
 void RewardsServiceImpl::SetTimer(uint64_t time_offset,
                                   uint32_t* timer_id) {
   if (next_timer_id_ == std::numeric_limits<uint32_t>::max())
@@ -1893,27 +1869,6 @@ void RewardsServiceImpl::OnTimer(uint32_t timer_id) {
   bat_ledger_->OnTimer(timer_id);
 }
 
-void RewardsServiceImpl::LoadPublisherList(
-    ledger::LedgerCallbackHandler* handler) {
-  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&LoadStateOnFileTaskRunner, publisher_list_path_),
-      base::Bind(&RewardsServiceImpl::OnPublisherListLoaded,
-          AsWeakPtr(), base::Unretained(handler)));
-}
-
-void RewardsServiceImpl::OnPublisherListLoaded(
-    ledger::LedgerCallbackHandler* handler,
-    const std::string& data) {
-  if (!Connected()) {
-    return;
-  }
-
-  handler->OnPublisherListLoaded(
-      data.empty() ? ledger::Result::NO_PUBLISHER_LIST
-                   : ledger::Result::LEDGER_OK,
-      data);
-}
-
 void RewardsServiceImpl::OnGetAllBalanceReports(
     const GetAllBalanceReportsCallback& callback,
     const base::flat_map<std::string, ledger::BalanceReportInfoPtr> reports) {
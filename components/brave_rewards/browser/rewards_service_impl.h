@@ -16,11 +16,13 @@
 #include "base/containers/flat_set.h"
 #include "bat/ledger/ledger.h"
 #include "bat/ledger/wallet_properties.h"
+#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/observer_list.h"
 #include "base/one_shot_event.h"
 #include "base/memory/weak_ptr.h"
 #include "bat/ledger/ledger_client.h"
+#include "brave/components/services/bat_ledger/public/cpp/ledger_client_mojo_proxy.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service.h"
@@ -86,6 +88,7 @@ using ExternalWalletAuthorizationCallback =
 
 class RewardsServiceImpl : public RewardsService,
                            public ledger::LedgerClient,
+                           bat_ledger::LedgerClientMojoProxy::StateFileDelegate,
                            public base::SupportsWeakPtr<RewardsServiceImpl> {
  public:
   explicit RewardsServiceImpl(Profile* profile);
@@ -290,15 +293,7 @@ class RewardsServiceImpl : public RewardsService,
   FRIEND_TEST_ALL_PREFIXES(RewardsServiceTest, OnWalletProperties);
 
   const base::OneShotEvent& ready() const { return ready_; }
-  void OnLedgerStateSaved(ledger::LedgerCallbackHandler* handler,
-                          bool success);
-  void OnLedgerStateLoaded(ledger::OnLoadCallback callback,
-                              const std::string& data);
   void LoadNicewareList(ledger::GetNicewareListCallback callback) override;
-  void OnPublisherStateSaved(ledger::LedgerCallbackHandler* handler,
-                             bool success);
-  void OnPublisherStateLoaded(ledger::OnLoadCallback callback,
-                              const std::string& data);
   void TriggerOnWalletInitialized(const ledger::Result result);
   void OnFetchWalletProperties(const ledger::Result result,
                                ledger::WalletPropertiesPtr properties);
@@ -331,11 +326,7 @@ class RewardsServiceImpl : public RewardsService,
                                  uint32_t limit,
                                  ledger::PublisherInfoListCallback callback,
                                  ledger::PublisherInfoList list);
-  void OnPublishersListSaved(ledger::LedgerCallbackHandler* handler,
-                             bool success);
   void OnTimer(uint32_t timer_id);
-  void OnPublisherListLoaded(ledger::LedgerCallbackHandler* handler,
-                             const std::string& data);
   void OnSavedState(ledger::OnSaveCallback callback, bool success);
   void OnLoadedState(ledger::OnLoadCallback callback,
                                   const std::string& value);
@@ -483,12 +474,6 @@ class RewardsServiceImpl : public RewardsService,
                            const std::string& probi) override;
   void OnGrantFinish(ledger::Result result,
                      ledger::GrantPtr grant) override;
-  void LoadLedgerState(ledger::OnLoadCallback callback) override;
-  void LoadPublisherState(ledger::OnLoadCallback callback) override;
-  void SaveLedgerState(const std::string& ledger_state,
-                       ledger::LedgerCallbackHandler* handler) override;
-  void SavePublisherState(const std::string& publisher_state,
-                          ledger::LedgerCallbackHandler* handler) override;
   void SavePublisherInfo(ledger::PublisherInfoPtr publisher_info,
                          ledger::PublisherInfoCallback callback) override;
   void SaveActivityInfo(ledger::PublisherInfoPtr publisher_info,
@@ -502,10 +487,33 @@ class RewardsServiceImpl : public RewardsService,
       uint32_t limit,
       ledger::ActivityInfoFilterPtr filter,
       ledger::PublisherInfoListCallback callback) override;
-  void SavePublishersList(const std::string& publishers_list,
-                          ledger::LedgerCallbackHandler* handler) override;
   void SetTimer(uint64_t time_offset, uint32_t* timer_id) override;
-  void LoadPublisherList(ledger::LedgerCallbackHandler* handler) override;
+
+  // bat_ledger::LedgerClientMojoProxy::StateFileDelegate implementation
+  void OpenStateFile(
+      bat_ledger::mojom::LedgerStateFile state_file,
+      bat_ledger::mojom::BatLedgerClient::OpenStateFileCallback callback)
+      override;
+  void CreateTemporaryStateFile(
+      bat_ledger::mojom::LedgerStateFile state_file,
+      bat_ledger::mojom::BatLedgerClient::CreateTemporaryStateFileCallback
+          callback) override;
+  void FinishTemporaryStateFile(
+      uint64_t token,
+      bool replace_state_file,
+      bat_ledger::mojom::BatLedgerClient::FinishTemporaryStateFileCallback
+          callback) override;
+  void OnOpenStateFile(
+      bat_ledger::mojom::LedgerStateFile state_file,
+      bat_ledger::mojom::BatLedgerClient::OpenStateFileCallback callback,
+      base::File file);
+  void OnCreateTemporaryStateFile(
+      bat_ledger::mojom::LedgerStateFile state_file,
+      bat_ledger::mojom::BatLedgerClient::CreateTemporaryStateFileCallback
+          callback,
+      std::pair<base::FilePath, base::File> temporary_file);
+  const base::FilePath& GetStateFilePath(
+      bat_ledger::mojom::LedgerStateFile state_file) const;
   void LoadURL(const std::string& url,
       const std::vector<std::string>& headers,
       const std::string& content,
@@ -693,6 +701,12 @@ class RewardsServiceImpl : public RewardsService,
 
   uint32_t next_timer_id_;
 
+  // Temporary files bat_ledger is writing, by token, with the state file
+  // each one replaces.
+  std::map<uint64_t, std::pair<base::FilePath, base::FilePath>>
+      temporary_state_files_;
+  uint64_t next_temporary_state_file_token_;
+
   GetTestResponseCallback test_response_callback_;
 
   DISALLOW_COPY_AND_ASSIGN(RewardsServiceImpl);
@@ -6,6 +6,7 @@
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -19,6 +20,7 @@
 #include "brave/browser/net/url_context.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
 #include "components/prefs/pref_service.h"
@@ -28,6 +30,7 @@
 #include "url/origin.h"
 
 using brave_component_updater::BraveComponent;
+using brave_component_updater::ComponentLoadScheduler;
 using content::BrowserThread;
 using namespace net::registry_controlled_domains;  // NOLINT
 
@@ -99,6 +102,20 @@ std::string ResourceTypeToString(content::ResourceType resource_type) {
   return filter_option;
 }
 
+// Loads the engine and prewarms it while still off the IO thread.
+brave_component_updater::LoadDATFileDataResult<adblock::Engine>
+LoadAndPrewarmAdBlockClient(const base::FilePath& dat_file_path) {
+  auto result =
+      brave_component_updater::LoadDATFileData<adblock::Engine>(dat_file_path);
+  if (result.first)
+    brave_shields::PrewarmAdBlockClient(result.first.get());
+  return result;
+}
+
+// Enough for the tabs, and the frames in them, that are loading at a time.
+const size_t kDecisionCacheMaxTabHosts = 16;
+const size_t kDecisionCacheMaxRequestsPerTabHost = 256;
+
 }  // namespace
 
 namespace brave_shields {
@@ -106,6 +123,8 @@ namespace brave_shields {
 AdBlockBaseService::AdBlockBaseService(BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
       ad_block_client_(new adblock::Engine()),
+      decision_cache_(kDecisionCacheMaxTabHosts,
+                      kDecisionCacheMaxRequestsPerTabHost),
       weak_factory_(this),
       weak_factory_io_thread_(this) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
@@ -125,21 +144,30 @@ bool AdBlockBaseService::ShouldStartRequest(const GURL& url,
     bool* did_match_exception, bool* cancel_request_explicitly) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
 
-  // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(url,
-      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
-      INCLUDE_PRIVATE_REGISTRIES);
-  bool explicit_cancel;
-  bool saved_from_exception;
-  // TODO(bbondy): Use redirect if it is provided.
-  std::string redirect;
-  if (ad_block_client_->matches(url.spec(), url.host(),
-        tab_host, is_third_party, ResourceTypeToString(resource_type),
-        &explicit_cancel, &saved_from_exception, &redirect)) {
+  AdBlockDecisionCache::Decision decision;
+  if (!decision_cache_.Get(tab_host, url, resource_type, &decision)) {
+    // Determine third-party here so the library doesn't need to figure it
+    // out. CreateFromNormalizedTuple is needed because SameDomainOrHost
+    // needs a URL or origin and not a string to a host name.
+    bool is_third_party = !SameDomainOrHost(url,
+        url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
+        INCLUDE_PRIVATE_REGISTRIES);
+    bool explicit_cancel = false;
+    bool saved_from_exception = false;
+    // TODO(bbondy): Use redirect if it is provided.
+    std::string redirect;
+    decision.should_start_request = !ad_block_client_->matches(url.spec(),
+        url.host(), tab_host, is_third_party,
+        ResourceTypeToString(resource_type), &explicit_cancel,
+        &saved_from_exception, &redirect);
+    decision.did_match_exception = saved_from_exception;
+    decision.cancel_request_explicitly = explicit_cancel;
+    decision_cache_.Put(tab_host, url, resource_type, decision);
+  }
+
+  if (!decision.should_start_request) {
     if (cancel_request_explicitly) {
-      *cancel_request_explicitly = explicit_cancel;
+      *cancel_request_explicitly = decision.cancel_request_explicitly;
     }
     // We'd only possibly match an exception filter if we're returning true.
     if (did_match_exception) {
@@ -153,7 +181,7 @@ bool AdBlockBaseService::ShouldStartRequest(const GURL& url,
   }
 
   if (did_match_exception) {
-    *did_match_exception = saved_from_exception;
+    *did_match_exception = decision.did_match_exception;
   }
 
   return true;
@@ -171,6 +199,7 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
 void AdBlockBaseService::EnableTagOnIOThread(
     const std::string& tag, bool enabled) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  decision_cache_.Clear();
   if (enabled) {
     ad_block_client_->addTag(tag);
     tags_.push_back(tag);
@@ -188,14 +217,15 @@ bool AdBlockBaseService::TagExists(const std::string& tag) {
   return std::find(tags_.begin(), tags_.end(), tag) != tags_.end();
 }
 
-void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
-  base::PostTaskWithTraitsAndReplyWithResult(
-      FROM_HERE, {base::MayBlock()},
-      base::BindOnce(
-          &brave_component_updater::LoadDATFileData<adblock::Engine>,
-          dat_file_path),
-      base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
-                     weak_factory_.GetWeakPtr()));
+void AdBlockBaseService::GetDATFileData(
+    const base::FilePath& dat_file_path,
+    ComponentLoadScheduler::Priority priority) {
+  ComponentLoadScheduler::GetInstance()
+      ->ScheduleLoadWithResult<GetDATFileDataResult>(
+          component_name(), priority,
+          base::BindOnce(&LoadAndPrewarmAdBlockClient, dat_file_path),
+          base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
+                         weak_factory_.GetWeakPtr()));
 }
 
 void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
@@ -208,12 +238,18 @@ void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
     return;
   }
 
+  SetAdBlockClient(std::move(result.first), std::move(result.second));
+}
+
+void AdBlockBaseService::SetAdBlockClient(
+    std::unique_ptr<adblock::Engine> ad_block_client,
+    brave_component_updater::DATFileDataBuffer buffer) {
   base::PostTaskWithTraits(
       FROM_HERE, {BrowserThread::IO},
       base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
                      weak_factory_io_thread_.GetWeakPtr(),
-                     std::move(result.first),
-                     std::move(result.second)));
+                     std::move(ad_block_client),
+                     std::move(buffer)));
 }
 
 void AdBlockBaseService::UpdateAdBlockClient(
@@ -222,9 +258,13 @@ void AdBlockBaseService::UpdateAdBlockClient(
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   ad_block_client_ = std::move(ad_block_client);
   buffer_ = std::move(buffer);
+  decision_cache_.Clear();
   AddKnownTagsToAdBlockInstance();
+  OnAdBlockClientUpdated();
 }
 
+void AdBlockBaseService::OnAdBlockClientUpdated() {}
+
 void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
   std::for_each(tags_.begin(), tags_.end(), [&](const std::string tag) {
     ad_block_client_->addTag(tag);
@@ -241,8 +281,10 @@ void AdBlockBaseService::ResetForTest(const std::string& rules) {
   // filter rules to an existing instance. At which point the hack below
   // will dissapear.
   DETACH_FROM_SEQUENCE(sequence_checker_);
-  ad_block_client_.reset(new adblock::Engine(rules));
-  AddKnownTagsToAdBlockInstance();
+  // Swapped in on the IO thread like any other engine, since that's where
+  // the engine and the decision cache are used.
+  SetAdBlockClient(std::make_unique<adblock::Engine>(rules),
+                   brave_component_updater::DATFileDataBuffer());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
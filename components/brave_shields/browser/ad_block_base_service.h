@@ -16,7 +16,9 @@
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "content/public/common/resource_type.h"
 
@@ -45,14 +47,28 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
+  // Only to be used on the IO thread.
+  const AdBlockDecisionCache& decision_cache() const {
+    return decision_cache_;
+  }
+
  protected:
   friend class ::AdBlockServiceTest;
   bool Init() override;
   void Cleanup() override;
 
-  void GetDATFileData(const base::FilePath& dat_file_path);
+  void GetDATFileData(
+      const base::FilePath& dat_file_path,
+      brave_component_updater::ComponentLoadScheduler::Priority priority);
+  // Swaps in |ad_block_client| on the IO thread, which requests are matched
+  // on. |buffer| is the data it was deserialized from, if any.
+  void SetAdBlockClient(std::unique_ptr<adblock::Engine> ad_block_client,
+                        brave_component_updater::DATFileDataBuffer buffer);
   void AddKnownTagsToAdBlockInstance();
+  // Swaps in an engine built from |rules| on the IO thread.
   void ResetForTest(const std::string& rules);
+  // Called on the IO thread after an engine was swapped in.
+  virtual void OnAdBlockClientUpdated();
 
   SEQUENCE_CHECKER(sequence_checker_);
   std::unique_ptr<adblock::Engine> ad_block_client_;
@@ -67,6 +83,7 @@ class AdBlockBaseService : public BaseBraveShieldsService {
 
   brave_component_updater::DATFileDataBuffer buffer_;
   std::vector<std::string> tags_;
+  AdBlockDecisionCache decision_cache_;
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_io_thread_;
   DISALLOW_COPY_AND_ASSIGN(AdBlockBaseService);
@@ -5,20 +5,41 @@
 
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 
+#include <utility>
+
+#include "base/bind.h"
 #include "base/logging.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_thread.h"
 
 using brave_component_updater::BraveComponent;
+using brave_component_updater::ComponentLoadScheduler;
+
+namespace {
+
+const char kCustomFiltersComponentName[] = "Ad block custom filters";
+
+std::unique_ptr<adblock::Engine> BuildAdBlockClient(
+    const std::string& custom_filters) {
+  auto ad_block_client = std::make_unique<adblock::Engine>(custom_filters);
+  brave_shields::PrewarmAdBlockClient(ad_block_client.get());
+  return ad_block_client;
+}
+
+}  // namespace
 
 namespace brave_shields {
 
 AdBlockCustomFiltersService::AdBlockCustomFiltersService(
-    BraveComponent::Delegate* delegate) : AdBlockBaseService(delegate) {
+    BraveComponent::Delegate* delegate)
+    : AdBlockBaseService(delegate),
+      weak_factory_(this) {
 }
 
 AdBlockCustomFiltersService::~AdBlockCustomFiltersService() {
@@ -44,19 +65,35 @@ bool AdBlockCustomFiltersService::UpdateCustomFilters(
     return false;
   local_state->SetString(kAdBlockCustomFilters, custom_filters);
 
-  GetTaskRunner()->PostTask(
-      FROM_HERE,
-      base::BindOnce(
-          &AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner,
-          base::Unretained(this), custom_filters));
+  // Nothing to rebuild at startup for the common case of no custom filters,
+  // or when the filters are saved unchanged.
+  if (custom_filters == custom_filters_)
+    return true;
+  custom_filters_ = custom_filters;
+
+  // The engine is compiled off the IO thread and then swapped in, so that
+  // requests keep being matched against the previous filters meanwhile.
+  ComponentLoadScheduler::GetInstance()
+      ->ScheduleLoadWithResult<std::unique_ptr<adblock::Engine>>(
+          kCustomFiltersComponentName,
+          ComponentLoadScheduler::Priority::kHigh,
+          base::BindOnce(&BuildAdBlockClient, custom_filters),
+          base::BindOnce(&AdBlockCustomFiltersService::OnAdBlockClientBuilt,
+                         weak_factory_.GetWeakPtr(), custom_filters));
 
   return true;
 }
 
-void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner(
-    const std::string& custom_filters) {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  ad_block_client_.reset(new adblock::Engine(custom_filters.c_str()));
+void AdBlockCustomFiltersService::OnAdBlockClientBuilt(
+    const std::string& custom_filters,
+    std::unique_ptr<adblock::Engine> ad_block_client) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // Superseded by a later edit, which has its own engine on the way.
+  if (custom_filters != custom_filters_)
+    return;
+
+  SetAdBlockClient(std::move(ad_block_client),
+                   brave_component_updater::DATFileDataBuffer());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
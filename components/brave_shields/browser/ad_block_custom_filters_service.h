@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 
+#include "base/memory/weak_ptr.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
 class AdBlockServiceTest;
@@ -32,7 +33,13 @@ class AdBlockCustomFiltersService : public AdBlockBaseService {
 
  private:
   friend class ::AdBlockServiceTest;
-  void UpdateCustomFiltersOnFileTaskRunner(const std::string& custom_filters);
+  void OnAdBlockClientBuilt(const std::string& custom_filters,
+                            std::unique_ptr<adblock::Engine> ad_block_client);
+
+  // The filters the engine in use, or being built, was built from. Empty
+  // at first, which is what the initial, empty engine matches.
+  std::string custom_filters_;
+  base::WeakPtrFactory<AdBlockCustomFiltersService> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(AdBlockCustomFiltersService);
 };
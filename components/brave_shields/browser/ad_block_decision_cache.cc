@@ -0,0 +1,72 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include "base/hash/hash.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+size_t AdBlockDecisionCache::RequestKeyHash::operator()(
+    const RequestKey& key) const {
+  return base::HashInts(key.first, key.second);
+}
+
+AdBlockDecisionCache::AdBlockDecisionCache(size_t max_tab_hosts,
+                                           size_t max_requests_per_tab_host)
+    : max_requests_per_tab_host_(max_requests_per_tab_host),
+      tab_hosts_(max_tab_hosts),
+      hit_count_(0),
+      miss_count_(0) {}
+
+AdBlockDecisionCache::~AdBlockDecisionCache() {}
+
+bool AdBlockDecisionCache::Get(const std::string& tab_host,
+                               const GURL& url,
+                               content::ResourceType resource_type,
+                               Decision* decision) {
+  auto tab_host_it = tab_hosts_.Get(tab_host);
+  if (tab_host_it == tab_hosts_.end()) {
+    miss_count_++;
+    return false;
+  }
+
+  RequestDecisions* request_decisions = tab_host_it->second.get();
+  const std::string& url_spec = url.spec();
+  auto it = request_decisions->Get(
+      RequestKey(base::Hash(url_spec), static_cast<int>(resource_type)));
+  if (it == request_decisions->end() || it->second.url_spec != url_spec) {
+    miss_count_++;
+    return false;
+  }
+
+  hit_count_++;
+  *decision = it->second.decision;
+  return true;
+}
+
+void AdBlockDecisionCache::Put(const std::string& tab_host,
+                               const GURL& url,
+                               content::ResourceType resource_type,
+                               const Decision& decision) {
+  auto tab_host_it = tab_hosts_.Get(tab_host);
+  if (tab_host_it == tab_hosts_.end()) {
+    tab_host_it = tab_hosts_.Put(
+        tab_host,
+        std::make_unique<RequestDecisions>(max_requests_per_tab_host_));
+  }
+
+  const std::string& url_spec = url.spec();
+  tab_host_it->second->Put(
+      RequestKey(base::Hash(url_spec), static_cast<int>(resource_type)),
+      Entry{url_spec, decision});
+}
+
+void AdBlockDecisionCache::Clear() {
+  tab_hosts_.Clear();
+}
+
+}  // namespace brave_shields
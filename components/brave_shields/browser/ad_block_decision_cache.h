@@ -0,0 +1,80 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "content/public/common/resource_type.h"
+
+class GURL;
+
+namespace brave_shields {
+
+// Remembers what an ad-block engine decided for the requests recently made
+// from a tab's host, so that a page requesting the same URL over and over
+// (pixels, beacons, polling, retried scripts) is matched only once.
+//
+// Decisions are kept for the most recently used tab hosts, and for the most
+// recently made requests of each, keyed by a hash of the URL and the
+// resource type. The cache has to be cleared whenever the engine or its
+// tags change. Not thread safe, ad-block matching happens on the IO thread.
+class AdBlockDecisionCache {
+ public:
+  struct Decision {
+    bool should_start_request;
+    bool did_match_exception;
+    bool cancel_request_explicitly;
+  };
+
+  AdBlockDecisionCache(size_t max_tab_hosts, size_t max_requests_per_tab_host);
+  ~AdBlockDecisionCache();
+
+  bool Get(const std::string& tab_host,
+           const GURL& url,
+           content::ResourceType resource_type,
+           Decision* decision);
+  void Put(const std::string& tab_host,
+           const GURL& url,
+           content::ResourceType resource_type,
+           const Decision& decision);
+  void Clear();
+
+  uint64_t hit_count() const { return hit_count_; }
+  uint64_t miss_count() const { return miss_count_; }
+
+ private:
+  // (url hash, resource type)
+  using RequestKey = std::pair<size_t, int>;
+  struct RequestKeyHash {
+    size_t operator()(const RequestKey& key) const;
+  };
+  struct Entry {
+    // Guards against hash collisions.
+    std::string url_spec;
+    Decision decision;
+  };
+  using RequestDecisions = base::HashingMRUCache<RequestKey, Entry,
+                                                 RequestKeyHash>;
+
+  const size_t max_requests_per_tab_host_;
+  base::MRUCache<std::string, std::unique_ptr<RequestDecisions>> tab_hosts_;
+  uint64_t hit_count_;
+  uint64_t miss_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockDecisionCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
@@ -0,0 +1,89 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=AdBlockDecisionCacheTest.*
+
+namespace brave_shields {
+
+namespace {
+
+const AdBlockDecisionCache::Decision kBlocked = {false, false, true};
+const AdBlockDecisionCache::Decision kException = {true, true, false};
+
+}  // namespace
+
+TEST(AdBlockDecisionCacheTest, KeyedByTabHostUrlAndResourceType) {
+  AdBlockDecisionCache cache(2, 2);
+  const GURL url("https://tracker.com/pixel.gif");
+  cache.Put("a.com", url, content::ResourceType::kImage, kBlocked);
+
+  AdBlockDecisionCache::Decision decision;
+  ASSERT_TRUE(cache.Get("a.com", url, content::ResourceType::kImage,
+                        &decision));
+  EXPECT_FALSE(decision.should_start_request);
+  EXPECT_FALSE(decision.did_match_exception);
+  EXPECT_TRUE(decision.cancel_request_explicitly);
+
+  EXPECT_FALSE(cache.Get("b.com", url, content::ResourceType::kImage,
+                         &decision));
+  EXPECT_FALSE(cache.Get("a.com", url, content::ResourceType::kScript,
+                         &decision));
+  EXPECT_FALSE(cache.Get("a.com", GURL("https://tracker.com/other.gif"),
+                         content::ResourceType::kImage, &decision));
+
+  cache.Put("a.com", url, content::ResourceType::kScript, kException);
+  ASSERT_TRUE(cache.Get("a.com", url, content::ResourceType::kScript,
+                        &decision));
+  EXPECT_TRUE(decision.should_start_request);
+  EXPECT_TRUE(decision.did_match_exception);
+
+  EXPECT_EQ(2u, cache.hit_count());
+  EXPECT_EQ(3u, cache.miss_count());
+}
+
+TEST(AdBlockDecisionCacheTest, EvictsLeastRecentlyUsed) {
+  AdBlockDecisionCache cache(2, 2);
+  const GURL url1("https://tracker.com/1");
+  const GURL url2("https://tracker.com/2");
+  const GURL url3("https://tracker.com/3");
+  AdBlockDecisionCache::Decision decision;
+
+  // Requests of a tab host.
+  cache.Put("a.com", url1, content::ResourceType::kImage, kBlocked);
+  cache.Put("a.com", url2, content::ResourceType::kImage, kBlocked);
+  ASSERT_TRUE(cache.Get("a.com", url1, content::ResourceType::kImage,
+                        &decision));
+  cache.Put("a.com", url3, content::ResourceType::kImage, kBlocked);
+  EXPECT_TRUE(cache.Get("a.com", url1, content::ResourceType::kImage,
+                        &decision));
+  EXPECT_FALSE(cache.Get("a.com", url2, content::ResourceType::kImage,
+                         &decision));
+
+  // Tab hosts.
+  cache.Put("b.com", url1, content::ResourceType::kImage, kBlocked);
+  cache.Put("c.com", url1, content::ResourceType::kImage, kBlocked);
+  EXPECT_FALSE(cache.Get("a.com", url1, content::ResourceType::kImage,
+                         &decision));
+  EXPECT_TRUE(cache.Get("b.com", url1, content::ResourceType::kImage,
+                        &decision));
+}
+
+TEST(AdBlockDecisionCacheTest, Clear) {
+  AdBlockDecisionCache cache(2, 2);
+  const GURL url("https://tracker.com/pixel.gif");
+  cache.Put("a.com", url, content::ResourceType::kImage, kBlocked);
+  cache.Clear();
+
+  AdBlockDecisionCache::Decision decision;
+  EXPECT_FALSE(cache.Get("a.com", url, content::ResourceType::kImage,
+                         &decision));
+}
+
+}  // namespace brave_shields
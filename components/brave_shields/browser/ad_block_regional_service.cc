@@ -24,6 +24,8 @@
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
 #include "components/prefs/pref_service.h"
 
+using brave_component_updater::ComponentLoadScheduler;
+
 namespace brave_shields {
 
 std::string AdBlockRegionalService::g_ad_block_regional_component_id_;  // NOLINT
@@ -68,7 +70,7 @@ void AdBlockRegionalService::OnComponentReady(
   base::FilePath dat_file_path =
       install_dir.AppendASCII(std::string("rs-") + uuid_)
           .AddExtension(FILE_PATH_LITERAL(".dat"));
-  GetDATFileData(dat_file_path);
+  GetDATFileData(dat_file_path, ComponentLoadScheduler::Priority::kNormal);
 }
 
 // static
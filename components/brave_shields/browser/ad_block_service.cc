@@ -14,25 +14,39 @@
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_macros_local.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/post_task.h"
 #include "base/threading/thread_restrictions.h"
 #include "brave/common/pref_names.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
 #include "components/prefs/pref_registry_simple.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
 
 #define DAT_FILE "rs-ABPFilterParserData.dat"
 
+using brave_component_updater::ComponentLoadScheduler;
+using content::BrowserThread;
+
 namespace brave_shields {
 
 std::string AdBlockService::g_ad_block_component_id_(
     kAdBlockComponentId);
 std::string AdBlockService::g_ad_block_component_base64_public_key_(
     kAdBlockComponentBase64PublicKey);
+// How long requests are held back at most, from the first one that was.
+base::TimeDelta AdBlockService::g_wait_for_ad_block_client_timeout_(
+    base::TimeDelta::FromSeconds(3));
 
 AdBlockService::AdBlockService(
     brave_component_updater::BraveComponent::Delegate* delegate)
-    : AdBlockBaseService(delegate) {
+    : AdBlockBaseService(delegate),
+      is_ad_block_client_ready_(false),
+      wait_for_ad_block_client_timed_out_(false),
+      requests_before_ad_block_client_ready_(0),
+      wait_for_ad_block_client_weak_factory_(this) {
 }
 
 AdBlockService::~AdBlockService() {
@@ -53,7 +67,81 @@ void AdBlockService::OnComponentReady(const std::string& component_id,
                                       const std::string& manifest) {
   base::FilePath dat_file_path =
       install_dir.AppendASCII(DAT_FILE);
-  GetDATFileData(dat_file_path);
+  // Most requests are matched against the default list, so shields aren't
+  // armed until it is loaded.
+  GetDATFileData(dat_file_path, ComponentLoadScheduler::Priority::kHigh);
+}
+
+bool AdBlockService::ShouldStartRequest(const GURL& url,
+                                        content::ResourceType resource_type,
+                                        const std::string& tab_host,
+                                        bool* did_match_exception,
+                                        bool* cancel_request_explicitly) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  if (!is_ad_block_client_ready_)
+    requests_before_ad_block_client_ready_++;
+
+  return AdBlockBaseService::ShouldStartRequest(url, resource_type, tab_host,
+                                                did_match_exception,
+                                                cancel_request_explicitly);
+}
+
+bool AdBlockService::CanWaitForAdBlockClient() const {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  return !is_ad_block_client_ready_ && !wait_for_ad_block_client_timed_out_;
+}
+
+void AdBlockService::WaitForAdBlockClient(base::OnceClosure callback) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  DCHECK(CanWaitForAdBlockClient());
+
+  if (first_wait_time_.is_null()) {
+    first_wait_time_ = base::TimeTicks::Now();
+    base::PostDelayedTaskWithTraits(
+        FROM_HERE, {BrowserThread::IO},
+        base::BindOnce(&AdBlockService::OnWaitForAdBlockClientTimeout,
+                       wait_for_ad_block_client_weak_factory_.GetWeakPtr()),
+        g_wait_for_ad_block_client_timeout_);
+  }
+  ad_block_client_ready_callbacks_.push_back(std::move(callback));
+}
+
+void AdBlockService::OnAdBlockClientUpdated() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  if (is_ad_block_client_ready_)
+    return;
+
+  is_ad_block_client_ready_ = true;
+  // Visible in chrome://histograms.
+  LOCAL_HISTOGRAM_COUNTS_100000("Brave.AdBlock.RequestsBeforeEngineReady",
+                                requests_before_ad_block_client_ready_);
+  if (!first_wait_time_.is_null() && !wait_for_ad_block_client_timed_out_) {
+    LOCAL_HISTOGRAM_BOOLEAN("Brave.AdBlock.WaitForEngineTimedOut", false);
+    LOCAL_HISTOGRAM_TIMES("Brave.AdBlock.WaitForEngineTime",
+                          base::TimeTicks::Now() - first_wait_time_);
+  }
+  RunAdBlockClientReadyCallbacks();
+}
+
+void AdBlockService::OnWaitForAdBlockClientTimeout() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  if (is_ad_block_client_ready_)
+    return;
+
+  // The held back requests are let through against whatever is in use.
+  wait_for_ad_block_client_timed_out_ = true;
+  LOCAL_HISTOGRAM_BOOLEAN("Brave.AdBlock.WaitForEngineTimedOut", true);
+  RunAdBlockClientReadyCallbacks();
+}
+
+void AdBlockService::RunAdBlockClientReadyCallbacks() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  LOCAL_HISTOGRAM_COUNTS_100000("Brave.AdBlock.RequestsWaitedForEngine",
+                                ad_block_client_ready_callbacks_.size());
+  std::vector<base::OnceClosure> callbacks;
+  callbacks.swap(ad_block_client_ready_callbacks_);
+  for (auto& callback : callbacks)
+    std::move(callback).Run();
 }
 
 // static
@@ -64,6 +152,12 @@ void AdBlockService::SetComponentIdAndBase64PublicKeyForTest(
   g_ad_block_component_base64_public_key_ = component_base64_public_key;
 }
 
+// static
+void AdBlockService::SetWaitForAdBlockClientTimeoutForTest(
+    base::TimeDelta timeout) {
+  g_wait_for_ad_block_client_timeout_ = timeout;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 // The Adblock service factory.
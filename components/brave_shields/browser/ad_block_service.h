@@ -12,10 +12,14 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 #include "components/prefs/pref_registry_simple.h"
 
 class AdBlockServiceTest;
+class AdBlockServiceWaitForAdBlockClientTest;
 
 using brave_component_updater::BraveComponent;
 
@@ -38,20 +42,47 @@ class AdBlockService : public AdBlockBaseService {
   explicit AdBlockService(BraveComponent::Delegate* delegate);
   ~AdBlockService() override;
 
+  bool ShouldStartRequest(const GURL& url,
+                          content::ResourceType resource_type,
+                          const std::string& tab_host,
+                          bool* did_match_exception,
+                          bool* cancel_request_explicitly) override;
+
+  // Until the engine built from the default list is in use, requests can be
+  // held back with WaitForAdBlockClient(), which runs |callback| once it is,
+  // or once waiting timed out. Only to be used on the IO thread.
+  bool CanWaitForAdBlockClient() const;
+  void WaitForAdBlockClient(base::OnceClosure callback);
+
  protected:
   bool Init() override;
   void OnComponentReady(const std::string& component_id,
                         const base::FilePath& install_dir,
                         const std::string& manifest) override;
+  void OnAdBlockClientUpdated() override;
 
  private:
   friend class ::AdBlockServiceTest;
+  friend class ::AdBlockServiceWaitForAdBlockClientTest;
+  void OnWaitForAdBlockClientTimeout();
+  void RunAdBlockClientReadyCallbacks();
+
   static std::string g_ad_block_component_id_;
   static std::string g_ad_block_component_base64_public_key_;
   static std::string g_ad_block_dat_file_version_;
+  static base::TimeDelta g_wait_for_ad_block_client_timeout_;
   static void SetComponentIdAndBase64PublicKeyForTest(
       const std::string& component_id,
       const std::string& component_base64_public_key);
+  static void SetWaitForAdBlockClientTimeoutForTest(base::TimeDelta timeout);
+
+  // Accessed on the IO thread.
+  bool is_ad_block_client_ready_;
+  bool wait_for_ad_block_client_timed_out_;
+  uint64_t requests_before_ad_block_client_ready_;
+  base::TimeTicks first_wait_time_;
+  std::vector<base::OnceClosure> ad_block_client_ready_callbacks_;
+  base::WeakPtrFactory<AdBlockService> wait_for_ad_block_client_weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(AdBlockService);
 };
@@ -3,16 +3,21 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include "base/bind.h"
 #include "base/path_service.h"
+#include "base/run_loop.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/blocked_event_batcher.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -73,6 +78,16 @@ class AdBlockServiceTest : public ExtensionBrowserTest {
   void SetUpOnMainThread() override {
     ExtensionBrowserTest::SetUpOnMainThread();
     host_resolver()->AddRule("*", "127.0.0.1");
+    // The tests check the blocked stats as soon as the page saw the block,
+    // so don't batch them.
+    brave_shields::BraveShieldsWebContentsObserver::
+        SetStatsCommitDelayForTesting(base::TimeDelta());
+    base::PostTaskWithTraits(
+        FROM_HERE, {BrowserThread::IO},
+        base::BindOnce(
+            &brave_shields::BlockedEventBatcher::SetFlushDelayForTesting,
+            base::Unretained(brave_shields::BlockedEventBatcher::GetInstance()),
+            base::TimeDelta()));
   }
 
   void SetUp() override {
@@ -89,6 +104,7 @@ class AdBlockServiceTest : public ExtensionBrowserTest {
   void UpdateAdBlockInstanceWithRules(const char* rules) {
     g_brave_browser_process->ad_block_service()
         ->ResetForTest(rules);
+    WaitForAdBlockServiceThreads();
   }
 
   void AssertTagExists(const std::string& tag, bool expected_exists) const {
@@ -212,6 +228,10 @@ class AdBlockServiceTest : public ExtensionBrowserTest {
   }
 
   void WaitForAdBlockServiceThreads() {
+    base::RunLoop run_loop;
+    brave_component_updater::ComponentLoadScheduler::GetInstance()
+        ->RunWhenIdleForTesting(run_loop.QuitClosure());
+    run_loop.Run();
     scoped_refptr<base::ThreadTestHelper> tr_helper(new base::ThreadTestHelper(
         g_brave_browser_process->local_data_files_service()->GetTaskRunner()));
     ASSERT_TRUE(tr_helper->Run());
@@ -250,6 +270,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                        NotAdsDoNotGetBlockedByCustomBlocker) {
   ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
                   ->UpdateCustomFilters("*ad_banner.png"));
+  WaitForAdBlockServiceThreads();
 
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
 
@@ -273,6 +294,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdsGetBlockedByCustomBlocker) {
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
   ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
                   ->UpdateCustomFilters("*ad_banner.png"));
+  WaitForAdBlockServiceThreads();
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
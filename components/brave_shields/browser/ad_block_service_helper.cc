@@ -44,4 +44,13 @@ std::vector<FilterList>::const_iterator FindAdBlockFilterListByLocale(
       });
 }
 
+void PrewarmAdBlockClient(adblock::Engine* ad_block_client) {
+  bool explicit_cancel;
+  bool saved_from_exception;
+  std::string redirect;
+  ad_block_client->matches("https://prewarm.invalid/ad.js", "prewarm.invalid",
+                           "brave.invalid", true, "script", &explicit_cancel,
+                           &saved_from_exception, &redirect);
+}
+
 }  // namespace brave_shields
@@ -20,6 +20,10 @@ std::vector<adblock::FilterList>::const_iterator FindAdBlockFilterListByLocale(
     const std::vector<adblock::FilterList>& region_lists,
     const std::string& locale);
 
+// Runs a match against a synthetic request, so that the engine's lazily
+// built structures are built before it is used for requests.
+void PrewarmAdBlockClient(adblock::Engine* ad_block_client);
+
 }  // namespace brave_shields
 
 #endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_SERVICE_HELPER_H_
@@ -0,0 +1,143 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_service.h"
+
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=AdBlockServiceWaitForAdBlockClientTest.*
+
+using brave_component_updater::BraveComponent;
+
+namespace {
+
+class TestBraveComponentDelegate : public BraveComponent::Delegate {
+ public:
+  TestBraveComponentDelegate() {}
+  ~TestBraveComponentDelegate() override {}
+
+  void Register(const std::string& component_name,
+                const std::string& component_base64_public_key,
+                base::OnceClosure registered_callback,
+                BraveComponent::ReadyCallback ready_callback) override {}
+  bool Unregister(const std::string& component_id) override { return true; }
+  void OnDemandUpdate(const std::string& component_id) override {}
+  scoped_refptr<base::SequencedTaskRunner> GetTaskRunner() override {
+    return base::SequencedTaskRunnerHandle::Get();
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(TestBraveComponentDelegate);
+};
+
+void Increment(int* count) {
+  (*count)++;
+}
+
+}  // namespace
+
+class AdBlockServiceWaitForAdBlockClientTest : public testing::Test {
+ public:
+  AdBlockServiceWaitForAdBlockClientTest() {}
+  ~AdBlockServiceWaitForAdBlockClientTest() override {}
+
+  void SetUp() override {
+    default_wait_for_ad_block_client_timeout_ =
+        brave_shields::AdBlockService::g_wait_for_ad_block_client_timeout_;
+    ad_block_service_ =
+        std::make_unique<brave_shields::AdBlockService>(&delegate_);
+  }
+
+  void TearDown() override {
+    ad_block_service_.reset();
+    SetWaitForAdBlockClientTimeout(default_wait_for_ad_block_client_timeout_);
+    base::RunLoop().RunUntilIdle();
+  }
+
+  void SetWaitForAdBlockClientTimeout(base::TimeDelta timeout) {
+    brave_shields::AdBlockService::SetWaitForAdBlockClientTimeoutForTest(
+        timeout);
+  }
+
+  void SwapInAdBlockClient() {
+    ad_block_service_->ResetForTest("");
+  }
+
+ protected:
+  content::TestBrowserThreadBundle thread_bundle_;
+  TestBraveComponentDelegate delegate_;
+  std::unique_ptr<brave_shields::AdBlockService> ad_block_service_;
+
+ private:
+  base::TimeDelta default_wait_for_ad_block_client_timeout_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockServiceWaitForAdBlockClientTest);
+};
+
+TEST_F(AdBlockServiceWaitForAdBlockClientTest, RunsCallbacksWhenReady) {
+  base::HistogramTester histogram_tester;
+  ASSERT_TRUE(ad_block_service_->CanWaitForAdBlockClient());
+
+  int count = 0;
+  ad_block_service_->WaitForAdBlockClient(base::BindOnce(&Increment, &count));
+  ad_block_service_->WaitForAdBlockClient(base::BindOnce(&Increment, &count));
+  EXPECT_EQ(0, count);
+
+  SwapInAdBlockClient();
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_EQ(2, count);
+  EXPECT_FALSE(ad_block_service_->CanWaitForAdBlockClient());
+  histogram_tester.ExpectUniqueSample("Brave.AdBlock.WaitForEngineTimedOut",
+                                      false, 1);
+  histogram_tester.ExpectUniqueSample("Brave.AdBlock.RequestsWaitedForEngine",
+                                      2, 1);
+  histogram_tester.ExpectTotalCount("Brave.AdBlock.WaitForEngineTime", 1);
+}
+
+TEST_F(AdBlockServiceWaitForAdBlockClientTest, ReadyWithoutWaiting) {
+  base::HistogramTester histogram_tester;
+
+  SwapInAdBlockClient();
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_FALSE(ad_block_service_->CanWaitForAdBlockClient());
+  histogram_tester.ExpectTotalCount("Brave.AdBlock.WaitForEngineTimedOut", 0);
+  histogram_tester.ExpectTotalCount("Brave.AdBlock.WaitForEngineTime", 0);
+}
+
+TEST_F(AdBlockServiceWaitForAdBlockClientTest, RunsCallbacksOnTimeout) {
+  base::HistogramTester histogram_tester;
+  SetWaitForAdBlockClientTimeout(base::TimeDelta::FromMilliseconds(10));
+
+  int count = 0;
+  base::RunLoop run_loop;
+  ad_block_service_->WaitForAdBlockClient(base::BindOnce(&Increment, &count));
+  ad_block_service_->WaitForAdBlockClient(run_loop.QuitClosure());
+  run_loop.Run();
+
+  EXPECT_EQ(1, count);
+  // Later requests are let through rather than held back again.
+  EXPECT_FALSE(ad_block_service_->CanWaitForAdBlockClient());
+  histogram_tester.ExpectUniqueSample("Brave.AdBlock.WaitForEngineTimedOut",
+                                      true, 1);
+
+  // The engine showing up later doesn't run the callbacks again.
+  SwapInAdBlockClient();
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_EQ(1, count);
+  histogram_tester.ExpectUniqueSample("Brave.AdBlock.WaitForEngineTimedOut",
+                                      true, 1);
+  histogram_tester.ExpectTotalCount("Brave.AdBlock.WaitForEngineTime", 0);
+}
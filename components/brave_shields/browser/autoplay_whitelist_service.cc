@@ -8,12 +8,12 @@
 #include <utility>
 
 #include "base/bind.h"
-#include "base/task/post_task.h"
-#include "base/task_runner_util.h"
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 #include "brave/vendor/autoplay-whitelist/autoplay_whitelist_parser.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 
+using brave_component_updater::ComponentLoadScheduler;
 using brave_component_updater::LocalDataFilesObserver;
 using brave_component_updater::LocalDataFilesService;
 
@@ -49,14 +49,14 @@ void AutoplayWhitelistService::OnComponentReady(
       .AppendASCII(AUTOPLAY_DAT_FILE_VERSION)
       .AppendASCII(AUTOPLAY_DAT_FILE);
 
-  base::PostTaskAndReplyWithResult(
-      local_data_files_service()->GetTaskRunner().get(),
-      FROM_HERE,
-      base::BindOnce(
-          &brave_component_updater::LoadDATFileData<AutoplayWhitelistParser>,
-          dat_file_path),
-      base::BindOnce(&AutoplayWhitelistService::OnGetDATFileData,
-                     weak_factory_.GetWeakPtr()));
+  ComponentLoadScheduler::GetInstance()
+      ->ScheduleLoadWithResult<GetDATFileDataResult>(
+          "Autoplay whitelist", ComponentLoadScheduler::Priority::kNormal,
+          base::BindOnce(&brave_component_updater::LoadDATFileData<
+                             AutoplayWhitelistParser>,
+                         dat_file_path),
+          base::BindOnce(&AutoplayWhitelistService::OnGetDATFileData,
+                         weak_factory_.GetWeakPtr()));
 }
 
 void AutoplayWhitelistService::OnGetDATFileData(GetDATFileDataResult result) {
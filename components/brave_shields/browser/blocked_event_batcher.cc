@@ -0,0 +1,92 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/blocked_event_batcher.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/task/post_task.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+
+using content::BrowserThread;
+
+namespace brave_shields {
+
+namespace {
+
+// Roughly one animation frame, so the shields panel still updates smoothly.
+constexpr base::TimeDelta kFlushDelay = base::TimeDelta::FromMilliseconds(16);
+
+}  // namespace
+
+BlockedEvent::BlockedEvent(const std::string& block_type,
+                           const std::string& subresource)
+    : block_type(block_type), subresource(subresource) {}
+
+BlockedEvent::BlockedEvent(const BlockedEvent& other) = default;
+
+BlockedEvent::BlockedEvent(BlockedEvent&& other) = default;
+
+BlockedEvent& BlockedEvent::operator=(BlockedEvent&& other) = default;
+
+BlockedEvent::~BlockedEvent() = default;
+
+// static
+BlockedEventBatcher* BlockedEventBatcher::GetInstance() {
+  static base::NoDestructor<BlockedEventBatcher> instance;
+  return instance.get();
+}
+
+BlockedEventBatcher::BlockedEventBatcher() : flush_delay_(kFlushDelay) {}
+
+BlockedEventBatcher::~BlockedEventBatcher() = default;
+
+void BlockedEventBatcher::Add(int render_process_id,
+                              int render_frame_id,
+                              int frame_tree_node_id,
+                              const std::string& block_type,
+                              const std::string& subresource) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  pending_events_[FrameKey(render_process_id, render_frame_id,
+                           frame_tree_node_id)]
+      .emplace_back(block_type, subresource);
+
+  if (flush_delay_.is_zero()) {
+    Flush();
+    return;
+  }
+  if (flush_scheduled_)
+    return;
+  flush_scheduled_ = true;
+  base::PostDelayedTaskWithTraits(
+      FROM_HERE, {BrowserThread::IO},
+      base::BindOnce(&BlockedEventBatcher::Flush, base::Unretained(this)),
+      flush_delay_);
+}
+
+void BlockedEventBatcher::SetFlushDelayForTesting(base::TimeDelta flush_delay) {
+  flush_delay_ = flush_delay;
+}
+
+void BlockedEventBatcher::Flush() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  flush_scheduled_ = false;
+  for (auto& frame_events : pending_events_) {
+    int render_process_id, render_frame_id, frame_tree_node_id;
+    std::tie(render_process_id, render_frame_id, frame_tree_node_id) =
+        frame_events.first;
+    base::PostTaskWithTraits(
+        FROM_HERE, {BrowserThread::UI},
+        base::BindOnce(&BraveShieldsWebContentsObserver::DispatchBlockedEvents,
+                       std::move(frame_events.second), render_process_id,
+                       render_frame_id, frame_tree_node_id));
+  }
+  pending_events_.clear();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,68 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOCKED_EVENT_BATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOCKED_EVENT_BATCHER_H_
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "base/time/time.h"
+
+namespace brave_shields {
+
+struct BlockedEvent {
+  BlockedEvent(const std::string& block_type, const std::string& subresource);
+  BlockedEvent(const BlockedEvent& other);
+  BlockedEvent(BlockedEvent&& other);
+  BlockedEvent& operator=(BlockedEvent&& other);
+  ~BlockedEvent();
+
+  std::string block_type;
+  std::string subresource;
+};
+
+// Collects the resources blocked on the IO thread and hands them to the UI
+// thread as one task per frame, at most once per flush delay. A page with
+// hundreds of blocked requests would otherwise post hundreds of UI tasks.
+// Only used on the IO thread.
+class BlockedEventBatcher {
+ public:
+  static BlockedEventBatcher* GetInstance();
+
+  void Add(int render_process_id,
+           int render_frame_id,
+           int frame_tree_node_id,
+           const std::string& block_type,
+           const std::string& subresource);
+
+  // With a zero delay every event is posted to the UI thread right away.
+  void SetFlushDelayForTesting(base::TimeDelta flush_delay);
+
+ private:
+  friend class base::NoDestructor<BlockedEventBatcher>;
+
+  // (render_process_id, render_frame_id, frame_tree_node_id)
+  using FrameKey = std::tuple<int, int, int>;
+
+  BlockedEventBatcher();
+  ~BlockedEventBatcher();
+
+  void Flush();
+
+  std::map<FrameKey, std::vector<BlockedEvent>> pending_events_;
+  bool flush_scheduled_ = false;
+  base::TimeDelta flush_delay_;
+
+  DISALLOW_COPY_AND_ASSIGN(BlockedEventBatcher);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOCKED_EVENT_BATCHER_H_
@@ -7,10 +7,9 @@
 
 #include <memory>
 
-#include "base/task/post_task.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/shield_exceptions.h"
-#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/browser/blocked_event_batcher.h"
 #include "brave/components/brave_shields/browser/referrer_whitelist_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/content_settings/core/browser/content_settings_util.h"
@@ -398,11 +397,9 @@ void DispatchBlockedEventFromIO(const GURL& request_url,
                                 int frame_tree_node_id,
                                 const std::string& block_type) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
-  base::PostTaskWithTraits(
-      FROM_HERE, {BrowserThread::UI},
-      base::BindOnce(&BraveShieldsWebContentsObserver::DispatchBlockedEvent,
-                     block_type, request_url.spec(), render_process_id,
-                     render_frame_id, frame_tree_node_id));
+  BlockedEventBatcher::GetInstance()->Add(render_process_id, render_frame_id,
+                                          frame_tree_node_id, block_type,
+                                          request_url.spec());
 }
 
 bool ShouldSetReferrer(bool allow_referrers,
@@ -11,6 +11,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/render_messages.h"
@@ -97,6 +98,10 @@ WebContents* GetWebContents(
   return web_contents;
 }
 
+// How long blocked stats are counted in memory before they are written to
+// the profile prefs.
+base::TimeDelta g_stats_commit_delay = base::TimeDelta::FromSeconds(10);
+
 }  // namespace
 
 namespace brave_shields {
@@ -220,9 +225,8 @@ void BraveShieldsWebContentsObserver::AddBlockedSubresource(
 }
 
 // static
-void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
-    std::string block_type,
-    std::string subresource,
+void BraveShieldsWebContentsObserver::DispatchBlockedEvents(
+    std::vector<BlockedEvent> events,
     int render_process_id,
     int render_frame_id,
     int frame_tree_node_id) {
@@ -230,34 +234,70 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
 
   WebContents* web_contents = GetWebContents(render_process_id,
     render_frame_id, frame_tree_node_id);
-  DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
-
-  if (web_contents) {
-    BraveShieldsWebContentsObserver* observer =
-        BraveShieldsWebContentsObserver::FromWebContents(web_contents);
-    if (observer &&
-        !observer->IsBlockedSubresource(subresource)) {
-      observer->AddBlockedSubresource(subresource);
-      PrefService* prefs = Profile::FromBrowserContext(
-          web_contents->GetBrowserContext())->
-          GetOriginalProfile()->
-          GetPrefs();
-
-      if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
-      } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
-      } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-            prefs->GetUint64(kJavascriptBlocked) + 1);
-      } else if (block_type == kFingerprinting) {
-        prefs->SetUint64(kFingerprintingBlocked,
-            prefs->GetUint64(kFingerprintingBlocked) + 1);
-      }
+  BraveShieldsWebContentsObserver* observer =
+      web_contents ? BraveShieldsWebContentsObserver::FromWebContents(
+                         web_contents)
+                   : nullptr;
+  for (const BlockedEvent& event : events) {
+    DispatchBlockedEventForWebContents(event.block_type, event.subresource,
+                                       web_contents);
+    if (observer && !observer->IsBlockedSubresource(event.subresource)) {
+      observer->AddBlockedSubresource(event.subresource);
+      observer->CountBlockedSubresource(event.block_type);
     }
   }
 }
 
+// static
+void BraveShieldsWebContentsObserver::SetStatsCommitDelayForTesting(
+    base::TimeDelta delay) {
+  g_stats_commit_delay = delay;
+}
+
+void BraveShieldsWebContentsObserver::CountBlockedSubresource(
+    const std::string& block_type) {
+  const char* pref_name = nullptr;
+  if (block_type == kAds) {
+    pref_name = kAdsBlocked;
+  } else if (block_type == kHTTPUpgradableResources) {
+    pref_name = kHttpsUpgrades;
+  } else if (block_type == kJavaScript) {
+    pref_name = kJavascriptBlocked;
+  } else if (block_type == kFingerprinting) {
+    pref_name = kFingerprintingBlocked;
+  }
+  if (!pref_name)
+    return;
+
+  pending_blocked_stats_[pref_name]++;
+  if (g_stats_commit_delay.is_zero()) {
+    CommitBlockedStats();
+  } else if (!commit_blocked_stats_timer_.IsRunning()) {
+    commit_blocked_stats_timer_.Start(
+        FROM_HERE, g_stats_commit_delay,
+        base::BindOnce(&BraveShieldsWebContentsObserver::CommitBlockedStats,
+                       base::Unretained(this)));
+  }
+}
+
+void BraveShieldsWebContentsObserver::CommitBlockedStats() {
+  commit_blocked_stats_timer_.Stop();
+  if (pending_blocked_stats_.empty() || !web_contents())
+    return;
+
+  PrefService* prefs = Profile::FromBrowserContext(
+      web_contents()->GetBrowserContext())->
+      GetOriginalProfile()->
+      GetPrefs();
+  for (const auto& stat : pending_blocked_stats_)
+    prefs->SetUint64(stat.first, prefs->GetUint64(stat.first) + stat.second);
+  pending_blocked_stats_.clear();
+}
+
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+  CommitBlockedStats();
+}
+
 #if !defined(OS_ANDROID)
 // static
 void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
@@ -8,10 +8,12 @@
 #include <utility>
 
 #include "base/bind.h"
-#include "base/task_runner_util.h"
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 #include "brave/vendor/extension-whitelist/extension_whitelist_parser.h"
 
+using brave_component_updater::ComponentLoadScheduler;
+
 namespace brave_shields {
 
 ExtensionWhitelistService::ExtensionWhitelistService(
@@ -47,14 +49,14 @@ void ExtensionWhitelistService::OnComponentReady(
       .AppendASCII(EXTENSION_DAT_FILE_VERSION)
       .AppendASCII(EXTENSION_DAT_FILE);
 
-  base::PostTaskAndReplyWithResult(
-      local_data_files_service()->GetTaskRunner().get(),
-      FROM_HERE,
-      base::BindOnce(
-          &brave_component_updater::LoadDATFileData<ExtensionWhitelistParser>,
-          dat_file_path),
-      base::BindOnce(&ExtensionWhitelistService::OnGetDATFileData,
-                     weak_factory_.GetWeakPtr()));
+  ComponentLoadScheduler::GetInstance()
+      ->ScheduleLoadWithResult<GetDATFileDataResult>(
+          "Extension whitelist", ComponentLoadScheduler::Priority::kNormal,
+          base::BindOnce(&brave_component_updater::LoadDATFileData<
+                             ExtensionWhitelistParser>,
+                         dat_file_path),
+          base::BindOnce(&ExtensionWhitelistService::OnGetDATFileData,
+                         weak_factory_.GetWeakPtr()));
 }
 
 void ExtensionWhitelistService::OnGetDATFileData(GetDATFileDataResult result) {
@@ -12,13 +12,16 @@
 
 #include "base/base_paths.h"
 #include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/post_task.h"
 #include "base/threading/scoped_blocking_call.h"
 #include "base/values.h"
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
 #include "third_party/re2/src/re2/re2.h"
 #include "third_party/zlib/google/zip.h"
@@ -77,6 +80,8 @@ std::string leveldbGet(leveldb::DB* db, const std::string &key) {
 
 }  // namespace
 
+using brave_component_updater::ComponentLoadScheduler;
+
 namespace brave_shields {
 
 const char kHTTPSEverywhereComponentName[] = "Brave HTTPS Everywhere Updater";
@@ -100,7 +105,10 @@ HTTPSEverywhereService::g_https_everywhere_component_base64_public_key_(
 HTTPSEverywhereService::HTTPSEverywhereService(
     BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
-      level_db_(nullptr) {
+      level_db_(nullptr),
+      task_runner_(base::CreateSequencedTaskRunnerWithTraits(
+          {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
@@ -155,11 +163,18 @@ void HTTPSEverywhereService::OnComponentReady(
     const std::string& component_id,
     const base::FilePath& install_dir,
     const std::string& manifest) {
-  GetTaskRunner()->PostTask(
-      FROM_HERE,
-      base::Bind(&HTTPSEverywhereService::InitDB,
-                 AsWeakPtr(),
-                 install_dir));
+  // Upgrading http requests is part of arming shields, so the database is
+  // opened ahead of other components.
+  ComponentLoadScheduler::GetInstance()->ScheduleLoad(
+      component_name(), ComponentLoadScheduler::Priority::kHigh,
+      base::BindOnce(&HTTPSEverywhereService::InitDB, AsWeakPtr(),
+                     install_dir),
+      base::DoNothing(), GetTaskRunner());
+}
+
+scoped_refptr<base::SequencedTaskRunner>
+HTTPSEverywhereService::GetTaskRunner() {
+  return task_runner_;
 }
 
 bool HTTPSEverywhereService::GetHTTPSURL(
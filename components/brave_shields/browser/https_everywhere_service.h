@@ -11,7 +11,9 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/lock.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
@@ -55,6 +57,10 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
                                 const uint64_t& request_id,
                                 std::string* cached_url);
 
+  // The database is opened and queried on its own sequence, so that lookups
+  // for every http request don't queue behind other components' files.
+  scoped_refptr<base::SequencedTaskRunner> GetTaskRunner() override;
+
  protected:
   bool Init() override;
   void Cleanup() override;
@@ -86,6 +92,7 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
   std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
   HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
   leveldb::DB* level_db_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
 
   SEQUENCE_CHECKER(sequence_checker_);
   DISALLOW_COPY_AND_ASSIGN(HTTPSEverywhereService);
@@ -4,9 +4,11 @@
 
 #include "base/task/post_task.h"
 #include "base/path_service.h"
+#include "base/run_loop.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/brave_paths.h"
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
 #include "brave/components/brave_shields/browser/https_everywhere_service.h"
 #include "chrome/browser/extensions/extension_browsertest.h"
 #include "chrome/browser/net/url_request_mock_util.h"
@@ -90,6 +92,10 @@ public:
   }
 
   void WaitForHTTPSEverywhereServiceThread() {
+    base::RunLoop run_loop;
+    brave_component_updater::ComponentLoadScheduler::GetInstance()
+        ->RunWhenIdleForTesting(run_loop.QuitClosure());
+    run_loop.Run();
     scoped_refptr<base::ThreadTestHelper> io_helper(
         new base::ThreadTestHelper(
             g_brave_browser_process->https_everywhere_service()->GetTaskRunner()));
@@ -0,0 +1,263 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/perfect_hash_host_set.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+
+namespace brave_shields {
+
+struct PerfectHashHostSet::Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t num_hosts;
+  uint32_t num_slots;
+  // Always even, so that the fingerprints following the displacements are
+  // 4-byte aligned.
+  uint32_t num_buckets;
+  uint32_t reserved;
+  uint64_t seed;
+};
+
+namespace {
+
+const uint32_t kMagic = 0x48485042;  // "BPHH"
+const uint32_t kVersion = 1;
+const size_t kHostsPerBucket = 4;
+const uint32_t kMaxDisplacement = 0xffff;
+const uint64_t kMaxSeedAttempts = 32;
+
+static_assert(sizeof(uint16_t) * 2 == sizeof(uint32_t),
+              "an even number of displacements must keep 4-byte alignment");
+
+// Finalizer of splitmix64, used to spread the bits of a 64-bit value.
+uint64_t Mix(uint64_t value) {
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+
+// Seeded 64-bit FNV-1a. It has to stay stable, since serialized tables
+// depend on it.
+uint64_t HashHost(base::StringPiece host, uint64_t seed) {
+  uint64_t hash = 14695981039346656037ULL ^ seed;
+  for (char c : host) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ULL;
+  }
+  return Mix(hash);
+}
+
+struct HostHash {
+  uint32_t bucket;
+  uint32_t fingerprint;
+  uint64_t base;
+  uint64_t step;
+};
+
+HostHash ComputeHostHash(base::StringPiece host,
+                         uint64_t seed,
+                         uint32_t num_buckets) {
+  const uint64_t hash = HashHost(host, seed);
+  HostHash host_hash;
+  host_hash.bucket = static_cast<uint32_t>(hash) % num_buckets;
+  host_hash.fingerprint = static_cast<uint32_t>(hash >> 32);
+  host_hash.base = Mix(hash);
+  host_hash.step = Mix(host_hash.base) | 1;
+  return host_hash;
+}
+
+size_t SlotFor(const HostHash& host_hash,
+               uint32_t displacement,
+               uint32_t num_slots) {
+  return (host_hash.base + displacement * host_hash.step) % num_slots;
+}
+
+uint64_t DataSize(uint32_t num_buckets, uint32_t num_slots) {
+  return sizeof(PerfectHashHostSet::Header) +
+         uint64_t{num_buckets} * sizeof(uint16_t) +
+         uint64_t{num_slots} * sizeof(uint32_t);
+}
+
+}  // namespace
+
+PerfectHashHostSet::PerfectHashHostSet() = default;
+
+PerfectHashHostSet::~PerfectHashHostSet() = default;
+
+// static
+std::unique_ptr<PerfectHashHostSet> PerfectHashHostSet::Build(
+    const std::vector<base::StringPiece>& hosts) {
+  std::vector<base::StringPiece> unique_hosts;
+  unique_hosts.reserve(hosts.size());
+  for (const auto& host : hosts) {
+    if (!host.empty())
+      unique_hosts.push_back(host);
+  }
+  std::sort(unique_hosts.begin(), unique_hosts.end());
+  unique_hosts.erase(std::unique(unique_hosts.begin(), unique_hosts.end()),
+                     unique_hosts.end());
+  if (unique_hosts.empty())
+    return nullptr;
+
+  const uint32_t num_hosts = unique_hosts.size();
+  // A load factor of ~97% keeps the search for displacements short.
+  const uint32_t num_slots = num_hosts + num_hosts / 32 + 1;
+  uint32_t num_buckets = (num_hosts + kHostsPerBucket - 1) / kHostsPerBucket;
+  num_buckets += num_buckets % 2;
+
+  std::vector<HostHash> host_hashes(num_hosts);
+  std::vector<std::vector<uint32_t>> buckets(num_buckets);
+  std::vector<uint32_t> bucket_order(num_buckets);
+  std::vector<bool> occupied(num_slots);
+  std::vector<size_t> slots;
+  std::vector<uint16_t> displacements(num_buckets);
+  std::vector<uint32_t> fingerprints(num_slots);
+
+  for (uint64_t attempt = 0; attempt < kMaxSeedAttempts; ++attempt) {
+    const uint64_t seed = Mix(attempt + 1);
+    for (auto& bucket : buckets)
+      bucket.clear();
+    for (uint32_t i = 0; i < num_hosts; ++i) {
+      host_hashes[i] = ComputeHostHash(unique_hosts[i], seed, num_buckets);
+      buckets[host_hashes[i].bucket].push_back(i);
+    }
+
+    // Place the largest buckets first, while the table is still empty.
+    std::iota(bucket_order.begin(), bucket_order.end(), 0);
+    std::stable_sort(bucket_order.begin(), bucket_order.end(),
+                     [&buckets](uint32_t a, uint32_t b) {
+                       return buckets[a].size() > buckets[b].size();
+                     });
+    std::fill(occupied.begin(), occupied.end(), false);
+    std::fill(displacements.begin(), displacements.end(), 0);
+    std::fill(fingerprints.begin(), fingerprints.end(), 0);
+
+    bool placed_all = true;
+    for (uint32_t bucket_index : bucket_order) {
+      const std::vector<uint32_t>& bucket = buckets[bucket_index];
+      if (bucket.empty())
+        break;
+      bool placed = false;
+      for (uint32_t displacement = 0;
+           !placed && displacement <= kMaxDisplacement; ++displacement) {
+        slots.clear();
+        for (uint32_t host_index : bucket) {
+          size_t slot =
+              SlotFor(host_hashes[host_index], displacement, num_slots);
+          if (occupied[slot] ||
+              std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+            break;
+          }
+          slots.push_back(slot);
+        }
+        if (slots.size() != bucket.size())
+          continue;
+        for (size_t i = 0; i < slots.size(); ++i) {
+          occupied[slots[i]] = true;
+          fingerprints[slots[i]] = host_hashes[bucket[i]].fingerprint;
+        }
+        displacements[bucket_index] = displacement;
+        placed = true;
+      }
+      if (!placed) {
+        placed_all = false;
+        break;
+      }
+    }
+    if (!placed_all)
+      continue;
+
+    Header header = {};
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.num_hosts = num_hosts;
+    header.num_slots = num_slots;
+    header.num_buckets = num_buckets;
+    header.seed = seed;
+
+    auto set = base::WrapUnique(new PerfectHashHostSet());
+    set->owned_data_.resize(DataSize(num_buckets, num_slots));
+    uint8_t* out = set->owned_data_.data();
+    memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    memcpy(out, displacements.data(), num_buckets * sizeof(uint16_t));
+    out += num_buckets * sizeof(uint16_t);
+    memcpy(out, fingerprints.data(), num_slots * sizeof(uint32_t));
+    if (!set->Init(set->owned_data_))
+      return nullptr;
+    return set;
+  }
+
+  LOG(ERROR) << "Could not build a perfect hash for " << num_hosts << " hosts";
+  return nullptr;
+}
+
+// static
+std::unique_ptr<PerfectHashHostSet> PerfectHashHostSet::CreateFromFile(
+    const base::FilePath& path) {
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  if (!mapped_file->Initialize(path))
+    return nullptr;
+
+  auto set = base::WrapUnique(new PerfectHashHostSet());
+  set->mapped_file_ = std::move(mapped_file);
+  if (!set->Init(base::make_span(set->mapped_file_->data(),
+                                 set->mapped_file_->length()))) {
+    LOG(ERROR) << "Invalid perfect hash host set: " << path.value();
+    return nullptr;
+  }
+  return set;
+}
+
+bool PerfectHashHostSet::Init(base::span<const uint8_t> data) {
+  if (data.size() < sizeof(Header) ||
+      reinterpret_cast<uintptr_t>(data.data()) % alignof(Header) != 0) {
+    return false;
+  }
+  const Header* header = reinterpret_cast<const Header*>(data.data());
+  if (header->magic != kMagic || header->version != kVersion ||
+      header->num_slots == 0 || header->num_buckets == 0 ||
+      header->num_buckets % 2 != 0 ||
+      data.size() != DataSize(header->num_buckets, header->num_slots)) {
+    return false;
+  }
+
+  data_ = data;
+  header_ = header;
+  displacements_ =
+      reinterpret_cast<const uint16_t*>(data.data() + sizeof(Header));
+  fingerprints_ = reinterpret_cast<const uint32_t*>(
+      data.data() + sizeof(Header) + header->num_buckets * sizeof(uint16_t));
+  return true;
+}
+
+bool PerfectHashHostSet::Contains(base::StringPiece host) const {
+  if (!header_ || host.empty())
+    return false;
+  const HostHash host_hash =
+      ComputeHostHash(host, header_->seed, header_->num_buckets);
+  const size_t slot = SlotFor(
+      host_hash, displacements_[host_hash.bucket], header_->num_slots);
+  return fingerprints_[slot] == host_hash.fingerprint;
+}
+
+size_t PerfectHashHostSet::size() const {
+  return header_ ? header_->num_hosts : 0;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,74 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_PERFECT_HASH_HOST_SET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_PERFECT_HASH_HOST_SET_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+class FilePath;
+class MemoryMappedFile;
+}
+
+namespace brave_shields {
+
+// A static set of hosts stored as a hash-and-displace perfect hash table.
+// Each host is reduced to a 64-bit hash; the table keeps one 16-bit
+// displacement per four hosts and one 32-bit fingerprint per slot, so the
+// set takes under five bytes per host and a lookup is one hash computation
+// and two array reads, without any allocation. Because only fingerprints
+// are stored, a host outside the set is reported as a member with a
+// probability of about 2^-32.
+//
+// The table is either built in memory from a host list, or memory mapped
+// from a file holding the output of data(). The serialized form uses the
+// host byte order.
+class PerfectHashHostSet {
+ public:
+  ~PerfectHashHostSet();
+
+  // Returns nullptr if |hosts| is empty or no perfect hash was found.
+  static std::unique_ptr<PerfectHashHostSet> Build(
+      const std::vector<base::StringPiece>& hosts);
+  // Returns nullptr if |path| can't be mapped or isn't a valid table.
+  static std::unique_ptr<PerfectHashHostSet> CreateFromFile(
+      const base::FilePath& path);
+
+  bool Contains(base::StringPiece host) const;
+  size_t size() const;
+
+  // The serialized table, as read by CreateFromFile(). It starts with a
+  // Header.
+  base::span<const uint8_t> data() const { return data_; }
+
+  struct Header;
+
+ private:
+  PerfectHashHostSet();
+  bool Init(base::span<const uint8_t> data);
+
+  std::vector<uint8_t> owned_data_;
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
+
+  base::span<const uint8_t> data_;
+  const Header* header_ = nullptr;
+  const uint16_t* displacements_ = nullptr;
+  const uint32_t* fingerprints_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(PerfectHashHostSet);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_PERFECT_HASH_HOST_SET_H_
@@ -0,0 +1,81 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/perfect_hash_host_set.h"
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::PerfectHashHostSet;
+
+namespace {
+
+std::vector<std::string> TestHosts(size_t count) {
+  std::vector<std::string> hosts;
+  for (size_t i = 0; i < count; ++i)
+    hosts.push_back("tracker" + base::NumberToString(i) + ".com");
+  return hosts;
+}
+
+}  // namespace
+
+TEST(PerfectHashHostSetTest, Membership) {
+  const std::vector<std::string> hosts = TestHosts(5000);
+  std::vector<base::StringPiece> pieces(hosts.begin(), hosts.end());
+  // Duplicates and empty entries are ignored.
+  pieces.push_back("tracker1.com");
+  pieces.push_back("");
+
+  std::unique_ptr<PerfectHashHostSet> set = PerfectHashHostSet::Build(pieces);
+  ASSERT_TRUE(set);
+  EXPECT_EQ(set->size(), hosts.size());
+  // Stays within a few bytes per host.
+  EXPECT_LT(set->data().size(), hosts.size() * 5 + 64);
+
+  for (const auto& host : hosts)
+    EXPECT_TRUE(set->Contains(host)) << host;
+  EXPECT_FALSE(set->Contains(""));
+  EXPECT_FALSE(set->Contains("example.com"));
+  EXPECT_FALSE(set->Contains("www.tracker1.com"));
+}
+
+TEST(PerfectHashHostSetTest, EmptyList) {
+  EXPECT_FALSE(PerfectHashHostSet::Build({}));
+  EXPECT_FALSE(PerfectHashHostSet::Build({""}));
+}
+
+TEST(PerfectHashHostSetTest, MemoryMappedFile) {
+  const std::vector<std::string> hosts = TestHosts(100);
+  std::unique_ptr<PerfectHashHostSet> built = PerfectHashHostSet::Build(
+      std::vector<base::StringPiece>(hosts.begin(), hosts.end()));
+  ASSERT_TRUE(built);
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath path = temp_dir.GetPath().AppendASCII("trackers.phs");
+  const base::span<const uint8_t> data = built->data();
+  ASSERT_EQ(base::WriteFile(path, reinterpret_cast<const char*>(data.data()),
+                            data.size()),
+            static_cast<int>(data.size()));
+
+  std::unique_ptr<PerfectHashHostSet> mapped =
+      PerfectHashHostSet::CreateFromFile(path);
+  ASSERT_TRUE(mapped);
+  EXPECT_EQ(mapped->size(), hosts.size());
+  for (const auto& host : hosts)
+    EXPECT_TRUE(mapped->Contains(host)) << host;
+  EXPECT_FALSE(mapped->Contains("example.com"));
+
+  // Truncated files are rejected.
+  ASSERT_TRUE(base::WriteFile(path, reinterpret_cast<const char*>(data.data()),
+                              data.size() - 1));
+  EXPECT_FALSE(PerfectHashHostSet::CreateFromFile(path));
+}
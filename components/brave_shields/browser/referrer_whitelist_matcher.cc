@@ -0,0 +1,126 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/referrer_whitelist_matcher.h"
+
+#include <utility>
+
+#include "base/strings/string_piece.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+template <typename T>
+std::vector<T>* BucketFor(
+    const URLPattern& pattern,
+    base::flat_map<std::string, std::vector<T>, std::less<>>* by_host,
+    std::vector<T>* any_host) {
+  if (pattern.match_all_urls() || pattern.host().empty())
+    return any_host;
+  return &(*by_host)[pattern.host()];
+}
+
+// Runs |matches| on the bucket of |host| and of each of its parent domains
+// until it returns true.
+template <typename T, typename Predicate>
+bool AnyBucketForHostMatches(
+    const base::flat_map<std::string, std::vector<T>, std::less<>>& by_host,
+    const GURL& url,
+    Predicate matches) {
+  base::StringPiece host = url.host_piece();
+  while (!host.empty()) {
+    auto it = by_host.find(host);
+    if (it != by_host.end() && matches(it->second))
+      return true;
+    size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+  return false;
+}
+
+bool AnyPatternMatches(const std::vector<URLPattern>& patterns,
+                       const GURL& url) {
+  for (const URLPattern& pattern : patterns) {
+    if (pattern.MatchesURL(url))
+      return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+HostBucketedURLPatterns::HostBucketedURLPatterns() = default;
+HostBucketedURLPatterns::HostBucketedURLPatterns(
+    HostBucketedURLPatterns&& other) = default;
+HostBucketedURLPatterns::~HostBucketedURLPatterns() = default;
+
+void HostBucketedURLPatterns::Add(const URLPattern& pattern) {
+  BucketFor(pattern, &patterns_by_host_, &patterns_for_any_host_)
+      ->push_back(pattern);
+  size_++;
+}
+
+bool HostBucketedURLPatterns::MatchesURL(const GURL& url) const {
+  if (AnyPatternMatches(patterns_for_any_host_, url))
+    return true;
+  return AnyBucketForHostMatches(
+      patterns_by_host_, url, [&url](const std::vector<URLPattern>& bucket) {
+        return AnyPatternMatches(bucket, url);
+      });
+}
+
+ReferrerWhitelistMatcher::Entry::Entry() = default;
+ReferrerWhitelistMatcher::Entry::Entry(Entry&& other) = default;
+ReferrerWhitelistMatcher::Entry::~Entry() = default;
+
+ReferrerWhitelistMatcher::ReferrerWhitelistMatcher() = default;
+
+ReferrerWhitelistMatcher::~ReferrerWhitelistMatcher() = default;
+
+void ReferrerWhitelistMatcher::Add(
+    const URLPattern& first_party_pattern,
+    const std::vector<URLPattern>& subresource_patterns) {
+  Entry entry;
+  entry.first_party_pattern = first_party_pattern;
+  for (const URLPattern& subresource_pattern : subresource_patterns)
+    entry.subresource_patterns.Add(subresource_pattern);
+  entries_.push_back(std::move(entry));
+
+  BucketFor(first_party_pattern, &entries_by_first_party_host_,
+            &entries_for_any_first_party_)
+      ->push_back(entries_.size() - 1);
+}
+
+bool ReferrerWhitelistMatcher::EntryMatches(
+    size_t entry_index,
+    const GURL& first_party_origin,
+    const GURL& subresource_url) const {
+  const Entry& entry = entries_[entry_index];
+  return entry.first_party_pattern.MatchesURL(first_party_origin) &&
+         entry.subresource_patterns.MatchesURL(subresource_url);
+}
+
+bool ReferrerWhitelistMatcher::IsWhitelisted(
+    const GURL& first_party_origin,
+    const GURL& subresource_url) const {
+  auto entries_match = [&](const std::vector<size_t>& entry_indices) {
+    for (size_t entry_index : entry_indices) {
+      if (EntryMatches(entry_index, first_party_origin, subresource_url))
+        return true;
+    }
+    return false;
+  };
+
+  if (entries_match(entries_for_any_first_party_))
+    return true;
+  return AnyBucketForHostMatches(entries_by_first_party_host_,
+                                 first_party_origin, entries_match);
+}
+
+}  // namespace brave_shields
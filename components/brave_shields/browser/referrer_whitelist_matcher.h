@@ -0,0 +1,93 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_REFERRER_WHITELIST_MATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_REFERRER_WHITELIST_MATCHER_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace brave_shields {
+
+// URL patterns bucketed by host. Patterns that match subdomains are found by
+// walking the dot-separated suffixes of the URL host, and patterns matching
+// any host are kept in a separate list.
+class HostBucketedURLPatterns {
+ public:
+  HostBucketedURLPatterns();
+  HostBucketedURLPatterns(HostBucketedURLPatterns&& other);
+  ~HostBucketedURLPatterns();
+
+  void Add(const URLPattern& pattern);
+  bool MatchesURL(const GURL& url) const;
+  size_t size() const { return size_; }
+
+ private:
+  base::flat_map<std::string, std::vector<URLPattern>, std::less<>>
+      patterns_by_host_;
+  std::vector<URLPattern> patterns_for_any_host_;
+  size_t size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(HostBucketedURLPatterns);
+};
+
+// Compiled form of ReferrerWhitelist.json. It is built once per component
+// update and then only read, so one instance is shared between the UI and
+// IO threads.
+class ReferrerWhitelistMatcher
+    : public base::RefCountedThreadSafe<ReferrerWhitelistMatcher> {
+ public:
+  ReferrerWhitelistMatcher();
+
+  // Adds a whitelist entry allowing referrers from first parties matching
+  // |first_party_pattern| to subresources matching |subresource_patterns|.
+  void Add(const URLPattern& first_party_pattern,
+           const std::vector<URLPattern>& subresource_patterns);
+
+  bool IsWhitelisted(const GURL& first_party_origin,
+                     const GURL& subresource_url) const;
+
+  // Number of whitelist entries, i.e. of first-party patterns.
+  size_t size() const { return entries_.size(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<ReferrerWhitelistMatcher>;
+  ~ReferrerWhitelistMatcher();
+
+  struct Entry {
+    Entry();
+    Entry(Entry&& other);
+    ~Entry();
+
+    URLPattern first_party_pattern;
+    HostBucketedURLPatterns subresource_patterns;
+
+    DISALLOW_COPY_AND_ASSIGN(Entry);
+  };
+
+  bool EntryMatches(size_t entry_index,
+                    const GURL& first_party_origin,
+                    const GURL& subresource_url) const;
+
+  std::vector<Entry> entries_;
+  // Indices into |entries_|, keyed by the host of their first-party pattern.
+  base::flat_map<std::string, std::vector<size_t>, std::less<>>
+      entries_by_first_party_host_;
+  std::vector<size_t> entries_for_any_first_party_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReferrerWhitelistMatcher);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_REFERRER_WHITELIST_MATCHER_H_
@@ -0,0 +1,157 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <utility>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/brave_shields/browser/referrer_whitelist_matcher.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=ReferrerWhitelistMatcherPerfTest.*
+
+namespace {
+
+const int kExtraEntries = 200;
+const int kIterations = 200;
+
+const int kValidSchemes = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+// Mirrors test/data/referrer-whitelist-data/1/ReferrerWhitelist.json.
+const struct {
+  const char* first_party;
+  std::vector<const char*> subresources;
+} kWhitelist[] = {
+    {"<all_urls>",
+     {"https://use.typekit.net/*", "https://api.geetest.com/*",
+      "https://cloud.typography.com/*"}},
+    {"https://www.facebook.com/", {"https://*.fbcdn.net/*"}},
+    {"https://accounts.google.com/", {"https://content.googleapis.com/*"}},
+    {"https://www.reddit.com/*",
+     {"https://www.redditmedia.com/*", "https://cdn.embedly.com/*",
+      "https://imgur.com/*"}},
+};
+
+// The linear scan the service used before the whitelist was compiled, kept
+// as a reference for correctness and timing.
+class LinearReferrerWhitelist {
+ public:
+  void Add(const URLPattern& first_party_pattern,
+           const std::vector<URLPattern>& subresource_patterns) {
+    entries_.emplace_back(first_party_pattern, subresource_patterns);
+  }
+
+  bool IsWhitelisted(const GURL& first_party_origin,
+                     const GURL& subresource_url) const {
+    for (auto entry : entries_) {
+      if (entry.first.MatchesURL(first_party_origin)) {
+        for (auto subresource_pattern : entry.second) {
+          if (subresource_pattern.MatchesURL(subresource_url))
+            return true;
+        }
+      }
+    }
+    return false;
+  }
+
+ private:
+  std::vector<std::pair<URLPattern, std::vector<URLPattern>>> entries_;
+};
+
+template <typename Whitelist>
+void PopulateWhitelist(Whitelist* whitelist, int extra_entries) {
+  for (const auto& entry : kWhitelist) {
+    std::vector<URLPattern> subresource_patterns;
+    for (const char* subresource : entry.subresources)
+      subresource_patterns.emplace_back(kValidSchemes, subresource);
+    whitelist->Add(URLPattern(kValidSchemes, entry.first_party),
+                   subresource_patterns);
+  }
+  // Pad with site-specific entries, the way the real list grows.
+  for (int i = 0; i < extra_entries; ++i) {
+    std::vector<URLPattern> subresource_patterns;
+    subresource_patterns.emplace_back(
+        kValidSchemes, base::StringPrintf("https://*.cdn%d.net/*", i));
+    subresource_patterns.emplace_back(
+        kValidSchemes, base::StringPrintf("https://media.site%d.com/*", i));
+    whitelist->Add(
+        URLPattern(kValidSchemes,
+                   base::StringPrintf("https://*.site%d.com/*", i)),
+        subresource_patterns);
+  }
+}
+
+// A page load's worth of (first party, subresource origin) pairs: mostly
+// third-party subresources nothing whitelists, plus some that are.
+std::vector<std::pair<GURL, GURL>> PageRequestMix() {
+  const char* first_parties[] = {
+      "https://www.facebook.com/", "https://www.reddit.com/",
+      "https://www.nytimes.com/", "https://www.site17.com/",
+      "https://accounts.google.com/", "https://binance.com/",
+  };
+  const char* subresources[] = {
+      "https://video-zyz1-9.xy.fbcdn.net/", "https://imgur.com/",
+      "https://www.google-analytics.com/", "https://use.typekit.net/",
+      "https://securepubads.g.doubleclick.net/", "https://cdn.cdn17.net/",
+      "https://media.site17.com/", "https://content.googleapis.com/",
+      "https://ajax.googleapis.com/", "https://static.xx.fbcdn.net/",
+  };
+  std::vector<std::pair<GURL, GURL>> requests;
+  for (const char* first_party : first_parties) {
+    for (const char* subresource : subresources)
+      requests.emplace_back(GURL(first_party), GURL(subresource));
+  }
+  return requests;
+}
+
+}  // namespace
+
+// Runs a realistic request mix against the compiled whitelist and the old
+// linear scan, checks that they agree and reports the time each one took.
+TEST(ReferrerWhitelistMatcherPerfTest, RequestMix) {
+  auto whitelist =
+      base::MakeRefCounted<brave_shields::ReferrerWhitelistMatcher>();
+  PopulateWhitelist(whitelist.get(), kExtraEntries);
+  LinearReferrerWhitelist linear_whitelist;
+  PopulateWhitelist(&linear_whitelist, kExtraEntries);
+
+  const std::vector<std::pair<GURL, GURL>> requests = PageRequestMix();
+  for (const auto& request : requests) {
+    EXPECT_EQ(whitelist->IsWhitelisted(request.first, request.second),
+              linear_whitelist.IsWhitelisted(request.first, request.second))
+        << request.first << " " << request.second;
+  }
+
+  size_t whitelisted = 0;
+  base::ElapsedTimer compiled_timer;
+  for (int i = 0; i < kIterations; ++i) {
+    for (const auto& request : requests)
+      whitelisted += whitelist->IsWhitelisted(request.first, request.second);
+  }
+  base::TimeDelta compiled_time = compiled_timer.Elapsed();
+
+  size_t linear_whitelisted = 0;
+  base::ElapsedTimer linear_timer;
+  for (int i = 0; i < kIterations; ++i) {
+    for (const auto& request : requests) {
+      linear_whitelisted +=
+          linear_whitelist.IsWhitelisted(request.first, request.second);
+    }
+  }
+  base::TimeDelta linear_time = linear_timer.Elapsed();
+
+  EXPECT_EQ(whitelisted, linear_whitelisted);
+  perf_test::PrintResult(
+      "referrer_whitelist", "_compiled", "per_lookup",
+      compiled_time.InMicrosecondsF() / (kIterations * requests.size()),
+      "us", true);
+  perf_test::PrintResult(
+      "referrer_whitelist", "_linear", "per_lookup",
+      linear_time.InMicrosecondsF() / (kIterations * requests.size()),
+      "us", true);
+}
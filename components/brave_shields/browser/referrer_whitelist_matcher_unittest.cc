@@ -0,0 +1,69 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/referrer_whitelist_matcher.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+const int kValidSchemes = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+// Mirrors test/data/referrer-whitelist-data/1/ReferrerWhitelist.json.
+const struct {
+  const char* first_party;
+  std::vector<const char*> subresources;
+} kWhitelist[] = {
+    {"<all_urls>",
+     {"https://use.typekit.net/*", "https://api.geetest.com/*",
+      "https://cloud.typography.com/*"}},
+    {"https://www.facebook.com/", {"https://*.fbcdn.net/*"}},
+    {"https://accounts.google.com/", {"https://content.googleapis.com/*"}},
+    {"https://www.reddit.com/*",
+     {"https://www.redditmedia.com/*", "https://cdn.embedly.com/*",
+      "https://imgur.com/*"}},
+};
+
+void PopulateWhitelist(brave_shields::ReferrerWhitelistMatcher* whitelist) {
+  for (const auto& entry : kWhitelist) {
+    std::vector<URLPattern> subresource_patterns;
+    for (const char* subresource : entry.subresources)
+      subresource_patterns.emplace_back(kValidSchemes, subresource);
+    whitelist->Add(URLPattern(kValidSchemes, entry.first_party),
+                   subresource_patterns);
+  }
+}
+
+}  // namespace
+
+TEST(ReferrerWhitelistMatcherTest, Matches) {
+  auto whitelist =
+      base::MakeRefCounted<brave_shields::ReferrerWhitelistMatcher>();
+  PopulateWhitelist(whitelist.get());
+  EXPECT_EQ(whitelist->size(), 4UL);
+
+  EXPECT_FALSE(whitelist->IsWhitelisted(
+      GURL("https://test.com"), GURL("https://video-zyz1-9.xy.fbcdn.net")));
+  EXPECT_TRUE(whitelist->IsWhitelisted(
+      GURL("https://www.facebook.com"),
+      GURL("https://video-zyz1-9.xy.fbcdn.net")));
+  EXPECT_FALSE(whitelist->IsWhitelisted(GURL("https://www.facebook.com"),
+                                        GURL("https://test.com")));
+  EXPECT_TRUE(whitelist->IsWhitelisted(GURL("https://www.reddit.com/"),
+                                       GURL("https://imgur.com/179")));
+  EXPECT_FALSE(whitelist->IsWhitelisted(GURL("https://www.test.com"),
+                                        GURL("https://imgur.com/173")));
+  EXPECT_TRUE(whitelist->IsWhitelisted(GURL("https://www.test.com"),
+                                       GURL("https://use.typekit.net/193")));
+  EXPECT_FALSE(whitelist->IsWhitelisted(GURL("http://binance.com"),
+                                        GURL("http://api.geetest.com/")));
+  EXPECT_FALSE(whitelist->IsWhitelisted(
+      GURL("https://accounts.google.com"),
+      GURL("https://ajax.googleapis.com/ajax/libs/d3js/5.7.0/d3.min.js")));
+}
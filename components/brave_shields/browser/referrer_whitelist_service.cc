@@ -6,17 +6,19 @@
 #include "brave/components/brave_shields/browser/referrer_whitelist_service.h"
 
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/json/json_reader.h"
 #include "base/task/post_task.h"
-#include "base/task_runner_util.h"
 #include "base/values.h"
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 
+using brave_component_updater::ComponentLoadScheduler;
 using brave_component_updater::LocalDataFilesObserver;
 using brave_component_updater::LocalDataFilesService;
 using content::BrowserThread;
@@ -33,41 +35,19 @@ ReferrerWhitelistService::ReferrerWhitelistService(
 ReferrerWhitelistService::~ReferrerWhitelistService() {
 }
 
-ReferrerWhitelistService::ReferrerWhitelist::ReferrerWhitelist() = default;
-ReferrerWhitelistService::ReferrerWhitelist::ReferrerWhitelist(
-  const ReferrerWhitelist& other) = default;
-ReferrerWhitelistService::ReferrerWhitelist::~ReferrerWhitelist() = default;
-
 bool ReferrerWhitelistService::IsWhitelisted(
     const GURL& first_party_origin, const GURL& subresource_url) const {
-  if (BrowserThread::CurrentlyOn(BrowserThread::IO)) {
-    return IsWhitelisted(
-        referrer_whitelist_io_thread_, first_party_origin, subresource_url);
-  } else {
-    return IsWhitelisted(
-        referrer_whitelist_, first_party_origin, subresource_url);
-  }
-}
-
-bool ReferrerWhitelistService::IsWhitelisted(
-    const std::vector<ReferrerWhitelist>& whitelist,
-    const GURL& first_party_origin,
-    const GURL& subresource_url) const {
-  for (auto rw : whitelist) {
-    if (rw.first_party_pattern.MatchesURL(first_party_origin)) {
-      for (auto subresource_pattern : rw.subresource_pattern_list) {
-        if (subresource_pattern.MatchesURL(subresource_url)) {
-          return true;
-        }
-      }
-    }
-  }
-  return false;
+  const ReferrerWhitelistMatcher* whitelist =
+      BrowserThread::CurrentlyOn(BrowserThread::IO)
+          ? referrer_whitelist_io_thread_.get()
+          : referrer_whitelist_.get();
+  return whitelist &&
+         whitelist->IsWhitelisted(first_party_origin, subresource_url);
 }
 
 void ReferrerWhitelistService::OnDATFileDataReady(std::string contents) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  referrer_whitelist_.clear();
+  referrer_whitelist_ = nullptr;
   if (contents.empty()) {
     LOG(ERROR) << "Could not obtain referrer whitelist data";
     return;
@@ -82,22 +62,23 @@ void ReferrerWhitelistService::OnDATFileDataReady(std::string contents) {
   root->GetAsDictionary(&root_dict);
   base::ListValue* whitelist = nullptr;
   root_dict->GetList("whitelist", &whitelist);
+  auto matcher = base::MakeRefCounted<ReferrerWhitelistMatcher>();
   for (base::Value& origins : whitelist->GetList()) {
     base::DictionaryValue* origins_dict = nullptr;
     origins.GetAsDictionary(&origins_dict);
     for (const auto& it : origins_dict->DictItems()) {
-      ReferrerWhitelist rw;
-      rw.first_party_pattern = URLPattern(
+      URLPattern first_party_pattern(
         URLPattern::SCHEME_HTTP|URLPattern::SCHEME_HTTPS, it.first);
-      URLPatternList subresource_pattern_list;
+      std::vector<URLPattern> subresource_patterns;
       for (base::Value& subresource_value : it.second.GetList()) {
-        rw.subresource_pattern_list.push_back(URLPattern(
+        subresource_patterns.push_back(URLPattern(
           URLPattern::SCHEME_HTTP|URLPattern::SCHEME_HTTPS,
           subresource_value.GetString()));
       }
-      referrer_whitelist_.push_back(rw);
+      matcher->Add(first_party_pattern, subresource_patterns);
     }
   }
+  referrer_whitelist_ = std::move(matcher);
 
   base::PostTaskWithTraits(
       FROM_HERE, {BrowserThread::IO},
@@ -107,7 +88,7 @@ void ReferrerWhitelistService::OnDATFileDataReady(std::string contents) {
 }
 
 void ReferrerWhitelistService::OnDATFileDataReadyOnIOThread(
-    std::vector<ReferrerWhitelist> whitelist) {
+    scoped_refptr<const ReferrerWhitelistMatcher> whitelist) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   referrer_whitelist_io_thread_ = std::move(whitelist);
 }
@@ -120,13 +101,13 @@ void ReferrerWhitelistService::OnComponentReady(
       .AppendASCII(REFERRER_DAT_FILE_VERSION)
       .AppendASCII(REFERRER_DAT_FILE);
 
-  base::PostTaskAndReplyWithResult(
-      local_data_files_service()->GetTaskRunner().get(),
-      FROM_HERE,
-      base::BindOnce(&brave_component_updater::GetDATFileAsString,
-                     dat_file_path),
-      base::BindOnce(&ReferrerWhitelistService::OnDATFileDataReady,
-                     weak_factory_.GetWeakPtr()));
+  ComponentLoadScheduler::GetInstance()
+      ->ScheduleLoadWithResult<std::string>(
+          "Referrer whitelist", ComponentLoadScheduler::Priority::kNormal,
+          base::BindOnce(&brave_component_updater::GetDATFileAsString,
+                         dat_file_path),
+          base::BindOnce(&ReferrerWhitelistService::OnDATFileDataReady,
+                         weak_factory_.GetWeakPtr()));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -11,10 +11,11 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
-#include "extensions/common/url_pattern.h"
+#include "brave/components/brave_shields/browser/referrer_whitelist_matcher.h"
 #include "url/gurl.h"
 
 #define REFERRER_DAT_FILE "ReferrerWhitelist.json"
@@ -45,24 +46,14 @@ class ReferrerWhitelistService : public LocalDataFilesObserver {
  private:
   friend class ::ReferrerWhitelistServiceTest;
 
-  struct ReferrerWhitelist {
-    URLPattern first_party_pattern;
-    URLPatternList subresource_pattern_list;
-    ReferrerWhitelist();
-    ReferrerWhitelist(const ReferrerWhitelist& other);
-    ~ReferrerWhitelist();
-  };
-
-  bool IsWhitelisted(const std::vector<ReferrerWhitelist>& whitelist,
-                     const GURL& first_party_origin,
-                     const GURL& subresource_url) const;
   void OnDATFileDataReady(std::string contents);
-  void OnDATFileDataReadyOnIOThread(std::vector<ReferrerWhitelist> whitelist);
+  void OnDATFileDataReadyOnIOThread(
+      scoped_refptr<const ReferrerWhitelistMatcher> whitelist);
 
-  typedef std::vector<URLPattern> URLPatternList;
-
-  std::vector<ReferrerWhitelist> referrer_whitelist_;
-  std::vector<ReferrerWhitelist> referrer_whitelist_io_thread_;
+  // Both point to the same immutable matcher once loaded; each is only
+  // accessed on its own thread.
+  scoped_refptr<const ReferrerWhitelistMatcher> referrer_whitelist_;
+  scoped_refptr<const ReferrerWhitelistMatcher> referrer_whitelist_io_thread_;
 
   SEQUENCE_CHECKER(sequence_checker_);
   base::WeakPtrFactory<ReferrerWhitelistService> weak_factory_;
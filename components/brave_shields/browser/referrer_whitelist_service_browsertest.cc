@@ -9,6 +9,7 @@
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/brave_paths.h"
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 #include "brave/components/brave_shields/browser/referrer_whitelist_service.h"
 #include "chrome/browser/extensions/extension_browsertest.h"
@@ -76,6 +77,10 @@ class ReferrerWhitelistServiceTest : public ExtensionBrowserTest {
   }
 
   void WaitForReferrerWhitelistServiceThread() {
+    base::RunLoop run_loop;
+    brave_component_updater::ComponentLoadScheduler::GetInstance()
+        ->RunWhenIdleForTesting(run_loop.QuitClosure());
+    run_loop.Run();
     scoped_refptr<base::ThreadTestHelper> tr_helper(new base::ThreadTestHelper(
         g_brave_browser_process->local_data_files_service()->GetTaskRunner()));
     ASSERT_TRUE(tr_helper->Run());
@@ -93,13 +98,15 @@ class ReferrerWhitelistServiceTest : public ExtensionBrowserTest {
   }
 
   int GetWhitelistSize() {
-    return g_brave_browser_process->referrer_whitelist_service()->
-      referrer_whitelist_.size();
+    const auto& whitelist =
+        g_brave_browser_process->referrer_whitelist_service()->
+            referrer_whitelist_;
+    return whitelist ? whitelist->size() : 0;
   }
 
   void ClearWhitelist() {
     g_brave_browser_process->referrer_whitelist_service()->
-      referrer_whitelist_.clear();
+      referrer_whitelist_ = nullptr;
   }
 };
 
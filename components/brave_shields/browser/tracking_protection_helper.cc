@@ -9,6 +9,7 @@
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/brave_switches.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/navigation_handle.h"
@@ -48,6 +49,12 @@ void ModifyRenderFrameKey(int old_render_process_id,
       new_render_frame_id);
 }
 
+void OnShieldsSettingsChanged() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  g_brave_browser_process->tracking_protection_service()
+      ->OnShieldsSettingsChanged();
+}
+
 }  // namespace
 
 namespace brave_shields {
@@ -59,7 +66,10 @@ bool TrackingProtectionHelper::IsSmartTrackingProtectionEnabled() {
 }
 
 TrackingProtectionHelper::TrackingProtectionHelper(WebContents* web_contents)
-    : WebContentsObserver(web_contents) {}
+    : WebContentsObserver(web_contents), content_settings_observer_(this) {
+  content_settings_observer_.Add(HostContentSettingsMapFactory::GetForProfile(
+      web_contents->GetBrowserContext()));
+}
 
 TrackingProtectionHelper::~TrackingProtectionHelper() {}
 
@@ -101,6 +111,19 @@ void TrackingProtectionHelper::RenderFrameHostChanged(
                      new_host->GetRoutingID()));
 }
 
+void TrackingProtectionHelper::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type,
+    const std::string& resource_identifier) {
+  // Shields settings are stored as plugins settings.
+  if (content_type != CONTENT_SETTINGS_TYPE_PLUGINS) {
+    return;
+  }
+  base::PostTaskWithTraits(FROM_HERE, {BrowserThread::IO},
+                           base::BindOnce(&OnShieldsSettingsChanged));
+}
+
 WEB_CONTENTS_USER_DATA_KEY_IMPL(TrackingProtectionHelper)
 
 }  // namespace brave_shields
@@ -6,9 +6,14 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_TRACKING_PROTECTION_HELPER_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_TRACKING_PROTECTION_HELPER_H_
 
+#include <string>
+
 #include "base/macros.h"
+#include "base/scoped_observer.h"
 #include "base/strings/string16.h"
 #include "base/synchronization/lock.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
@@ -21,6 +26,7 @@ namespace brave_shields {
 
 class TrackingProtectionHelper
     : public content::WebContentsObserver,
+      public content_settings::Observer,
       public content::WebContentsUserData<TrackingProtectionHelper> {
  public:
   explicit TrackingProtectionHelper(content::WebContents*);
@@ -30,12 +36,23 @@ class TrackingProtectionHelper
   void RenderFrameHostChanged(content::RenderFrameHost* old_host,
                               content::RenderFrameHost* new_host) override;
   void RenderFrameDeleted(content::RenderFrameHost* render_frame_host) override;
+
+  // content_settings::Observer:
+  void OnContentSettingChanged(
+      const ContentSettingsPattern& primary_pattern,
+      const ContentSettingsPattern& secondary_pattern,
+      ContentSettingsType content_type,
+      const std::string& resource_identifier) override;
+
   static bool IsSmartTrackingProtectionEnabled();
   WEB_CONTENTS_USER_DATA_KEY_DECL();
 
  private:
   friend class content::WebContentsUserData<TrackingProtectionHelper>;
 
+  ScopedObserver<HostContentSettingsMap, content_settings::Observer>
+      content_settings_observer_;
+
   DISALLOW_COPY_AND_ASSIGN(TrackingProtectionHelper);
 };
 
@@ -9,13 +9,19 @@
 
 #include "base/bind.h"
 #include "base/task/post_task.h"
-#include "base/task_runner_util.h"
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 #include "brave/components/content_settings/core/browser/brave_cookie_settings.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 
 #if BUILDFLAG(BRAVE_STP_ENABLED)
+#include <tuple>
+
+#include "base/files/file_util.h"
+#include "base/hash/hash.h"
+#include "base/metrics/histogram_macros_local.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_split.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/tracking_protection_helper.h"
@@ -23,6 +29,7 @@
 #include "components/content_settings/core/browser/host_content_settings_map.h"
 #endif
 
+using brave_component_updater::ComponentLoadScheduler;
 using content::BrowserThread;
 using content_settings::BraveCookieSettings;
 
@@ -31,11 +38,18 @@ namespace brave_shields {
 #if BUILDFLAG(BRAVE_STP_ENABLED)
 const char kDatFileVersion[] = "1";
 const char kStorageTrackersFile[] = "StorageTrackingProtection.dat";
+const char kStorageTrackersPerfectHashFile[] = "StorageTrackingProtection.phs";
 #endif
 
 TrackingProtectionService::TrackingProtectionService(
     LocalDataFilesService* local_data_files_service)
     : LocalDataFilesObserver(local_data_files_service),
+#if BUILDFLAG(BRAVE_STP_ENABLED)
+      load_task_runner_(base::CreateSequencedTaskRunnerWithTraits(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      render_frame_starting_sites_(kMaxRenderFrames),
+#endif
       weak_factory_(this),
       weak_factory_io_thread_(this) {
 }
@@ -66,25 +80,91 @@ bool TrackingProtectionService::RenderFrameIdKey::operator==(
          frame_routing_id == other.frame_routing_id;
 }
 
+size_t TrackingProtectionService::RenderFrameIdKeyHash::operator()(
+    const RenderFrameIdKey& key) const {
+  return base::HashInts(key.render_process_id, key.frame_routing_id);
+}
+
+TrackingProtectionService::StartingSite::StartingSite(const GURL& origin)
+    : origin(origin) {}
+
+TrackingProtectionService::StartingSite::~StartingSite() = default;
+
 void TrackingProtectionService::SetStartingSiteForRenderFrame(
     GURL starting_site,
     int render_process_id,
     int render_frame_id) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   const RenderFrameIdKey key(render_process_id, render_frame_id);
-  render_frame_key_to_starting_site_url[key] = starting_site;
+  auto iter = render_frame_starting_sites_.Peek(key);
+  if (iter != render_frame_starting_sites_.end()) {
+    ReleaseStartingSite(iter->second);
+    render_frame_starting_sites_.Erase(iter);
+  } else if (render_frame_starting_sites_.size() == kMaxRenderFrames) {
+    // Make room ourselves, as MRUCache would evict without letting us
+    // release the frame's starting site.
+    auto oldest = render_frame_starting_sites_.rbegin();
+    ReleaseStartingSite(oldest->second);
+    render_frame_starting_sites_.Erase(oldest);
+  }
+
+  const GURL origin = starting_site.GetOrigin();
+  auto site = starting_sites_
+                  .emplace(std::piecewise_construct,
+                           std::forward_as_tuple(origin.spec()),
+                           std::forward_as_tuple(origin))
+                  .first;
+  site->second.frame_count++;
+  render_frame_starting_sites_.Put(key, &site->second);
 }
 
-GURL TrackingProtectionService::GetStartingSiteForRenderFrame(
-    int render_process_id,
-    int render_frame_id) const {
+TrackingProtectionService::StartingSite*
+TrackingProtectionService::GetStartingSite(int render_process_id,
+                                           int render_frame_id) const {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  RecordStartingSiteLookup();
   const RenderFrameIdKey key(render_process_id, render_frame_id);
-  auto iter = render_frame_key_to_starting_site_url.find(key);
-  if (iter != render_frame_key_to_starting_site_url.end()) {
+  auto iter = render_frame_starting_sites_.Peek(key);
+  if (iter != render_frame_starting_sites_.end()) {
     return iter->second;
   }
-  return {};
+  return nullptr;
+}
+
+const GURL& TrackingProtectionService::GetStartingSiteForRenderFrame(
+    int render_process_id,
+    int render_frame_id) const {
+  static const base::NoDestructor<GURL> kEmptyURL;
+  const StartingSite* starting_site =
+      GetStartingSite(render_process_id, render_frame_id);
+  return starting_site ? starting_site->origin : *kEmptyURL;
+}
+
+void TrackingProtectionService::ReleaseStartingSite(
+    StartingSite* starting_site) {
+  DCHECK_GT(starting_site->frame_count, 0u);
+  if (--starting_site->frame_count == 0)
+    starting_sites_.erase(starting_site->origin.spec());
+}
+
+void TrackingProtectionService::RecordStartingSiteLookup() const {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (starting_site_lookups_start_.is_null())
+    starting_site_lookups_start_ = now;
+  starting_site_lookups_++;
+
+  const base::TimeDelta elapsed = now - starting_site_lookups_start_;
+  if (elapsed < base::TimeDelta::FromMinutes(1))
+    return;
+  // Visible in chrome://histograms.
+  LOCAL_HISTOGRAM_COUNTS_100000(
+      "Brave.TrackingProtection.StartingSiteLookupsPerSecond",
+      starting_site_lookups_ / elapsed.InSeconds());
+  LOCAL_HISTOGRAM_COUNTS_100000(
+      "Brave.TrackingProtection.RenderFrameStartingSites",
+      render_frame_starting_sites_.size());
+  starting_site_lookups_ = 0;
+  starting_site_lookups_start_ = now;
 }
 
 void TrackingProtectionService::ModifyRenderFrameKey(int old_render_process_id,
@@ -93,20 +173,54 @@ void TrackingProtectionService::ModifyRenderFrameKey(int old_render_process_id,
                                                      int new_render_frame_id) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   const RenderFrameIdKey old_key(old_render_process_id, old_render_frame_id);
-  auto iter = render_frame_key_to_starting_site_url.find(old_key);
-  if (iter != render_frame_key_to_starting_site_url.end()) {
-    const RenderFrameIdKey new_key(new_render_process_id, new_render_frame_id);
-    render_frame_key_to_starting_site_url.insert(
-        std::pair<RenderFrameIdKey, GURL>(new_key, iter->second));
-    render_frame_key_to_starting_site_url.erase(old_key);
+  auto iter = render_frame_starting_sites_.Peek(old_key);
+  if (iter == render_frame_starting_sites_.end())
+    return;
+  StartingSite* starting_site = iter->second;
+  render_frame_starting_sites_.Erase(iter);
+
+  const RenderFrameIdKey new_key(new_render_process_id, new_render_frame_id);
+  auto new_iter = render_frame_starting_sites_.Peek(new_key);
+  if (new_iter != render_frame_starting_sites_.end()) {
+    // Keep the existing entry, as std::map::insert used to.
+    ReleaseStartingSite(starting_site);
+    return;
   }
+  render_frame_starting_sites_.Put(new_key, starting_site);
+}
+
+void TrackingProtectionService::OnShieldsSettingsChanged() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  shields_settings_version_++;
 }
 
 void TrackingProtectionService::DeleteRenderFrameKey(int render_process_id,
                                                      int render_frame_id) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   const RenderFrameIdKey key(render_process_id, render_frame_id);
-  render_frame_key_to_starting_site_url.erase(key);
+  auto iter = render_frame_starting_sites_.Peek(key);
+  if (iter == render_frame_starting_sites_.end())
+    return;
+  ReleaseStartingSite(iter->second);
+  render_frame_starting_sites_.Erase(iter);
+}
+
+bool TrackingProtectionService::BlocksStorageTrackers(
+    HostContentSettingsMap* map,
+    const StartingSite& starting_site) const {
+  if (starting_site.decision_map != map ||
+      starting_site.decision_version != shields_settings_version_) {
+    starting_site.blocks_storage_trackers =
+        IsAllowContentSetting(map, starting_site.origin, GURL(),
+                              CONTENT_SETTINGS_TYPE_PLUGINS,
+                              brave_shields::kBraveShields) &&
+        !IsAllowContentSetting(map, starting_site.origin, GURL(),
+                               CONTENT_SETTINGS_TYPE_PLUGINS,
+                               brave_shields::kTrackers);
+    starting_site.decision_map = map;
+    starting_site.decision_version = shields_settings_version_;
+  }
+  return starting_site.blocks_storage_trackers;
 }
 
 bool TrackingProtectionService::ShouldStoreState(HostContentSettingsMap* map,
@@ -119,59 +233,57 @@ bool TrackingProtectionService::ShouldStoreState(HostContentSettingsMap* map,
     return true;
   }
 
-  if (first_party_storage_trackers_.empty()) {
+  if (!first_party_storage_trackers_) {
     LOG(INFO) << "First party storage trackers list is empty";
     return true;
   }
 
-  const std::string host = origin_url.host();
-  const GURL starting_site =
-      GetStartingSiteForRenderFrame(render_process_id, render_frame_id);
-
-  // If starting host is the current host, user-interaction has happened
-  // so we allow storage
-  if (starting_site.host() == host) {
+  const StartingSite* starting_site =
+      GetStartingSite(render_process_id, render_frame_id);
+  // Without a starting site shields can't be up for it, so allow storage.
+  if (!starting_site) {
     return true;
   }
 
-  const bool allow_brave_shields =
-      starting_site.is_empty()
-          ? false
-          : IsAllowContentSetting(map, starting_site, GURL(),
-                                  CONTENT_SETTINGS_TYPE_PLUGINS,
-                                  brave_shields::kBraveShields);
-
-  if (!allow_brave_shields) {
+  // If starting host is the current host, user-interaction has happened
+  // so we allow storage
+  const base::StringPiece host = origin_url.host_piece();
+  if (starting_site->origin.host_piece() == host) {
     return true;
   }
 
-  const bool allow_trackers =
-      starting_site.is_empty()
-          ? true
-          : IsAllowContentSetting(map, starting_site, GURL(),
-                                  CONTENT_SETTINGS_TYPE_PLUGINS,
-                                  brave_shields::kTrackers);
-
-  if (allow_trackers) {
+  if (!BlocksStorageTrackers(map, *starting_site)) {
     return true;
   }
 
   // deny storage if host is found in the tracker list
-  return first_party_storage_trackers_.find(host) ==
-         first_party_storage_trackers_.end();
+  return !first_party_storage_trackers_->Contains(host);
 }
 
-void TrackingProtectionService::OnGetSTPDATFileData(std::string contents) {
+// static
+std::unique_ptr<PerfectHashHostSet>
+TrackingProtectionService::LoadStorageTrackers(
+    const base::FilePath& install_dir) {
+  const base::FilePath dat_dir = install_dir.AppendASCII(kDatFileVersion);
+  const base::FilePath perfect_hash_path =
+      dat_dir.AppendASCII(kStorageTrackersPerfectHashFile);
+  if (base::PathExists(perfect_hash_path))
+    return PerfectHashHostSet::CreateFromFile(perfect_hash_path);
+
+  const std::string contents = brave_component_updater::GetDATFileAsString(
+      dat_dir.AppendASCII(kStorageTrackersFile));
   if (contents.empty()) {
     LOG(ERROR) << "Could not obtain first party trackers data";
-    return;
+    return nullptr;
   }
+  return PerfectHashHostSet::Build(
+      base::SplitStringPiece(contents, ",", base::TRIM_WHITESPACE,
+                             base::SPLIT_WANT_NONEMPTY));
+}
 
-  std::vector<std::string> storage_trackers =
-      base::SplitString(base::StringPiece(contents.data(), contents.size()),
-                        ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-
-  if (storage_trackers.empty()) {
+void TrackingProtectionService::OnStorageTrackersLoaded(
+    std::unique_ptr<PerfectHashHostSet> storage_trackers) {
+  if (!storage_trackers) {
     LOG(ERROR) << "No first party trackers found";
     return;
   }
@@ -185,9 +297,15 @@ void TrackingProtectionService::OnGetSTPDATFileData(std::string contents) {
 }
 
 void TrackingProtectionService::UpdateFirstPartyStorageTrackers(
-    std::vector<std::string> storage_trackers) {
-  first_party_storage_trackers_ =
-      base::flat_set<std::string>(std::move(storage_trackers));
+    std::unique_ptr<PerfectHashHostSet> storage_trackers) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  // Unmapping the previous set's file may block, so it is destroyed on the
+  // sequence it was loaded on rather than here.
+  if (first_party_storage_trackers_) {
+    load_task_runner_->DeleteSoon(FROM_HERE,
+                                  std::move(first_party_storage_trackers_));
+  }
+  first_party_storage_trackers_ = std::move(storage_trackers);
 }
 
 #endif
@@ -233,17 +351,14 @@ void TrackingProtectionService::OnComponentReady(
   if (!TrackingProtectionHelper::IsSmartTrackingProtectionEnabled()) {
     return;
   }
-  base::FilePath storage_tracking_protection_path = install_dir
-      .AppendASCII(kDatFileVersion)
-      .AppendASCII(kStorageTrackersFile);
-
-  base::PostTaskAndReplyWithResult(
-      local_data_files_service()->GetTaskRunner().get(),
-      FROM_HERE,
-      base::BindOnce(&brave_component_updater::GetDATFileAsString,
-                     storage_tracking_protection_path),
-      base::BindOnce(&TrackingProtectionService::OnGetSTPDATFileData,
-                     weak_factory_.GetWeakPtr()));
+  ComponentLoadScheduler::GetInstance()
+      ->ScheduleLoadWithResult<std::unique_ptr<PerfectHashHostSet>>(
+          "Tracking protection", ComponentLoadScheduler::Priority::kNormal,
+          base::BindOnce(&TrackingProtectionService::LoadStorageTrackers,
+                         install_dir),
+          base::BindOnce(&TrackingProtectionService::OnStorageTrackersLoaded,
+                         weak_factory_.GetWeakPtr()),
+          load_task_runner_);
 #endif
 }
 
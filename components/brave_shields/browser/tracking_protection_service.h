@@ -6,20 +6,25 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_TRACKING_PROTECTION_SERVICE_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_TRACKING_PROTECTION_SERVICE_H_
 
+#include <stdint.h>
+
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "base/containers/flat_set.h"
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequenced_task_runner.h"
 #include "base/synchronization/lock.h"
+#include "base/time/time.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
 #include "brave/components/brave_shields/browser/buildflags/buildflags.h"  // For STP
+#include "brave/components/brave_shields/browser/perfect_hash_host_set.h"
 #include "content/public/common/resource_type.h"
 #include "url/gurl.h"
 
@@ -74,22 +79,37 @@ class TrackingProtectionService : public LocalDataFilesObserver {
   void SetStartingSiteForRenderFrame(GURL starting_site,
                                      int render_process_id,
                                      int render_frame_id);
-  GURL GetStartingSiteForRenderFrame(int render_process_id,
-                                     int render_frame_id) const;
+  // Returns the origin of the starting site, or an empty GURL if none is
+  // known for the frame.
+  const GURL& GetStartingSiteForRenderFrame(int render_process_id,
+                                            int render_frame_id) const;
+
+  // Invalidates the shields decisions cached for starting sites.
+  void OnShieldsSettingsChanged();
 
   void DeleteRenderFrameKey(int render_process_id, int render_frame_id);
   void ModifyRenderFrameKey(int old_render_process_id,
                             int old_render_frame_id,
                             int new_render_process_id,
                             int new_render_frame_id);
+
+  size_t render_frame_count() const {
+    return render_frame_starting_sites_.size();
+  }
+  size_t starting_site_count() const { return starting_sites_.size(); }
 #endif
 
  protected:
 #if BUILDFLAG(BRAVE_STP_ENABLED)
-  // ParseStorageTrackersData parses the storage trackers list provided by
-  // the offline-crawler
-  void OnGetSTPDATFileData(std::string contents);
-  void UpdateFirstPartyStorageTrackers(std::vector<std::string>);
+  // Loads the storage trackers list provided by the offline-crawler. A
+  // prebuilt perfect hash table is memory mapped if the component ships one,
+  // otherwise the comma-separated list is converted on load.
+  static std::unique_ptr<PerfectHashHostSet> LoadStorageTrackers(
+      const base::FilePath& install_dir);
+  void OnStorageTrackersLoaded(
+      std::unique_ptr<PerfectHashHostSet> storage_trackers);
+  void UpdateFirstPartyStorageTrackers(
+      std::unique_ptr<PerfectHashHostSet> storage_trackers);
 
   // For Smart Tracking Protection, we need to keep track of the starting site
   // that initiated the redirects. We use RenderFrameIdKey to determine the
@@ -104,12 +124,59 @@ class TrackingProtectionService : public LocalDataFilesObserver {
     bool operator<(const RenderFrameIdKey& other) const;
     bool operator==(const RenderFrameIdKey& other) const;
   };
+
+  struct RenderFrameIdKeyHash {
+    size_t operator()(const RenderFrameIdKey& key) const;
+  };
+
+  // Starting sites are interned by origin: all frames that started on the
+  // same site share one entry, which also caches the shields decision for
+  // that site.
+  struct StartingSite {
+    explicit StartingSite(const GURL& origin);
+    ~StartingSite();
+
+    const GURL origin;
+    // Number of frames in |render_frame_starting_sites_| pointing here.
+    size_t frame_count = 0;
+    // Cached result of the shields and trackers content settings lookups
+    // for |origin| in |decision_map|, valid while |decision_version| matches
+    // |shields_settings_version_|.
+    mutable const HostContentSettingsMap* decision_map = nullptr;
+    mutable uint64_t decision_version = 0;
+    mutable bool blocks_storage_trackers = false;
+
+    DISALLOW_COPY_AND_ASSIGN(StartingSite);
+  };
+
+  // Upper bound on tracked frames, in case RenderFrameDeleted is missed.
+  // Once reached, the least recently navigated frames are dropped.
+  static const size_t kMaxRenderFrames = 10000;
 #endif
 
  private:
 #if BUILDFLAG(BRAVE_STP_ENABLED)
-  base::flat_set<std::string> first_party_storage_trackers_;
-  std::map<RenderFrameIdKey, GURL> render_frame_key_to_starting_site_url;
+  StartingSite* GetStartingSite(int render_process_id,
+                                int render_frame_id) const;
+  void ReleaseStartingSite(StartingSite* starting_site);
+  bool BlocksStorageTrackers(HostContentSettingsMap* map,
+                             const StartingSite& starting_site) const;
+  void RecordStartingSiteLookup() const;
+
+  std::unique_ptr<PerfectHashHostSet> first_party_storage_trackers_;
+  // Sequence the storage trackers are loaded and destroyed on.
+  scoped_refptr<base::SequencedTaskRunner> load_task_runner_;
+  // Keyed by origin spec. Entries are only erased once no frame uses them,
+  // and unordered_map never moves its elements, so frames can point at them.
+  std::unordered_map<std::string, StartingSite> starting_sites_;
+  base::HashingMRUCache<RenderFrameIdKey, StartingSite*, RenderFrameIdKeyHash>
+      render_frame_starting_sites_;
+  // Bumped whenever shields settings change, invalidating every cached
+  // starting site decision.
+  uint64_t shields_settings_version_ = 0;
+  // Lookup counter for the lookups-per-second histogram.
+  mutable size_t starting_site_lookups_ = 0;
+  mutable base::TimeTicks starting_site_lookups_start_;
 #endif
 
   std::vector<std::string> third_party_base_hosts_;
@@ -4,12 +4,14 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "base/path_service.h"
+#include "base/run_loop.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
 #include "brave/components/brave_shields/browser/buildflags/buildflags.h"  // For STP
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
@@ -25,6 +27,7 @@
 
 #if BUILDFLAG(BRAVE_STP_ENABLED)
 #include "brave/common/brave_switches.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/tracking_protection_helper.h"
 
 using brave_shields::TrackingProtectionHelper;
@@ -119,6 +122,10 @@ class TrackingProtectionServiceTest : public ExtensionBrowserTest {
   }
 
   void WaitForTrackingProtectionServiceThread() {
+    base::RunLoop run_loop;
+    brave_component_updater::ComponentLoadScheduler::GetInstance()
+        ->RunWhenIdleForTesting(run_loop.QuitClosure());
+    run_loop.Run();
     scoped_refptr<base::ThreadTestHelper> tr_helper(new base::ThreadTestHelper(
         g_brave_browser_process->local_data_files_service()->GetTaskRunner()));
     ASSERT_TRUE(tr_helper->Run());
@@ -238,6 +245,41 @@ IN_PROC_BROWSER_TEST_F(TrackingProtectionServiceTest, StorageTrackingAllowed) {
       &indexeddb_allowed));
 }
 
+IN_PROC_BROWSER_TEST_F(TrackingProtectionServiceTest,
+                       StorageTrackingAllowedAfterShieldsDown) {
+  ASSERT_TRUE(TrackingProtectionHelper::IsSmartTrackingProtectionEnabled());
+  ASSERT_TRUE(InstallTrackingProtectionExtension());
+
+  // tracker.com is in the StorageTrackingProtection list
+  const GURL tracking_url =
+      embedded_test_server()->GetURL("tracker.com", kStoragePage);
+
+  const GURL url = embedded_test_server()->GetURL(
+      "social.com", std::string(kRedirectPage) + tracking_url.spec());
+
+  ui_test_utils::NavigateToURLBlockUntilNavigationsComplete(browser(), url, 2);
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  EXPECT_EQ("tracker.com", contents->GetURL().host());
+
+  bool cookie_blocked;
+  ASSERT_TRUE(ExecuteScriptAndExtractBool(
+      contents, "window.domAutomationController.send(!IsCookieAvailable())",
+      &cookie_blocked));
+  EXPECT_TRUE(cookie_blocked);
+
+  // The decision cached for the starting site must not outlive the shields
+  // setting it was made from.
+  brave_shields::SetBraveShieldsEnabled(browser()->profile(), false, url);
+  WaitForTrackingProtectionServiceThread();
+
+  bool cookie_allowed;
+  ASSERT_TRUE(ExecuteScriptAndExtractBool(
+      contents, "window.domAutomationController.send(IsCookieAvailable())",
+      &cookie_allowed));
+  EXPECT_TRUE(cookie_allowed);
+}
+
 IN_PROC_BROWSER_TEST_F(TrackingProtectionServiceTest, CancelledNavigation) {
   ASSERT_TRUE(TrackingProtectionHelper::IsSmartTrackingProtectionEnabled());
   ASSERT_TRUE(InstallTrackingProtectionExtension());
@@ -8,6 +8,8 @@
 #include <memory>
 #include <string>
 
+#include "base/containers/flat_map.h"
+#include "base/no_destructor.h"
 #include "base/strings/strcat.h"
 #include "base/strings/string_util.h"
 #include "brave/common/extensions/extension_constants.h"
@@ -20,6 +22,14 @@
 
 namespace {
 
+webtorrent::TorrentRedirectCounters g_torrent_redirect_counters;
+
+base::flat_map<const extensions::InfoMap*, bool>& GetWebtorrentEnabledMap() {
+  static base::NoDestructor<base::flat_map<const extensions::InfoMap*, bool>>
+      webtorrent_enabled;
+  return *webtorrent_enabled;
+}
+
 bool FileNameMatched(const net::HttpResponseHeaders* headers) {
   std::string disposition;
   if (!headers->GetNormalizedHeader("Content-Disposition", &disposition)) {
@@ -71,8 +81,8 @@ bool IsTorrentFile(const GURL& url, const net::HttpResponseHeaders* headers) {
 }
 
 bool IsWebtorrentInitiated(std::shared_ptr<brave::BraveRequestInfo> ctx) {
-  return ctx->initiator_url.scheme() == extensions::kExtensionScheme &&
-      ctx->initiator_url.host() == brave_webtorrent_extension_id;
+  return ctx->initiator_url.SchemeIs(extensions::kExtensionScheme) &&
+      ctx->initiator_url.host_piece() == brave_webtorrent_extension_id;
 }
 
 /**
@@ -89,21 +99,51 @@ bool IsFrameResource(std::shared_ptr<brave::BraveRequestInfo> ctx) {
 
 namespace webtorrent {
 
+const TorrentRedirectCounters& GetTorrentRedirectCounters() {
+  return g_torrent_redirect_counters;
+}
+
+void ResetTorrentRedirectCountersForTesting() {
+  g_torrent_redirect_counters = TorrentRedirectCounters();
+}
+
+void SetWebtorrentEnabledOnIO(const extensions::InfoMap* info_map,
+                              bool enabled) {
+  GetWebtorrentEnabledMap()[info_map] = enabled;
+}
+
+void ClearWebtorrentEnabledOnIO(const extensions::InfoMap* info_map) {
+  GetWebtorrentEnabledMap().erase(info_map);
+}
+
+bool IsWebtorrentEnabledOnIO(const extensions::InfoMap* info_map) {
+  const auto& webtorrent_enabled = GetWebtorrentEnabledMap();
+  auto it = webtorrent_enabled.find(info_map);
+  return it != webtorrent_enabled.end() && it->second;
+}
+
 int OnHeadersReceived_TorrentRedirectWork(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
     GURL* allowed_unsafe_redirect_url,
     const brave::ResponseCallback& next_callback,
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  g_torrent_redirect_counters.responses++;
   if (!original_response_headers ||
       !IsFrameResource(ctx) ||
-      ctx->is_webtorrent_disabled ||
+      ctx->is_webtorrent_disabled) {
+    return net::OK;
+  }
+
+  g_torrent_redirect_counters.inspected++;
+  if (!IsTorrentFile(ctx->request_url, original_response_headers) ||
       // download .torrent, do not redirect
-      (IsWebtorrentInitiated(ctx) && !IsViewerURL(ctx->request_url)) ||
-      !IsTorrentFile(ctx->request_url, original_response_headers)) {
+      (IsWebtorrentInitiated(ctx) && !IsViewerURL(ctx->request_url))) {
     return net::OK;
   }
 
+  g_torrent_redirect_counters.redirected++;
+
   *override_response_headers =
     new net::HttpResponseHeaders(original_response_headers->raw_headers());
   (*override_response_headers)
@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_WEBTORRENT_BROWSER_NET_BRAVE_TORRENT_REDIRECT_NETWORK_DELEGATE_HELPER_H_
 #define BRAVE_COMPONENTS_BRAVE_WEBTORRENT_BROWSER_NET_BRAVE_TORRENT_REDIRECT_NETWORK_DELEGATE_HELPER_H_
 
+#include <stdint.h>
+
 #include <memory>
 
 #include "brave/browser/net/url_context.h"
@@ -14,12 +16,39 @@ namespace brave {
 struct BraveRequestInfo;
 }
 
+namespace extensions {
+class InfoMap;
+}
+
 namespace net {
 class URLRequest;
 }
 
 namespace webtorrent {
 
+// Counts of the responses OnHeadersReceived_TorrentRedirectWork has seen, only
+// accessed on the IO thread.
+struct TorrentRedirectCounters {
+  // All responses.
+  uint64_t responses = 0;
+  // Frame responses, with the extension enabled, whose MIME type was checked.
+  uint64_t inspected = 0;
+  // Responses redirected to the extension's viewer.
+  uint64_t redirected = 0;
+};
+
+const TorrentRedirectCounters& GetTorrentRedirectCounters();
+void ResetTorrentRedirectCountersForTesting();
+
+// Whether the WebTorrent extension is enabled for the profile that owns
+// |info_map|. The state is pushed from the UI thread when the extension is
+// loaded or unloaded, so that requests don't have to look the extension up in
+// the InfoMap. Profiles nothing was pushed for have it disabled.
+void SetWebtorrentEnabledOnIO(const extensions::InfoMap* info_map,
+                              bool enabled);
+void ClearWebtorrentEnabledOnIO(const extensions::InfoMap* info_map);
+bool IsWebtorrentEnabledOnIO(const extensions::InfoMap* info_map);
+
 int OnHeadersReceived_TorrentRedirectWork(
     const net::HttpResponseHeaders* original_response_headers,
     scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
@@ -20,6 +20,7 @@
 #include "content/public/common/resource_type.h"
 #include "content/public/test/mock_resource_context.h"
 #include "content/public/test/test_browser_thread_bundle.h"
+#include "extensions/browser/info_map.h"
 #include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
 #include "net/url_request/url_request_test_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -36,6 +37,7 @@ class BraveTorrentRedirectNetworkDelegateHelperTest: public testing::Test {
 
   void SetUp() override {
     context_->Init();
+    webtorrent::ResetTorrentRedirectCountersForTesting();
 
     torrent_url_ = GURL("https://webtorrent.io/torrents/sintel.torrent");
     torrent_viewer_url_ =
@@ -448,3 +450,75 @@ TEST_F(BraveTorrentRedirectNetworkDelegateHelperTest,
   EXPECT_EQ(allowed_unsafe_redirect_url, GURL::EmptyGURL());
   EXPECT_EQ(ret, net::OK);
 }
+
+TEST_F(BraveTorrentRedirectNetworkDelegateHelperTest, CountsResponses) {
+  net::TestDelegate test_delegate;
+  std::unique_ptr<net::URLRequest> request =
+      context()->CreateRequest(torrent_url(), net::IDLE, &test_delegate,
+                               TRAFFIC_ANNOTATION_FOR_TESTS);
+
+  scoped_refptr<net::HttpResponseHeaders> torrent_response_headers =
+    new net::HttpResponseHeaders(std::string());
+  torrent_response_headers->AddHeader(
+      base::StrCat({"Content-Type: ", kBittorrentMimeType}));
+  scoped_refptr<net::HttpResponseHeaders> html_response_headers =
+    new net::HttpResponseHeaders(std::string());
+  html_response_headers->AddHeader("Content-Type: text/html");
+
+  std::shared_ptr<brave::BraveRequestInfo>
+      brave_request_info(new brave::BraveRequestInfo());
+  brave::BraveRequestInfo::FillCTXFromRequest(request.get(),
+                                              brave_request_info);
+  brave::ResponseCallback callback;
+  scoped_refptr<net::HttpResponseHeaders> overwrite_response_headers;
+  GURL allowed_unsafe_redirect_url;
+
+  // Not a frame, the MIME type isn't looked at.
+  brave_request_info->resource_type = content::ResourceType::kXhr;
+  webtorrent::OnHeadersReceived_TorrentRedirectWork(
+      torrent_response_headers.get(), &overwrite_response_headers,
+      &allowed_unsafe_redirect_url, callback, brave_request_info);
+  EXPECT_EQ(1u, webtorrent::GetTorrentRedirectCounters().responses);
+  EXPECT_EQ(0u, webtorrent::GetTorrentRedirectCounters().inspected);
+
+  brave_request_info->resource_type = content::ResourceType::kMainFrame;
+  webtorrent::OnHeadersReceived_TorrentRedirectWork(
+      html_response_headers.get(), &overwrite_response_headers,
+      &allowed_unsafe_redirect_url, callback, brave_request_info);
+  EXPECT_EQ(2u, webtorrent::GetTorrentRedirectCounters().responses);
+  EXPECT_EQ(1u, webtorrent::GetTorrentRedirectCounters().inspected);
+  EXPECT_EQ(0u, webtorrent::GetTorrentRedirectCounters().redirected);
+
+  webtorrent::OnHeadersReceived_TorrentRedirectWork(
+      torrent_response_headers.get(), &overwrite_response_headers,
+      &allowed_unsafe_redirect_url, callback, brave_request_info);
+  EXPECT_EQ(3u, webtorrent::GetTorrentRedirectCounters().responses);
+  EXPECT_EQ(2u, webtorrent::GetTorrentRedirectCounters().inspected);
+  EXPECT_EQ(1u, webtorrent::GetTorrentRedirectCounters().redirected);
+
+  // The extension is disabled.
+  brave_request_info->is_webtorrent_disabled = true;
+  webtorrent::OnHeadersReceived_TorrentRedirectWork(
+      torrent_response_headers.get(), &overwrite_response_headers,
+      &allowed_unsafe_redirect_url, callback, brave_request_info);
+  EXPECT_EQ(4u, webtorrent::GetTorrentRedirectCounters().responses);
+  EXPECT_EQ(2u, webtorrent::GetTorrentRedirectCounters().inspected);
+  EXPECT_EQ(1u, webtorrent::GetTorrentRedirectCounters().redirected);
+}
+
+TEST_F(BraveTorrentRedirectNetworkDelegateHelperTest, WebtorrentEnabledOnIO) {
+  scoped_refptr<extensions::InfoMap> info_map(new extensions::InfoMap());
+  scoped_refptr<extensions::InfoMap> other_info_map(new extensions::InfoMap());
+  EXPECT_FALSE(webtorrent::IsWebtorrentEnabledOnIO(info_map.get()));
+
+  webtorrent::SetWebtorrentEnabledOnIO(info_map.get(), true);
+  EXPECT_TRUE(webtorrent::IsWebtorrentEnabledOnIO(info_map.get()));
+  EXPECT_FALSE(webtorrent::IsWebtorrentEnabledOnIO(other_info_map.get()));
+
+  webtorrent::SetWebtorrentEnabledOnIO(info_map.get(), false);
+  EXPECT_FALSE(webtorrent::IsWebtorrentEnabledOnIO(info_map.get()));
+
+  webtorrent::SetWebtorrentEnabledOnIO(info_map.get(), true);
+  webtorrent::ClearWebtorrentEnabledOnIO(info_map.get());
+  EXPECT_FALSE(webtorrent::IsWebtorrentEnabledOnIO(info_map.get()));
+}
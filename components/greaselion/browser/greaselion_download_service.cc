@@ -5,6 +5,7 @@
 
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -18,9 +19,11 @@
 #include "base/task/post_task.h"
 #include "base/task_runner_util.h"
 #include "brave/browser/brave_browser_process_impl.h"
+#include "brave/components/brave_component_updater/browser/component_load_scheduler.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 
+using brave_component_updater::ComponentLoadScheduler;
 using brave_component_updater::LocalDataFilesObserver;
 using brave_component_updater::LocalDataFilesService;
 
@@ -106,9 +109,10 @@ GreaselionRule::~GreaselionRule() = default;
 
 void GreaselionRule::AddScriptAfterLoad(std::unique_ptr<std::string> contents,
                                         bool did_load) {
-  if (did_load && contents)
-    scripts_.push_back(*contents);
-  else {
+  if (did_load && contents) {
+    scripts_.push_back(base::MakeRefCounted<GreaselionScript>(
+        base::UTF8ToUTF16(*contents)));
+  } else {
     all_scripts_loaded_successfully_ = false;
     LOG(ERROR) << "Could not load Greaselion script";
   }
@@ -131,17 +135,18 @@ bool GreaselionRule::PreconditionFulfilled(
   }
 }
 
-bool GreaselionRule::Matches(const GURL& url, GreaselionFeatures state) const {
+bool GreaselionRule::Matches(const GURL& url,
+                             const GreaselionFeatures& state) const {
   if (!PreconditionFulfilled(preconditions_.rewards_enabled,
-                             state[greaselion::REWARDS]))
+                             state.at(greaselion::REWARDS)))
     return false;
   if (!PreconditionFulfilled(preconditions_.twitter_tips_enabled,
-                             state[greaselion::TWITTER_TIPS]))
+                             state.at(greaselion::TWITTER_TIPS)))
     return false;
   return urls_.MatchesURL(url);
 }
 
-void GreaselionRule::Populate(std::vector<std::string>* scripts) const {
+void GreaselionRule::Populate(GreaselionScripts* scripts) const {
   scripts->insert(scripts->end(), scripts_.begin(), scripts_.end());
 }
 
@@ -159,6 +164,9 @@ GreaselionDownloadService::~GreaselionDownloadService() {}
 void GreaselionDownloadService::OnDATFileDataReady(std::string contents) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   rules_.clear();
+  rules_by_host_.clear();
+  rules_by_host_without_tld_.clear();
+  rules_for_any_host_.clear();
   if (contents.empty()) {
     LOG(ERROR) << "Could not obtain Greaselion configuration";
     return;
@@ -185,9 +193,76 @@ void GreaselionDownloadService::OnDATFileDataReady(std::string contents) {
     rule->Parse(preconditions_value, urls_value, scripts_value, install_dir_,
                 GetTaskRunner().get());
     rules_.push_back(std::move(rule));
+    IndexRule(rules_.size() - 1);
   }
 }
 
+void GreaselionDownloadService::IndexRule(size_t rule_index) {
+  for (const URLPattern& pattern : rules_[rule_index]->url_patterns()) {
+    std::vector<size_t>* bucket = nullptr;
+    if (pattern.match_all_urls() || pattern.host().empty())
+      bucket = &rules_for_any_host_;
+    else if (!pattern.match_effective_tld())
+      bucket = &rules_by_host_without_tld_[pattern.host()];
+    else
+      bucket = &rules_by_host_[pattern.host()];
+    // Rules are indexed in order, so the last entry is the only possible
+    // duplicate.
+    if (bucket->empty() || bucket->back() != rule_index)
+      bucket->push_back(rule_index);
+  }
+}
+
+void GreaselionDownloadService::AddCandidateRulesForHost(
+    const base::flat_map<std::string, std::vector<size_t>, std::less<>>&
+        rules_by_host,
+    base::StringPiece host,
+    std::vector<size_t>* rule_indices) const {
+  // Patterns may match subdomains, so look up every parent domain too.
+  while (!host.empty()) {
+    auto it = rules_by_host.find(host);
+    if (it != rules_by_host.end()) {
+      rule_indices->insert(rule_indices->end(), it->second.begin(),
+                           it->second.end());
+    }
+    size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+}
+
+void GreaselionDownloadService::GetCandidateRules(
+    const GURL& url,
+    std::vector<size_t>* rule_indices) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  rule_indices->clear();
+  rule_indices->insert(rule_indices->end(), rules_for_any_host_.begin(),
+                       rules_for_any_host_.end());
+
+  base::StringPiece host = url.host_piece();
+  AddCandidateRulesForHost(rules_by_host_, host, rule_indices);
+  if (!rules_by_host_without_tld_.empty()) {
+    // The TLD of |url| may span several labels (e.g. "co.uk"), so try every
+    // dot-separated prefix of the host. Matches() does the precise check.
+    for (size_t dot = host.find('.'); dot != base::StringPiece::npos;
+         dot = host.find('.', dot + 1)) {
+      AddCandidateRulesForHost(rules_by_host_without_tld_,
+                               host.substr(0, dot), rule_indices);
+    }
+  }
+
+  std::sort(rule_indices->begin(), rule_indices->end());
+  rule_indices->erase(std::unique(rule_indices->begin(), rule_indices->end()),
+                      rule_indices->end());
+  // rules() is handed out mutably, so don't trust the index if the rules
+  // were cleared behind our back.
+  rule_indices->erase(
+      std::lower_bound(rule_indices->begin(), rule_indices->end(),
+                       rules_.size()),
+      rule_indices->end());
+}
+
 void GreaselionDownloadService::OnRuleReady(
     GreaselionRule* rule,
     bool all_scripts_loaded_successfully) {
@@ -207,12 +282,13 @@ void GreaselionDownloadService::OnComponentReady(
   base::FilePath dat_file_path =
       install_dir.AppendASCII(kGreaselionConfigFileVersion)
           .AppendASCII(kGreaselionConfigFile);
-  base::PostTaskAndReplyWithResult(
-      GetTaskRunner().get(), FROM_HERE,
-      base::BindOnce(&brave_component_updater::GetDATFileAsString,
-                     dat_file_path),
-      base::BindOnce(&GreaselionDownloadService::OnDATFileDataReady,
-                     weak_factory_.GetWeakPtr()));
+  ComponentLoadScheduler::GetInstance()
+      ->ScheduleLoadWithResult<std::string>(
+          "Greaselion", ComponentLoadScheduler::Priority::kNormal,
+          base::BindOnce(&brave_component_updater::GetDATFileAsString,
+                         dat_file_path),
+          base::BindOnce(&GreaselionDownloadService::OnDATFileDataReady,
+                         weak_factory_.GetWeakPtr()));
 }
 
 std::vector<std::unique_ptr<GreaselionRule>>*
@@ -6,15 +6,18 @@
 #ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_DOWNLOAD_SERVICE_H_
 #define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_DOWNLOAD_SERVICE_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/sequence_checker.h"
 #include "base/sequenced_task_runner.h"
+#include "base/strings/string_piece.h"
 #include "base/values.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
@@ -49,8 +52,10 @@ class GreaselionRule {
              scoped_refptr<base::SequencedTaskRunner> task_runner);
   ~GreaselionRule();
 
-  bool Matches(const GURL& url, GreaselionFeatures state) const;
-  void Populate(std::vector<std::string>* scripts) const;
+  bool Matches(const GURL& url, const GreaselionFeatures& state) const;
+  void Populate(GreaselionScripts* scripts) const;
+
+  const extensions::URLPatternSet& url_patterns() const { return urls_; }
 
   // implementation of observers
   class Observer : public base::CheckedObserver {
@@ -75,7 +80,7 @@ class GreaselionRule {
   int pending_scripts_;
   bool all_scripts_loaded_successfully_;
   extensions::URLPatternSet urls_;
-  std::vector<std::string> scripts_;
+  GreaselionScripts scripts_;
   GreaselionPreconditions preconditions_;
   base::WeakPtrFactory<GreaselionRule> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(GreaselionRule);
@@ -94,6 +99,12 @@ class GreaselionDownloadService : public LocalDataFilesObserver,
   std::vector<std::unique_ptr<GreaselionRule>>* rules();
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
 
+  // Fills |rule_indices| with the indices in rules(), in ascending order, of
+  // the rules that have a URL pattern which could match the host of |url|.
+  // Callers still need to check GreaselionRule::Matches on each of them.
+  void GetCandidateRules(const GURL& url,
+                         std::vector<size_t>* rule_indices) const;
+
   // implementation of LocalDataFilesObserver
   void OnComponentReady(const std::string& component_id,
                         const base::FilePath& install_dir,
@@ -119,11 +130,24 @@ class GreaselionDownloadService : public LocalDataFilesObserver,
 
   void OnDATFileDataReady(std::string contents);
   void LoadOnTaskRunner();
+  void IndexRule(size_t rule_index);
+  void AddCandidateRulesForHost(
+      const base::flat_map<std::string, std::vector<size_t>, std::less<>>&
+          rules_by_host,
+      base::StringPiece host,
+      std::vector<size_t>* rule_indices) const;
 
   base::ObserverList<Observer> observers_;
   int pending_rules_;
   bool all_scripts_loaded_successfully_;
   std::vector<std::unique_ptr<GreaselionRule>> rules_;
+  // Indices into |rules_|, keyed by the host of the rule's URL patterns.
+  // Patterns with a wildcard TLD (e.g. "www.example.*") are keyed by their
+  // host without the TLD, and patterns matching any host are kept apart.
+  base::flat_map<std::string, std::vector<size_t>, std::less<>> rules_by_host_;
+  base::flat_map<std::string, std::vector<size_t>, std::less<>>
+      rules_by_host_without_tld_;
+  std::vector<size_t> rules_for_any_host_;
   base::FilePath install_dir_;
 
   SEQUENCE_CHECKER(sequence_checker_);
@@ -11,6 +11,8 @@
 #include <vector>
 
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string16.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "url/gurl.h"
 
@@ -25,12 +27,17 @@ enum GreaselionFeature {
 
 typedef std::map<GreaselionFeature, bool> GreaselionFeatures;
 
+// Script contents are converted to UTF-16 once, when the rule loads them, and
+// are then shared read-only with every frame they are injected into.
+typedef base::RefCountedData<base::string16> GreaselionScript;
+typedef std::vector<scoped_refptr<GreaselionScript>> GreaselionScripts;
+
 class GreaselionService : public KeyedService {
  public:
   GreaselionService() = default;
 
   virtual bool ScriptsFor(const GURL& primary_url,
-                          std::vector<std::string>* scripts) = 0;
+                          GreaselionScripts* scripts) = 0;
   virtual void SetFeatureEnabled(GreaselionFeature feature, bool enabled) = 0;
 
  private:
@@ -6,6 +6,9 @@
 #include "brave/components/greaselion/browser/greaselion_service_impl.h"
 
 #include <memory>
+#include <vector>
+
+#include "base/trace_event/trace_event.h"
 
 #include "brave/components/brave_rewards/common/pref_names.h"
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
@@ -22,12 +25,16 @@ GreaselionServiceImpl::GreaselionServiceImpl(
 GreaselionServiceImpl::~GreaselionServiceImpl() = default;
 
 bool GreaselionServiceImpl::ScriptsFor(const GURL& primary_url,
-                                       std::vector<std::string>* scripts) {
+                                       GreaselionScripts* scripts) {
+  TRACE_EVENT0("browser", "GreaselionServiceImpl::ScriptsFor");
   bool any = false;
   std::vector<std::unique_ptr<GreaselionRule>>* rules =
       download_service_->rules();
   scripts->clear();
-  for (const auto& rule : *rules) {
+  std::vector<size_t> candidate_rules;
+  download_service_->GetCandidateRules(primary_url, &candidate_rules);
+  for (size_t rule_index : candidate_rules) {
+    const GreaselionRule* rule = (*rules)[rule_index].get();
     if (rule->Matches(primary_url, state_)) {
       rule->Populate(scripts);
       any = true;
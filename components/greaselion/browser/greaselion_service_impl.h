@@ -25,7 +25,7 @@ class GreaselionServiceImpl : public GreaselionService {
 
   // GreaselionService overrides
   bool ScriptsFor(const GURL& primary_url,
-                  std::vector<std::string>* scripts) override;
+                  GreaselionScripts* scripts) override;
   void SetFeatureEnabled(GreaselionFeature feature, bool enabled) override;
 
  private:
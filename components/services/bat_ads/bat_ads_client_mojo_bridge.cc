@@ -11,6 +11,9 @@
 
 #include "base/containers/flat_map.h"
 #include "base/logging.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/metrics/histogram_macros_local.h"
+#include "base/time/time.h"
 #include "mojo/public/cpp/bindings/interface_request.h"
 #include "mojo/public/cpp/bindings/sync_call_restrictions.h"
 
@@ -18,6 +21,9 @@ namespace bat_ads {
 
 namespace {
 
+constexpr base::TimeDelta kSyncCallReportInterval =
+    base::TimeDelta::FromMinutes(1);
+
 int32_t ToMojomURLRequestMethod(
     ads::URLRequestMethod method) {
   return (int32_t)method;
@@ -69,52 +75,93 @@ class LogStreamImpl : public ads::LogStream {
 }  // namespace
 
 BatAdsClientMojoBridge::BatAdsClientMojoBridge(
-    mojom::BatAdsClientAssociatedPtrInfo client_info) {
+    mojom::BatAdsClientAssociatedPtrInfo client_info)
+    : sync_call_count_(0),
+      local_call_count_(0) {
   bat_ads_client_.Bind(std::move(client_info));
 }
 
 BatAdsClientMojoBridge::~BatAdsClientMojoBridge() {}
 
+void BatAdsClientMojoBridge::SetSettings(mojom::AdsSettingsPtr settings) {
+  DCHECK(settings);
+
+  if (settings_ && settings->version <= settings_->version)
+    return;
+
+  settings_ = std::move(settings);
+}
+
 bool BatAdsClientMojoBridge::IsAdsEnabled() const {
+  if (settings_) {
+    RecordCall(false);
+    return settings_->is_ads_enabled;
+  }
+
   if (!connected())
     return false;
 
+  RecordCall(true);
   bool is_enabled;
   bat_ads_client_->IsAdsEnabled(&is_enabled);
   return is_enabled;
 }
 
 bool BatAdsClientMojoBridge::IsForeground() const {
+  if (settings_) {
+    RecordCall(false);
+    return settings_->is_foreground;
+  }
+
   if (!connected())
     return false;
 
+  RecordCall(true);
   bool is_foreground;
   bat_ads_client_->IsForeground(&is_foreground);
   return is_foreground;
 }
 
 const std::string BatAdsClientMojoBridge::GetAdsLocale() const {
+  if (settings_) {
+    RecordCall(false);
+    return settings_->ads_locale;
+  }
+
   if (!connected())
     return "en-US";
 
+  RecordCall(true);
   std::string locale;
   bat_ads_client_->GetAdsLocale(&locale);
   return locale;
 }
 
 uint64_t BatAdsClientMojoBridge::GetAdsPerHour() const {
+  if (settings_) {
+    RecordCall(false);
+    return settings_->ads_per_hour;
+  }
+
   if (!connected())
     return 0;
 
+  RecordCall(true);
   uint64_t ads_per_hour;
   bat_ads_client_->GetAdsPerHour(&ads_per_hour);
   return ads_per_hour;
 }
 
 uint64_t BatAdsClientMojoBridge::GetAdsPerDay() const {
+  if (settings_) {
+    RecordCall(false);
+    return settings_->ads_per_day;
+  }
+
   if (!connected())
     return 0;
 
+  RecordCall(true);
   uint64_t ads_per_day;
   bat_ads_client_->GetAdsPerDay(&ads_per_day);
   return ads_per_day;
@@ -124,15 +171,22 @@ void BatAdsClientMojoBridge::GetClientInfo(ads::ClientInfo* info) const {
   if (!connected())
     return;
 
+  RecordCall(true);
   std::string out_info_json;
   bat_ads_client_->GetClientInfo(info->ToJson(), &out_info_json);
   info->FromJson(out_info_json);
 }
 
 const std::vector<std::string> BatAdsClientMojoBridge::GetLocales() const {
+  if (settings_) {
+    RecordCall(false);
+    return settings_->locales;
+  }
+
   if (!connected())
     return std::vector<std::string>();
 
+  RecordCall(true);
   std::vector<std::string> locales;
   bat_ads_client_->GetLocales(&locales);
   return locales;
@@ -173,6 +227,7 @@ uint32_t BatAdsClientMojoBridge::SetTimer(const uint64_t time_offset) {
   if (!connected())
     return 0;
 
+  RecordCall(true);
   uint32_t timer_id;
   bat_ads_client_->SetTimer(time_offset, &timer_id);
   return timer_id;
@@ -267,6 +322,7 @@ const std::string BatAdsClientMojoBridge::LoadJsonSchema(
   if (!connected())
     return "{}";
 
+  RecordCall(true);
   std::string json;
   bat_ads_client_->LoadJsonSchema(name, &json);
   return json;
@@ -358,36 +414,69 @@ void BatAdsClientMojoBridge::SetIdleThreshold(const int threshold) {
 }
 
 bool BatAdsClientMojoBridge::IsNotificationsAvailable() const {
+  if (settings_) {
+    RecordCall(false);
+    return settings_->is_notifications_available;
+  }
+
   if (!connected())
     return false;
 
+  RecordCall(true);
   bool available;
   bat_ads_client_->IsNotificationsAvailable(&available);
   return available;
 }
 
-void OnLoadUserModelForLocale(const ads::OnLoadCallback& callback,
+void OnLoadUserModelForLocale(const ads::OnLoadUserModelCallback& callback,
+            base::TimeTicks start_ticks,
             int32_t result,
-            const std::string& value) {
-  callback(ToAdsResult(result), value);
+            base::ReadOnlySharedMemoryRegion user_model) {
+  if (ToAdsResult(result) != ads::Result::SUCCESS) {
+    callback(ads::Result::FAILED, nullptr, 0);
+    return;
+  }
+
+  base::ReadOnlySharedMemoryMapping mapping = user_model.Map();
+  if (!mapping.IsValid()) {
+    callback(ads::Result::FAILED, nullptr, 0);
+    return;
+  }
+
+  LOCAL_HISTOGRAM_TIMES("Brave.Ads.UserModelHandoffTime",
+                        base::TimeTicks::Now() - start_ticks);
+  LOCAL_HISTOGRAM_COUNTS_100000("Brave.Ads.UserModelHandoffKB",
+                                mapping.size() / 1024);
+
+  // The ads library reads the model straight from the mapping, which is
+  // unmapped when this returns
+  callback(ads::Result::SUCCESS, static_cast<const char*>(mapping.memory()),
+           mapping.size());
 }
 
 void BatAdsClientMojoBridge::LoadUserModelForLocale(
     const std::string& locale,
-    ads::OnLoadCallback callback) const {
+    ads::OnLoadUserModelCallback callback) const {
   if (!connected()) {
-    callback(ads::Result::FAILED, "");
+    callback(ads::Result::FAILED, nullptr, 0);
     return;
   }
 
   bat_ads_client_->LoadUserModelForLocale(locale,
-      base::BindOnce(&OnLoadUserModelForLocale, std::move(callback)));
+      base::BindOnce(&OnLoadUserModelForLocale, std::move(callback),
+                     base::TimeTicks::Now()));
 }
 
 bool BatAdsClientMojoBridge::IsNetworkConnectionAvailable() {
+  if (settings_) {
+    RecordCall(false);
+    return settings_->is_network_connection_available;
+  }
+
   if (!connected())
     return false;
 
+  RecordCall(true);
   bool available;
   bat_ads_client_->IsNetworkConnectionAvailable(&available);
   return available;
@@ -397,4 +486,29 @@ bool BatAdsClientMojoBridge::connected() const {
   return bat_ads_client_.is_bound();
 }
 
+void BatAdsClientMojoBridge::RecordCall(bool is_sync) const {
+  if (is_sync)
+    sync_call_count_++;
+  else
+    local_call_count_++;
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (sync_call_window_start_.is_null()) {
+    sync_call_window_start_ = now;
+    return;
+  }
+
+  if (now - sync_call_window_start_ < kSyncCallReportInterval)
+    return;
+
+  // Before the settings were mirrored every one of these calls was a sync IPC
+  VLOG(1) << sync_call_count_ << " sync IPCs to the browser in the last "
+          << "minute, " << sync_call_count_ + local_call_count_ << " without "
+          << "the settings mirror";
+
+  sync_call_count_ = 0;
+  local_call_count_ = 0;
+  sync_call_window_start_ = now;
+}
+
 }  // namespace bat_ads
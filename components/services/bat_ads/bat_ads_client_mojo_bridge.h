@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "base/time/time.h"
 #include "bat/ads/ads_client.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 
@@ -21,6 +22,9 @@ class BatAdsClientMojoBridge : public ads::AdsClient {
       mojom::BatAdsClientAssociatedPtrInfo client_info);
   ~BatAdsClientMojoBridge() override;
 
+  // Replaces the settings mirror with a newer snapshot from the browser.
+  void SetSettings(mojom::AdsSettingsPtr settings);
+
   // AdsClient implementation
   bool IsAdsEnabled() const override;
   bool IsForeground() const override;
@@ -65,13 +69,22 @@ class BatAdsClientMojoBridge : public ads::AdsClient {
   bool IsNotificationsAvailable() const override;
   void LoadUserModelForLocale(
       const std::string& locale,
-      ads::OnLoadCallback callback) const override;
+      ads::OnLoadUserModelCallback callback) const override;
   bool IsNetworkConnectionAvailable() override;
 
  private:
   bool connected() const;
 
+  // Counts calls to the browser which block on a sync IPC, and those which
+  // were answered from |settings_| instead, and logs both once a minute.
+  void RecordCall(bool is_sync) const;
+
   mojom::BatAdsClientAssociatedPtr bat_ads_client_;
+  mojom::AdsSettingsPtr settings_;
+
+  mutable uint64_t sync_call_count_;
+  mutable uint64_t local_call_count_;
+  mutable base::TimeTicks sync_call_window_start_;
 
   DISALLOW_COPY_AND_ASSIGN(BatAdsClientMojoBridge);
 };
@@ -51,6 +51,10 @@ void BatAdsImpl::OnInitialize(
   delete holder;
 }
 
+void BatAdsImpl::OnSettingsChanged(mojom::AdsSettingsPtr settings) {
+  bat_ads_client_mojo_proxy_->SetSettings(std::move(settings));
+}
+
 void BatAdsImpl::Shutdown(ShutdownCallback callback) {
   auto* holder = new CallbackHolder<ShutdownCallback>(AsWeakPtr(),
       std::move(callback));
@@ -34,6 +34,7 @@ class BatAdsImpl :
 
   // Overridden from mojom::BatAds:
   void Initialize(InitializeCallback callback) override;
+  void OnSettingsChanged(mojom::AdsSettingsPtr settings) override;
   void Shutdown(ShutdownCallback callback) override;
   void SetConfirmationsIsReady(const bool is_ready) override;
   void ChangeLocale(const std::string& locale) override;
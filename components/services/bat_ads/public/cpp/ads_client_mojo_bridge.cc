@@ -42,8 +42,11 @@ int32_t ToMojomResult(ads::Result result) {
 
 }  // namespace
 
-AdsClientMojoBridge::AdsClientMojoBridge(ads::AdsClient* ads_client)
-    : ads_client_(ads_client) {}
+AdsClientMojoBridge::AdsClientMojoBridge(
+    ads::AdsClient* ads_client,
+    LoadUserModelRegionCallback load_user_model_region)
+    : ads_client_(ads_client),
+      load_user_model_region_(std::move(load_user_model_region)) {}
 
 AdsClientMojoBridge::~AdsClientMojoBridge() {}
 
@@ -223,24 +226,19 @@ void AdsClientMojoBridge::Reset(const std::string& name,
   ads_client_->Reset(name, std::bind(AdsClientMojoBridge::OnReset, holder, _1));
 }
 
-// static
-void AdsClientMojoBridge::OnLoadUserModelForLocale(
-    CallbackHolder<LoadUserModelForLocaleCallback>* holder,
-    ads::Result result,
-    const std::string& value) {
-  if (holder->is_valid())
-    std::move(holder->get()).Run(ToMojomResult(result), std::move(value));
-  delete holder;
-}
-
 void AdsClientMojoBridge::LoadUserModelForLocale(
     const std::string& locale,
     LoadUserModelForLocaleCallback callback) {
-  // this gets deleted in OnLoadUserModelForLocale
-  auto* holder = new CallbackHolder<LoadUserModelForLocaleCallback>(
-      AsWeakPtr(), std::move(callback));
-  ads_client_->LoadUserModelForLocale(locale,
-      std::bind(AdsClientMojoBridge::OnLoadUserModelForLocale, holder, _1, _2));
+  base::ReadOnlySharedMemoryRegion user_model =
+      load_user_model_region_.Run(locale);
+  if (!user_model.IsValid()) {
+    std::move(callback).Run(ToMojomResult(ads::Result::FAILED),
+                            base::ReadOnlySharedMemoryRegion());
+    return;
+  }
+
+  std::move(callback).Run(ToMojomResult(ads::Result::SUCCESS),
+                          std::move(user_model));
 }
 
 // static
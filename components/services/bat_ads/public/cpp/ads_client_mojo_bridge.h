@@ -11,6 +11,8 @@
 #include <utility>
 #include <vector>
 
+#include "base/callback.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/weak_ptr.h"
 #include "bat/ads/ads_client.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
@@ -21,7 +23,16 @@ namespace bat_ads {
 class AdsClientMojoBridge : public mojom::BatAdsClient,
                          public base::SupportsWeakPtr<AdsClientMojoBridge> {
  public:
-  explicit AdsClientMojoBridge(ads::AdsClient* ads_client);
+  // Returns the user model for a locale in a shared memory region, or an
+  // invalid region if it can't be loaded. Used instead of
+  // ads::AdsClient::LoadUserModelForLocale() so that the model isn't
+  // serialized into the mojo reply.
+  using LoadUserModelRegionCallback =
+      base::RepeatingCallback<base::ReadOnlySharedMemoryRegion(
+          const std::string& locale)>;
+
+  AdsClientMojoBridge(ads::AdsClient* ads_client,
+                      LoadUserModelRegionCallback load_user_model_region);
   ~AdsClientMojoBridge() override;
 
   // Overridden from BatAdsClient:
@@ -103,10 +114,6 @@ class AdsClientMojoBridge : public mojom::BatAdsClient,
                      ads::Result result);
   static void OnReset(CallbackHolder<ResetCallback>* holder,
                       ads::Result result);
-  static void OnLoadUserModelForLocale(
-      CallbackHolder<LoadUserModelForLocaleCallback>* holder,
-      ads::Result result,
-      const std::string& value);
   static void OnURLRequest(CallbackHolder<URLRequestCallback>* holder,
                            const int status_code,
                            const std::string& content,
@@ -126,6 +133,7 @@ class AdsClientMojoBridge : public mojom::BatAdsClient,
 
 
   ads::AdsClient* ads_client_;
+  LoadUserModelRegionCallback load_user_model_region_;
 
   DISALLOW_COPY_AND_ASSIGN(AdsClientMojoBridge);
 };
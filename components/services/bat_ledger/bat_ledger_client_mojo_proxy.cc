@@ -5,18 +5,26 @@
 
 #include "brave/components/services/bat_ledger/bat_ledger_client_mojo_proxy.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/guid.h"
 #include "base/logging.h"
 #include "mojo/public/cpp/bindings/map.h"
+#include "net/base/escape.h"
+
+using std::placeholders::_1;
+using std::placeholders::_2;
 
 namespace bat_ledger {
 
 namespace {
 
+constexpr base::TimeDelta kSyncCallReportInterval =
+    base::TimeDelta::FromMinutes(1);
 
 int32_t ToMojomPublisherCategory(ledger::REWARDS_CATEGORY category) {
   return (int32_t)category;
@@ -83,6 +91,12 @@ void OnResetState(const ledger::OnSaveCallback& callback,
   callback(result);
 }
 
+void OnFinishTemporaryStateFile(ledger::Result error_result,
+                                const ledger::OnSaveCallback& callback,
+                                bool success) {
+  callback(success ? ledger::Result::LEDGER_OK : error_result);
+}
+
 void OnGetExternalWallets(
     ledger::GetExternalWalletsCallback callback,
     base::flat_map<std::string, ledger::ExternalWalletPtr> wallets) {
@@ -92,7 +106,9 @@ void OnGetExternalWallets(
 }  // namespace
 
 BatLedgerClientMojoProxy::BatLedgerClientMojoProxy(
-    mojom::BatLedgerClientAssociatedPtrInfo client_info) {
+    mojom::BatLedgerClientAssociatedPtrInfo client_info)
+    : sync_call_count_(0),
+      local_call_count_(0) {
   bat_ledger_client_.Bind(std::move(client_info));
 }
 
@@ -100,12 +116,8 @@ BatLedgerClientMojoProxy::~BatLedgerClientMojoProxy() {
 }
 
 std::string BatLedgerClientMojoProxy::GenerateGUID() const {
-  if (!Connected())
-    return "";
-
-  std::string guid;
-  bat_ledger_client_->GenerateGUID(&guid);
-  return guid;
+  RecordCall(false);
+  return base::GenerateGUID();
 }
 
 void OnLoadURL(const ledger::LoadURLCallback& callback,
@@ -192,117 +204,133 @@ void BatLedgerClientMojoProxy::OnGrantFinish(ledger::Result result,
   bat_ledger_client_->OnGrantFinish(result, std::move(grant));
 }
 
-void BatLedgerClientMojoProxy::OnLoadLedgerState(
-    ledger::OnLoadCallback callback,
-    const ledger::Result result,
-    const std::string& data) {
-  callback(result, data);
+void BatLedgerClientMojoProxy::LoadLedgerState(
+    ledger::OnLoadCallback callback) {
+  LoadStateFile(mojom::LedgerStateFile::LEDGER_STATE,
+      ledger::Result::NO_LEDGER_STATE, std::move(callback));
 }
 
-void BatLedgerClientMojoProxy::LoadLedgerState(
+void BatLedgerClientMojoProxy::LoadPublisherState(
     ledger::OnLoadCallback callback) {
-  if (!Connected()) {
-    callback(ledger::Result::LEDGER_ERROR, "");
-    return;
-  }
+  LoadStateFile(mojom::LedgerStateFile::PUBLISHER_STATE,
+      ledger::Result::NO_PUBLISHER_STATE, std::move(callback));
+}
 
-  bat_ledger_client_->LoadLedgerState(
-      base::BindOnce(&BatLedgerClientMojoProxy::OnLoadLedgerState, AsWeakPtr(),
-        std::move(callback)));
+void BatLedgerClientMojoProxy::LoadPublisherList(
+    ledger::LedgerCallbackHandler* handler) {
+  LoadStateFile(mojom::LedgerStateFile::PUBLISHER_LIST,
+      ledger::Result::NO_PUBLISHER_LIST,
+      std::bind(&ledger::LedgerCallbackHandler::OnPublisherListLoaded,
+          handler, _1, _2));
 }
 
-void BatLedgerClientMojoProxy::OnLoadPublisherState(
-    ledger::OnLoadCallback callback,
-    const ledger::Result result,
-    const std::string& data) {
-  callback(result, data);
+void BatLedgerClientMojoProxy::SaveLedgerState(
+    const std::string& ledger_state, ledger::LedgerCallbackHandler* handler) {
+  SaveStateFile(mojom::LedgerStateFile::LEDGER_STATE, ledger_state,
+      ledger::Result::NO_LEDGER_STATE,
+      std::bind(&ledger::LedgerCallbackHandler::OnLedgerStateSaved,
+          handler, _1));
 }
 
-void BatLedgerClientMojoProxy::LoadPublisherState(
+void BatLedgerClientMojoProxy::SavePublisherState(
+    const std::string& publisher_state,
+    ledger::LedgerCallbackHandler* handler) {
+  SaveStateFile(mojom::LedgerStateFile::PUBLISHER_STATE, publisher_state,
+      ledger::Result::LEDGER_ERROR,
+      std::bind(&ledger::LedgerCallbackHandler::OnPublisherStateSaved,
+          handler, _1));
+}
+
+void BatLedgerClientMojoProxy::SavePublishersList(
+    const std::string& publishers_list,
+    ledger::LedgerCallbackHandler* handler) {
+  SaveStateFile(mojom::LedgerStateFile::PUBLISHER_LIST, publishers_list,
+      ledger::Result::LEDGER_ERROR,
+      std::bind(&ledger::LedgerCallbackHandler::OnPublishersListSaved,
+          handler, _1));
+}
+
+void BatLedgerClientMojoProxy::LoadStateFile(
+    mojom::LedgerStateFile state_file,
+    ledger::Result missing_result,
     ledger::OnLoadCallback callback) {
   if (!Connected()) {
     callback(ledger::Result::LEDGER_ERROR, "");
     return;
   }
 
-  bat_ledger_client_->LoadPublisherState(
-      base::BindOnce(&BatLedgerClientMojoProxy::OnLoadPublisherState,
-        AsWeakPtr(), std::move(callback)));
+  bat_ledger_client_->OpenStateFile(state_file,
+      base::BindOnce(&BatLedgerClientMojoProxy::OnOpenStateFile, AsWeakPtr(),
+        missing_result, std::move(callback)));
 }
 
-void BatLedgerClientMojoProxy::OnLoadPublisherList(
-    ledger::LedgerCallbackHandler* handler,
-    const ledger::Result result,
-    const std::string& data) {
-  handler->OnPublisherListLoaded(result, data);
-}
-
-void BatLedgerClientMojoProxy::LoadPublisherList(
-    ledger::LedgerCallbackHandler* handler) {
-  if (!Connected()) {
-    handler->OnPublisherListLoaded(ledger::Result::LEDGER_ERROR, "");
+void BatLedgerClientMojoProxy::OnOpenStateFile(
+    ledger::Result missing_result,
+    ledger::OnLoadCallback callback,
+    base::File file) {
+  if (!file.IsValid()) {
+    callback(missing_result, "");
     return;
   }
 
-  bat_ledger_client_->LoadPublisherList(
-      base::BindOnce(&BatLedgerClientMojoProxy::OnLoadPublisherList,
-        AsWeakPtr(), base::Unretained(handler)));
+  state_file_task_runner_.Read(std::move(file),
+      base::BindOnce(&BatLedgerClientMojoProxy::OnReadStateFile, AsWeakPtr(),
+        missing_result, std::move(callback)));
 }
 
-void BatLedgerClientMojoProxy::OnSaveLedgerState(
-    ledger::LedgerCallbackHandler* handler,
-    const ledger::Result result) {
-  handler->OnLedgerStateSaved(result);
+void BatLedgerClientMojoProxy::OnReadStateFile(
+    ledger::Result missing_result,
+    ledger::OnLoadCallback callback,
+    const std::string& data) {
+  callback(data.empty() ? missing_result : ledger::Result::LEDGER_OK, data);
 }
 
-void BatLedgerClientMojoProxy::SaveLedgerState(
-    const std::string& ledger_state, ledger::LedgerCallbackHandler* handler) {
+void BatLedgerClientMojoProxy::SaveStateFile(
+    mojom::LedgerStateFile state_file,
+    const std::string& data,
+    ledger::Result error_result,
+    ledger::OnSaveCallback callback) {
   if (!Connected()) {
-    handler->OnLedgerStateSaved(ledger::Result::LEDGER_ERROR);
+    callback(ledger::Result::LEDGER_ERROR);
     return;
   }
 
-  bat_ledger_client_->SaveLedgerState(ledger_state,
-      base::BindOnce(&BatLedgerClientMojoProxy::OnSaveLedgerState,
-        AsWeakPtr(), base::Unretained(handler)));
-}
-
-void BatLedgerClientMojoProxy::OnSavePublisherState(
-    ledger::LedgerCallbackHandler* handler,
-    const ledger::Result result) {
-  handler->OnPublisherStateSaved(result);
+  bat_ledger_client_->CreateTemporaryStateFile(state_file,
+      base::BindOnce(&BatLedgerClientMojoProxy::OnCreateTemporaryStateFile,
+        AsWeakPtr(), data, error_result, std::move(callback)));
 }
 
-void BatLedgerClientMojoProxy::SavePublisherState(
-    const std::string& publisher_state,
-    ledger::LedgerCallbackHandler* handler) {
-  if (!Connected()) {
-    handler->OnPublisherStateSaved(ledger::Result::LEDGER_ERROR);
+void BatLedgerClientMojoProxy::OnCreateTemporaryStateFile(
+    std::string data,
+    ledger::Result error_result,
+    ledger::OnSaveCallback callback,
+    base::File file,
+    uint64_t token) {
+  if (!file.IsValid()) {
+    callback(error_result);
     return;
   }
 
-  bat_ledger_client_->SavePublisherState(publisher_state,
-      base::BindOnce(&BatLedgerClientMojoProxy::OnSavePublisherState,
-        AsWeakPtr(), base::Unretained(handler)));
+  // Written in the order the browser handed out the temporary files, so that
+  // overlapping saves of a state file replace it in the order they were made
+  state_file_task_runner_.Write(std::move(file), std::move(data),
+      base::BindOnce(&BatLedgerClientMojoProxy::OnWriteStateFile, AsWeakPtr(),
+        token, error_result, std::move(callback)));
 }
 
-void BatLedgerClientMojoProxy::OnSavePublishersList(
-    ledger::LedgerCallbackHandler* handler,
-    const ledger::Result result) {
-  handler->OnPublishersListSaved(result);
-}
-
-void BatLedgerClientMojoProxy::SavePublishersList(
-    const std::string& publishers_list,
-    ledger::LedgerCallbackHandler* handler) {
+void BatLedgerClientMojoProxy::OnWriteStateFile(
+    uint64_t token,
+    ledger::Result error_result,
+    ledger::OnSaveCallback callback,
+    bool success) {
   if (!Connected()) {
-    handler->OnPublishersListSaved(ledger::Result::LEDGER_ERROR);
+    callback(ledger::Result::LEDGER_ERROR);
     return;
   }
 
-  bat_ledger_client_->SavePublishersList(publishers_list,
-      base::BindOnce(&BatLedgerClientMojoProxy::OnSavePublishersList,
-        AsWeakPtr(), base::Unretained(handler)));
+  bat_ledger_client_->FinishTemporaryStateFile(token, success,
+      base::BindOnce(&OnFinishTemporaryStateFile, error_result,
+        std::move(callback)));
 }
 
 void OnSavePublisherInfo(
@@ -387,6 +415,7 @@ void BatLedgerClientMojoProxy::SetTimer(uint64_t time_offset,
     return;
   }
 
+  RecordCall(true);
   bat_ledger_client_->SetTimer(time_offset, timer_id);  // sync
 }
 
@@ -539,12 +568,8 @@ void BatLedgerClientMojoProxy::SaveMediaPublisherInfo(
 }
 
 std::string BatLedgerClientMojoProxy::URIEncode(const std::string& value) {
-  if (!Connected())
-    return "";
-
-  std::string encoded_value;
-  bat_ledger_client_->URIEncode(value, &encoded_value);
-  return encoded_value;
+  RecordCall(false);
+  return net::EscapeQueryParamValue(value, false);
 }
 
 void OnSavePendingContribution(
@@ -696,6 +721,7 @@ void BatLedgerClientMojoProxy::SetBooleanState(const std::string& name,
 
 bool BatLedgerClientMojoProxy::GetBooleanState(const std::string& name) const {
   bool value;
+  RecordCall(true);
   bat_ledger_client_->GetBooleanState(name, &value);
   return value;
 }
@@ -707,6 +733,7 @@ void BatLedgerClientMojoProxy::SetIntegerState(const std::string& name,
 
 int BatLedgerClientMojoProxy::GetIntegerState(const std::string& name) const {
   int value;
+  RecordCall(true);
   bat_ledger_client_->GetIntegerState(name, &value);
   return value;
 }
@@ -718,6 +745,7 @@ void BatLedgerClientMojoProxy::SetDoubleState(const std::string& name,
 
 double BatLedgerClientMojoProxy::GetDoubleState(const std::string& name) const {
   double value;
+  RecordCall(true);
   bat_ledger_client_->GetDoubleState(name, &value);
   return value;
 }
@@ -730,6 +758,7 @@ void BatLedgerClientMojoProxy::SetStringState(const std::string& name,
 std::string BatLedgerClientMojoProxy::
 GetStringState(const std::string& name) const {
   std::string value;
+  RecordCall(true);
   bat_ledger_client_->GetStringState(name, &value);
   return value;
 }
@@ -741,6 +770,7 @@ void BatLedgerClientMojoProxy::SetInt64State(const std::string& name,
 
 int64_t BatLedgerClientMojoProxy::GetInt64State(const std::string& name) const {
   int64_t value;
+  RecordCall(true);
   bat_ledger_client_->GetInt64State(name, &value);
   return value;
 }
@@ -753,6 +783,7 @@ void BatLedgerClientMojoProxy::SetUint64State(const std::string& name,
 uint64_t BatLedgerClientMojoProxy::GetUint64State(
     const std::string& name) const {
   uint64_t value;
+  RecordCall(true);
   bat_ledger_client_->GetUint64State(name, &value);
   return value;
 }
@@ -915,4 +946,30 @@ void BatLedgerClientMojoProxy::DeleteActivityInfo(
       base::BindOnce(&OnDeleteActivityInfo, std::move(callback)));
 }
 
+void BatLedgerClientMojoProxy::RecordCall(bool is_sync) const {
+  if (is_sync)
+    sync_call_count_++;
+  else
+    local_call_count_++;
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (sync_call_window_start_.is_null()) {
+    sync_call_window_start_ = now;
+    return;
+  }
+
+  if (now - sync_call_window_start_ < kSyncCallReportInterval)
+    return;
+
+  // Every call counted here used to block on the browser, so the sum is what
+  // the same minute cost before GUIDs and URI encoding were done locally
+  VLOG(1) << sync_call_count_ << " sync IPCs to the browser in the last "
+          << "minute, " << sync_call_count_ + local_call_count_ << " before "
+          << "answering locally";
+
+  sync_call_count_ = 0;
+  local_call_count_ = 0;
+  sync_call_window_start_ = now;
+}
+
 }  // namespace bat_ledger
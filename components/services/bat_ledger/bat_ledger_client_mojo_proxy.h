@@ -11,8 +11,11 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "bat/ledger/ledger_client.h"
+#include "brave/components/services/bat_ledger/public/cpp/ledger_state_file_util.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service.h"
 
@@ -21,6 +24,7 @@ class SkBitmap;
 namespace bat_ledger {
 
 class BatLedgerClientMojoProxy : public ledger::LedgerClient,
+                      public ledger::LedgerStateClient,
                       public base::SupportsWeakPtr<BatLedgerClientMojoProxy> {
  public:
   BatLedgerClientMojoProxy(
@@ -41,12 +45,6 @@ class BatLedgerClientMojoProxy : public ledger::LedgerClient,
                            const std::string& probi) override;
   void OnGrantFinish(ledger::Result result,
                      ledger::GrantPtr grant) override;
-  void LoadLedgerState(ledger::OnLoadCallback callback) override;
-  void LoadPublisherState(ledger::OnLoadCallback callback) override;
-  void SaveLedgerState(const std::string& ledger_state,
-                       ledger::LedgerCallbackHandler* handler) override;
-  void SavePublisherState(const std::string& publisher_state,
-                          ledger::LedgerCallbackHandler* handler) override;
 
   void SavePublisherInfo(ledger::PublisherInfoPtr publisher_info,
                          ledger::PublisherInfoCallback callback) override;
@@ -54,11 +52,8 @@ class BatLedgerClientMojoProxy : public ledger::LedgerClient,
                          ledger::PublisherInfoCallback callback) override;
   void LoadPanelPublisherInfo(ledger::ActivityInfoFilterPtr filter,
                               ledger::PublisherInfoCallback callback) override;
-  void SavePublishersList(const std::string& publishers_list,
-                          ledger::LedgerCallbackHandler* handler) override;
   void SetTimer(uint64_t time_offset, uint32_t* timer_id) override;
   void KillTimer(const uint32_t timer_id) override;
-  void LoadPublisherList(ledger::LedgerCallbackHandler* handler) override;
 
   void LoadURL(const std::string& url,
       const std::vector<std::string>& headers,
@@ -179,9 +174,24 @@ class BatLedgerClientMojoProxy : public ledger::LedgerClient,
       const std::string& publisher_key,
       ledger::DeleteActivityInfoCallback callback) override;
 
+  // ledger::LedgerStateClient
+  void LoadLedgerState(ledger::OnLoadCallback callback) override;
+  void LoadPublisherState(ledger::OnLoadCallback callback) override;
+  void SaveLedgerState(const std::string& ledger_state,
+                       ledger::LedgerCallbackHandler* handler) override;
+  void SavePublisherState(const std::string& publisher_state,
+                          ledger::LedgerCallbackHandler* handler) override;
+  void SavePublishersList(const std::string& publishers_list,
+                          ledger::LedgerCallbackHandler* handler) override;
+  void LoadPublisherList(ledger::LedgerCallbackHandler* handler) override;
+
  private:
   bool Connected() const;
 
+  // Counts calls to the browser which block on a sync IPC, and those which
+  // are now answered without one, and logs both once a minute.
+  void RecordCall(bool is_sync) const;
+
   void LoadNicewareList(ledger::GetNicewareListCallback callback) override;
   void RemoveRecurringTip(
     const std::string& publisher_key,
@@ -189,18 +199,29 @@ class BatLedgerClientMojoProxy : public ledger::LedgerClient,
 
   mojom::BatLedgerClientAssociatedPtr bat_ledger_client_;
 
-  void OnLoadLedgerState(ledger::OnLoadCallback callback,
-      const ledger::Result result, const std::string& data);
-  void OnLoadPublisherState(ledger::OnLoadCallback callback,
-      const ledger::Result result, const std::string& data);
-  void OnLoadPublisherList(ledger::LedgerCallbackHandler* handler,
-      const ledger::Result result, const std::string& data);
-  void OnSaveLedgerState(ledger::LedgerCallbackHandler* handler,
-      const ledger::Result result);
-  void OnSavePublisherState(ledger::LedgerCallbackHandler* handler,
-      const ledger::Result result);
-  void OnSavePublishersList(ledger::LedgerCallbackHandler* handler,
-      const ledger::Result result);
+  mutable uint64_t sync_call_count_;
+  mutable uint64_t local_call_count_;
+  mutable base::TimeTicks sync_call_window_start_;
+
+  LedgerStateFileTaskRunner state_file_task_runner_;
+
+  // The state files are read and written here, through file handles the
+  // browser hands over. |missing_result| and |error_result| are what the
+  // ledger expects when a file doesn't exist or can't be written.
+  void LoadStateFile(mojom::LedgerStateFile state_file,
+      ledger::Result missing_result, ledger::OnLoadCallback callback);
+  void OnOpenStateFile(ledger::Result missing_result,
+      ledger::OnLoadCallback callback, base::File file);
+  void OnReadStateFile(ledger::Result missing_result,
+      ledger::OnLoadCallback callback, const std::string& data);
+  void SaveStateFile(mojom::LedgerStateFile state_file,
+      const std::string& data, ledger::Result error_result,
+      ledger::OnSaveCallback callback);
+  void OnCreateTemporaryStateFile(std::string data,
+      ledger::Result error_result, ledger::OnSaveCallback callback,
+      base::File file, uint64_t token);
+  void OnWriteStateFile(uint64_t token, ledger::Result error_result,
+      ledger::OnSaveCallback callback, bool success);
 
   DISALLOW_COPY_AND_ASSIGN(BatLedgerClientMojoProxy);
 };
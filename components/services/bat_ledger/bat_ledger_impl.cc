@@ -46,7 +46,8 @@ BatLedgerImpl::BatLedgerImpl(
   : bat_ledger_client_mojo_proxy_(
       new BatLedgerClientMojoProxy(std::move(client_info))),
     ledger_(
-      ledger::Ledger::CreateInstance(bat_ledger_client_mojo_proxy_.get())) {
+      ledger::Ledger::CreateInstance(bat_ledger_client_mojo_proxy_.get(),
+                                     bat_ledger_client_mojo_proxy_.get())) {
 }
 
 BatLedgerImpl::~BatLedgerImpl() {
@@ -27,48 +27,35 @@ ledger::URL_METHOD ToLedgerURLMethod(int32_t method) {
 }  // namespace
 
 LedgerClientMojoProxy::LedgerClientMojoProxy(
-    ledger::LedgerClient* ledger_client)
-  : ledger_client_(ledger_client) {
+    ledger::LedgerClient* ledger_client,
+    StateFileDelegate* state_file_delegate)
+  : ledger_client_(ledger_client),
+    state_file_delegate_(state_file_delegate) {
+  DCHECK(state_file_delegate_);
 }
 
 LedgerClientMojoProxy::~LedgerClientMojoProxy() {
 }
 
-template <typename Callback>
-void LedgerClientMojoProxy::CallbackHolder<Callback>::OnLedgerStateLoaded(
-    ledger::Result result, const std::string& data) {
-  NOTREACHED();
+void LedgerClientMojoProxy::OpenStateFile(
+    mojom::LedgerStateFile state_file,
+    OpenStateFileCallback callback) {
+  state_file_delegate_->OpenStateFile(state_file, std::move(callback));
 }
 
-template <>
-void LedgerClientMojoProxy::CallbackHolder<
-  LedgerClientMojoProxy::LoadLedgerStateCallback>::OnLedgerStateLoaded(
-    ledger::Result result, const std::string& data) {
-  if (is_valid())
-    std::move(callback_).Run(result, data);
-  delete this;
+void LedgerClientMojoProxy::CreateTemporaryStateFile(
+    mojom::LedgerStateFile state_file,
+    CreateTemporaryStateFileCallback callback) {
+  state_file_delegate_->CreateTemporaryStateFile(state_file,
+                                                 std::move(callback));
 }
 
-// static
-void LedgerClientMojoProxy::OnLoadLedgerState(
-    CallbackHolder<LoadLedgerStateCallback>* holder,
-    ledger::Result result,
-    const std::string& data) {
-  DCHECK(holder);
-  if (holder->is_valid())
-    std::move(holder->get()).Run(result, data);
-  delete holder;
-}
-
-void LedgerClientMojoProxy::LoadLedgerState(LoadLedgerStateCallback callback) {
-  auto* holder = new CallbackHolder<LoadLedgerStateCallback>(AsWeakPtr(),
-      std::move(callback));
-  ledger_client_->LoadLedgerState(
-      std::bind(LedgerClientMojoProxy::OnLoadLedgerState, holder, _1, _2));
-}
-
-void LedgerClientMojoProxy::GenerateGUID(GenerateGUIDCallback callback) {
-  std::move(callback).Run(ledger_client_->GenerateGUID());
+void LedgerClientMojoProxy::FinishTemporaryStateFile(
+    uint64_t token,
+    bool replace_state_file,
+    FinishTemporaryStateFileCallback callback) {
+  state_file_delegate_->FinishTemporaryStateFile(token, replace_state_file,
+                                                 std::move(callback));
 }
 
 void LedgerClientMojoProxy::OnWalletInitialized(const ledger::Result result) {
@@ -83,128 +70,6 @@ void LedgerClientMojoProxy::OnWalletProperties(
       std::move(properties));
 }
 
-// static
-void LedgerClientMojoProxy::OnLoadPublisherState(
-    CallbackHolder<LoadLedgerStateCallback>* holder,
-    ledger::Result result,
-    const std::string& data) {
-  DCHECK(holder);
-  if (holder->is_valid())
-    std::move(holder->get()).Run(result, data);
-  delete holder;
-}
-
-void LedgerClientMojoProxy::LoadPublisherState(
-    LoadPublisherStateCallback callback) {
-  auto* holder = new CallbackHolder<LoadPublisherStateCallback>(AsWeakPtr(),
-      std::move(callback));
-  ledger_client_->LoadPublisherState(
-      std::bind(LedgerClientMojoProxy::OnLoadPublisherState, holder, _1, _2));
-}
-
-template <typename Callback>
-void LedgerClientMojoProxy::CallbackHolder<Callback>::OnPublisherStateLoaded(
-    ledger::Result result, const std::string& data) {
-  NOTREACHED();
-}
-
-template <>
-void LedgerClientMojoProxy::CallbackHolder<
-  LedgerClientMojoProxy::LoadPublisherStateCallback>::OnPublisherStateLoaded(
-    ledger::Result result, const std::string& data) {
-  if (is_valid())
-    std::move(callback_).Run(result, data);
-  delete this;
-}
-
-void LedgerClientMojoProxy::LoadPublisherList(
-    LoadPublisherListCallback callback) {
-  auto* holder = new CallbackHolder<LoadPublisherListCallback>(
-      AsWeakPtr(), std::move(callback));
-  ledger_client_->LoadPublisherList(holder);
-}
-
-template <typename Callback>
-void LedgerClientMojoProxy::CallbackHolder<Callback>::OnPublisherListLoaded(
-    ledger::Result result, const std::string& data) {
-  NOTREACHED();
-}
-
-template <>
-void LedgerClientMojoProxy::CallbackHolder<
-  LedgerClientMojoProxy::LoadPublisherListCallback>::OnPublisherListLoaded(
-    ledger::Result result, const std::string& data) {
-  if (is_valid())
-    std::move(callback_).Run(result, data);
-  delete this;
-}
-
-void LedgerClientMojoProxy::SaveLedgerState(
-    const std::string& ledger_state, SaveLedgerStateCallback callback) {
-  auto* holder = new CallbackHolder<SaveLedgerStateCallback>(
-      AsWeakPtr(), std::move(callback));
-  ledger_client_->SaveLedgerState(ledger_state, holder);
-}
-
-template <typename Callback>
-void LedgerClientMojoProxy::CallbackHolder<Callback>::OnLedgerStateSaved(
-    ledger::Result result) {
-  NOTREACHED();
-}
-
-template <>
-void LedgerClientMojoProxy::CallbackHolder<
-  LedgerClientMojoProxy::SaveLedgerStateCallback>::OnLedgerStateSaved(
-    ledger::Result result) {
-  if (is_valid())
-    std::move(callback_).Run(result);
-  delete this;
-}
-
-void LedgerClientMojoProxy::SavePublisherState(
-    const std::string& publisher_state, SavePublisherStateCallback callback) {
-  auto* holder = new CallbackHolder<SavePublisherStateCallback>(
-      AsWeakPtr(), std::move(callback));
-  ledger_client_->SavePublisherState(publisher_state, holder);
-}
-
-template <typename Callback>
-void LedgerClientMojoProxy::CallbackHolder<Callback>::OnPublisherStateSaved(
-    ledger::Result result) {
-  NOTREACHED();
-}
-
-template <>
-void LedgerClientMojoProxy::CallbackHolder<
-  LedgerClientMojoProxy::SavePublisherStateCallback>::OnPublisherStateSaved(
-    ledger::Result result) {
-  if (is_valid())
-    std::move(callback_).Run(result);
-  delete this;
-}
-
-void LedgerClientMojoProxy::SavePublishersList(
-    const std::string& publishers_list, SavePublishersListCallback callback) {
-  auto* holder = new CallbackHolder<SavePublishersListCallback>(
-      AsWeakPtr(), std::move(callback));
-  ledger_client_->SavePublishersList(publishers_list, holder);
-}
-
-template <typename Callback>
-void LedgerClientMojoProxy::CallbackHolder<Callback>::OnPublishersListSaved(
-    ledger::Result result) {
-  NOTREACHED();
-}
-
-template <>
-void LedgerClientMojoProxy::CallbackHolder<
-  LedgerClientMojoProxy::SavePublishersListCallback>::OnPublishersListSaved(
-    ledger::Result result) {
-  if (is_valid())
-    std::move(callback_).Run(result);
-  delete this;
-}
-
 void LedgerClientMojoProxy::OnRecoverWallet(
     const ledger::Result result,
     double balance,
@@ -457,11 +322,6 @@ void LedgerClientMojoProxy::SaveMediaPublisherInfo(
   ledger_client_->SaveMediaPublisherInfo(media_key, publisher_id);
 }
 
-void LedgerClientMojoProxy::URIEncode(const std::string& value,
-    URIEncodeCallback callback) {
-  std::move(callback).Run(ledger_client_->URIEncode(value));
-}
-
 // static
 void LedgerClientMojoProxy::OnLoadURL(
     CallbackHolder<LoadURLCallback>* holder,
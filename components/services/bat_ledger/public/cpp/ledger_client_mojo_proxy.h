@@ -21,12 +21,37 @@ namespace bat_ledger {
 class LedgerClientMojoProxy : public mojom::BatLedgerClient,
                           public base::SupportsWeakPtr<LedgerClientMojoProxy> {
  public:
-  explicit LedgerClientMojoProxy(ledger::LedgerClient* ledger_client);
+  // Hands out the files bat_ledger reads and writes its state in.
+  class StateFileDelegate {
+   public:
+    virtual void OpenStateFile(mojom::LedgerStateFile state_file,
+                               OpenStateFileCallback callback) = 0;
+    virtual void CreateTemporaryStateFile(
+        mojom::LedgerStateFile state_file,
+        CreateTemporaryStateFileCallback callback) = 0;
+    virtual void FinishTemporaryStateFile(
+        uint64_t token,
+        bool replace_state_file,
+        FinishTemporaryStateFileCallback callback) = 0;
+
+   protected:
+    virtual ~StateFileDelegate() {}
+  };
+
+  LedgerClientMojoProxy(ledger::LedgerClient* ledger_client,
+                        StateFileDelegate* state_file_delegate);
   ~LedgerClientMojoProxy() override;
 
   // bat_ledger::mojom::BatLedgerClient
-  void GenerateGUID(GenerateGUIDCallback callback) override;
-  void LoadLedgerState(LoadLedgerStateCallback callback) override;
+  void OpenStateFile(mojom::LedgerStateFile state_file,
+                     OpenStateFileCallback callback) override;
+  void CreateTemporaryStateFile(
+      mojom::LedgerStateFile state_file,
+      CreateTemporaryStateFileCallback callback) override;
+  void FinishTemporaryStateFile(
+      uint64_t token,
+      bool replace_state_file,
+      FinishTemporaryStateFileCallback callback) override;
   void OnWalletInitialized(const ledger::Result result) override;
   void OnWalletProperties(
       const ledger::Result result,
@@ -44,15 +69,6 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
     const ledger::Result result,
     ledger::GrantPtr grant) override;
 
-  void LoadPublisherState(LoadPublisherStateCallback callback) override;
-  void LoadPublisherList(LoadPublisherListCallback callback) override;
-  void SaveLedgerState(const std::string& ledger_state,
-      SaveLedgerStateCallback callback) override;
-  void SavePublisherState(const std::string& publisher_state,
-      SavePublisherStateCallback callback) override;
-  void SavePublishersList(const std::string& publishers_list,
-      SavePublishersListCallback callback) override;
-
   void SavePublisherInfo(ledger::PublisherInfoPtr publisher_info,
       SavePublisherInfoCallback callback) override;
   void LoadPublisherInfo(const std::string& publisher_key,
@@ -88,9 +104,6 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
   void SaveMediaPublisherInfo(const std::string& media_key,
       const std::string& publisher_id) override;
 
-  void URIEncode(const std::string& value,
-      URIEncodeCallback callback) override;
-
   void LoadURL(const std::string& url,
     const std::vector<std::string>& headers,
     const std::string& content,
@@ -186,9 +199,8 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
 
  private:
   // workaround to pass base::OnceCallback into std::bind
-  // also serves as a wrapper for passing ledger::LedgerCallbackHandler*
   template <typename Callback>
-  class CallbackHolder : public ledger::LedgerCallbackHandler {
+  class CallbackHolder {
    public:
     CallbackHolder(base::WeakPtr<LedgerClientMojoProxy> client,
         Callback callback)
@@ -198,16 +210,6 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
     bool is_valid() { return !!client_.get(); }
     Callback& get() { return callback_; }
 
-    // ledger::LedgerCallbackHandler impl
-    void OnLedgerStateLoaded(ledger::Result result,
-        const std::string& data) override;
-    void OnPublisherStateLoaded(ledger::Result result,
-        const std::string& data) override;
-    void OnPublisherListLoaded(ledger::Result result,
-        const std::string& data) override;
-    void OnLedgerStateSaved(ledger::Result result) override;
-    void OnPublisherStateSaved(ledger::Result result) override;
-    void OnPublishersListSaved(ledger::Result result) override;
    private:
     base::WeakPtr<LedgerClientMojoProxy> client_;
     Callback callback_;
@@ -218,16 +220,6 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
       ledger::Result result,
       ledger::PublisherInfoPtr info);
 
-  static void OnLoadLedgerState(
-    CallbackHolder<LoadLedgerStateCallback>* holder,
-    ledger::Result result,
-    const std::string& data);
-
-  static void OnLoadPublisherState(
-    CallbackHolder<LoadLedgerStateCallback>* holder,
-    ledger::Result result,
-    const std::string& data);
-
   static void OnLoadPublisherInfo(
       CallbackHolder<LoadPublisherInfoCallback>* holder,
       ledger::Result result,
@@ -345,6 +337,7 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
       const ledger::Result result);
 
   ledger::LedgerClient* ledger_client_;
+  StateFileDelegate* state_file_delegate_;  // NOT OWNED
 
   DISALLOW_COPY_AND_ASSIGN(LedgerClientMojoProxy);
 };
@@ -0,0 +1,105 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/public/cpp/ledger_state_file_util.h"
+
+#include <limits>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+#include "base/task/post_task.h"
+#include "base/task_runner_util.h"
+
+namespace bat_ledger {
+
+namespace {
+
+std::string ReadStateFile(base::File file) {
+  const int64_t length = file.GetLength();
+  if (length <= 0 || length > std::numeric_limits<int>::max())
+    return std::string();
+
+  std::string data(length, '\0');
+  if (file.Read(0, &data[0], length) != length) {
+    LOG(ERROR) << "Failed to read state file";
+    return std::string();
+  }
+
+  return data;
+}
+
+bool WriteStateFile(base::File file, const std::string& data) {
+  if (file.Write(0, data.data(), data.size()) !=
+      static_cast<int>(data.size())) {
+    LOG(ERROR) << "Failed to write state file";
+    return false;
+  }
+
+  // Flushed before the browser moves it over the state file, as
+  // ImportantFileWriter does
+  return file.Flush();
+}
+
+}  // namespace
+
+base::File OpenLedgerStateFile(const base::FilePath& path) {
+  return base::File(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+}
+
+base::File CreateTemporaryLedgerStateFile(const base::FilePath& path,
+                                          base::FilePath* temporary_path) {
+  // Next to the state file, so that it can be moved over it
+  if (!base::CreateTemporaryFileInDir(path.DirName(), temporary_path)) {
+    LOG(ERROR) << "Failed to create temporary file for: "
+               << path.MaybeAsASCII();
+    return base::File();
+  }
+
+  base::File file(*temporary_path,
+                  base::File::FLAG_OPEN | base::File::FLAG_WRITE);
+  if (!file.IsValid())
+    base::DeleteFile(*temporary_path, false);
+
+  return file;
+}
+
+bool ReplaceLedgerStateFile(const base::FilePath& temporary_path,
+                            const base::FilePath& path,
+                            bool replace_state_file) {
+  if (replace_state_file &&
+      base::ReplaceFile(temporary_path, path, nullptr)) {
+    return true;
+  }
+
+  base::DeleteFile(temporary_path, false);
+  return false;
+}
+
+LedgerStateFileTaskRunner::LedgerStateFileTaskRunner()
+    : task_runner_(base::CreateSequencedTaskRunnerWithTraits(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN})) {}
+
+LedgerStateFileTaskRunner::~LedgerStateFileTaskRunner() {}
+
+void LedgerStateFileTaskRunner::Read(base::File file, ReadCallback callback) {
+  base::PostTaskAndReplyWithResult(task_runner_.get(), FROM_HERE,
+      base::BindOnce(&ReadStateFile, std::move(file)),
+      std::move(callback));
+}
+
+void LedgerStateFileTaskRunner::Write(base::File file,
+                                      std::string data,
+                                      WriteCallback callback) {
+  base::PostTaskAndReplyWithResult(task_runner_.get(), FROM_HERE,
+      base::BindOnce(&WriteStateFile, std::move(file), std::move(data)),
+      std::move(callback));
+}
+
+}  // namespace bat_ledger
@@ -0,0 +1,67 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_LEDGER_STATE_FILE_UTIL_H_
+#define BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_LEDGER_STATE_FILE_UTIL_H_
+
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+
+namespace base {
+class FilePath;
+class SequencedTaskRunner;
+}
+
+namespace bat_ledger {
+
+// The browser hands bat_ledger a temporary file next to the state file for
+// each save, which bat_ledger writes and the browser then moves over the
+// state file, so that a state file is always replaced atomically.
+
+// Opens the state file at |path| for reading.
+base::File OpenLedgerStateFile(const base::FilePath& path);
+
+// Creates a temporary file next to the state file at |path| and opens it for
+// writing. Returns an invalid file if it couldn't be created.
+base::File CreateTemporaryLedgerStateFile(const base::FilePath& path,
+                                          base::FilePath* temporary_path);
+
+// Moves the file at |temporary_path| over the state file at |path| if
+// |replace_state_file|, and deletes it otherwise or if that fails. Returns
+// whether the state file was replaced.
+bool ReplaceLedgerStateFile(const base::FilePath& temporary_path,
+                            const base::FilePath& path,
+                            bool replace_state_file);
+
+// Reads state files and writes temporary files on one sequence, so that
+// saves finish in the order they were made, and an older snapshot of a state
+// file never replaces a newer one.
+class LedgerStateFileTaskRunner {
+ public:
+  using ReadCallback = base::OnceCallback<void(const std::string&)>;
+  using WriteCallback = base::OnceCallback<void(bool)>;
+
+  LedgerStateFileTaskRunner();
+  ~LedgerStateFileTaskRunner();
+
+  // Reads all of |file|, |callback| gets an empty string if it can't.
+  void Read(base::File file, ReadCallback callback);
+
+  // Writes |data| to |file| and flushes it.
+  void Write(base::File file, std::string data, WriteCallback callback);
+
+ private:
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  DISALLOW_COPY_AND_ASSIGN(LedgerStateFileTaskRunner);
+};
+
+}  // namespace bat_ledger
+
+#endif  // BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_LEDGER_STATE_FILE_UTIL_H_
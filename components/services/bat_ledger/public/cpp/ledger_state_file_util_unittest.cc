@@ -0,0 +1,134 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/public/cpp/ledger_state_file_util.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/scoped_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=LedgerStateFileUtilTest.*
+
+namespace bat_ledger {
+
+class LedgerStateFileUtilTest : public ::testing::Test {
+ protected:
+  LedgerStateFileUtilTest() {}
+  ~LedgerStateFileUtilTest() override {}
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("ledger_state");
+  }
+
+  std::string ReadStateFile() {
+    std::string data;
+    base::RunLoop run_loop;
+    state_file_task_runner_.Read(OpenLedgerStateFile(path_),
+        base::BindOnce([](std::string* data, base::OnceClosure quit,
+                          const std::string& result) {
+          *data = result;
+          std::move(quit).Run();
+        }, &data, run_loop.QuitClosure()));
+    run_loop.Run();
+    return data;
+  }
+
+  // Saves |data| as bat_ledger does: writes it to a temporary file and moves
+  // that over the state file once the write has finished
+  void SaveStateFile(const std::string& data,
+                     std::vector<std::string>* saved,
+                     base::OnceClosure done) {
+    base::FilePath temporary_path;
+    base::File file = CreateTemporaryLedgerStateFile(path_, &temporary_path);
+    ASSERT_TRUE(file.IsValid());
+    EXPECT_EQ(temp_dir_.GetPath(), temporary_path.DirName());
+
+    state_file_task_runner_.Write(std::move(file), data,
+        base::BindOnce([](const base::FilePath& temporary_path,
+                          const base::FilePath& path,
+                          const std::string& data,
+                          std::vector<std::string>* saved,
+                          base::OnceClosure done,
+                          bool success) {
+          EXPECT_TRUE(success);
+          EXPECT_TRUE(
+              ReplaceLedgerStateFile(temporary_path, path, success));
+          saved->push_back(data);
+          std::move(done).Run();
+        }, temporary_path, path_, data, saved, std::move(done)));
+  }
+
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+  LedgerStateFileTaskRunner state_file_task_runner_;
+};
+
+TEST_F(LedgerStateFileUtilTest, ReadMissingStateFile) {
+  EXPECT_FALSE(OpenLedgerStateFile(path_).IsValid());
+}
+
+TEST_F(LedgerStateFileUtilTest, SaveReplacesStateFile) {
+  ASSERT_EQ(3, base::WriteFile(path_, "old", 3));
+
+  std::vector<std::string> saved;
+  base::RunLoop run_loop;
+  SaveStateFile("new", &saved, run_loop.QuitClosure());
+  run_loop.Run();
+
+  EXPECT_EQ("new", ReadStateFile());
+
+  // Only the state file is left, the temporary file was moved over it
+  base::FileEnumerator files(temp_dir_.GetPath(), false,
+                             base::FileEnumerator::FILES);
+  EXPECT_EQ(path_, files.Next());
+  EXPECT_TRUE(files.Next().empty());
+}
+
+TEST_F(LedgerStateFileUtilTest, FailedSaveKeepsStateFile) {
+  ASSERT_EQ(3, base::WriteFile(path_, "old", 3));
+
+  base::FilePath temporary_path;
+  base::File file = CreateTemporaryLedgerStateFile(path_, &temporary_path);
+  ASSERT_TRUE(file.IsValid());
+  ASSERT_EQ(7, file.Write(0, "partial", 7));
+  file.Close();
+
+  EXPECT_FALSE(ReplaceLedgerStateFile(temporary_path, path_, false));
+
+  EXPECT_EQ("old", ReadStateFile());
+  EXPECT_FALSE(base::PathExists(temporary_path));
+}
+
+TEST_F(LedgerStateFileUtilTest, OverlappingSavesFinishInOrder) {
+  // Much larger than the second save, so that it would take longer to write
+  // if the two writes raced
+  const std::string first(4 * 1024 * 1024, 'a');
+  const std::string second = "b";
+
+  std::vector<std::string> saved;
+  base::RunLoop run_loop;
+  SaveStateFile(first, &saved, base::DoNothing());
+  SaveStateFile(second, &saved, run_loop.QuitClosure());
+  run_loop.Run();
+
+  ASSERT_EQ(2u, saved.size());
+  EXPECT_EQ(first, saved[0]);
+  EXPECT_EQ(second, saved[1]);
+  EXPECT_EQ(second, ReadStateFile());
+}
+
+}  // namespace bat_ledger
@@ -57,6 +57,8 @@ void BraveContentSettingsObserver::DidCommitProvisionalLoad(
   if (!is_same_document_navigation) {
     temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+    // The compiled rules depend on the top-level origin.
+    ClearCaches();
   }
 
   ContentSettingsObserver::DidCommitProvisionalLoad(
@@ -110,16 +112,16 @@ bool BraveContentSettingsObserver::AllowScriptFromSource(
   bool allow = ContentSettingsObserver::AllowScriptFromSource(
       enabled_per_settings, script_url);
 
-  // scripts with whitelisted protocols, such as chrome://extensions should
-  // be allowed
-  bool should_white_list = IsWhitelistedForContentSettings(
-      blink::WebSecurityOrigin::Create(script_url),
-      render_frame()->GetWebFrame()->GetDocument().Url());
-
+  // The shields state of the frame is cached, so check it before looking at
+  // the script URL.
   allow = allow ||
-    should_white_list ||
     IsBraveShieldsDown(render_frame()->GetWebFrame(), secondary_url) ||
-    IsScriptTemporilyAllowed(secondary_url);
+    IsScriptTemporilyAllowed(secondary_url) ||
+    // scripts with whitelisted protocols, such as chrome://extensions should
+    // be allowed
+    IsWhitelistedForContentSettings(
+        blink::WebSecurityOrigin::Create(script_url),
+        render_frame()->GetWebFrame()->GetDocument().Url());
 
   if (!allow) {
     blocked_script_url_ = secondary_url;
@@ -146,28 +148,55 @@ GURL BraveContentSettingsObserver::GetOriginOrURL(
   return top_origin.GetURL();
 }
 
-ContentSetting BraveContentSettingsObserver::GetFPContentSettingFromRules(
-    const ContentSettingsForOneType& rules,
-    const blink::WebFrame* frame,
-    const GURL& secondary_url) {
+const GURL& BraveContentSettingsObserver::GetPrimaryURL() {
+  if (primary_url_.is_empty())
+    primary_url_ = GetOriginOrURL(render_frame()->GetWebFrame());
+  return primary_url_;
+}
 
-  if (rules.size() == 0)
-    return CONTENT_SETTING_DEFAULT;
+void BraveContentSettingsObserver::CompileFingerprintingRules(
+    const GURL& primary_url) {
+  const ContentSettingsPattern first_party_pattern =
+      ContentSettingsPattern::FromString("https://firstParty/*");
+  const ContentSettingsPattern primary_host_pattern =
+      ContentSettingsPattern::FromString(
+          "[*.]" + primary_url.HostNoBrackets());
+
+  fingerprinting_rules_.clear();
+  auto add_rule = [&](const ContentSettingsPattern& primary_pattern,
+                      const ContentSettingsPattern& secondary_pattern,
+                      ContentSetting setting) {
+    CompiledRule rule;
+    rule.primary_pattern = primary_pattern;
+    rule.secondary_pattern = secondary_pattern == first_party_pattern
+                                 ? primary_host_pattern
+                                 : secondary_pattern;
+    rule.matches_any_secondary =
+        rule.secondary_pattern == ContentSettingsPattern::Wildcard();
+    rule.setting = setting;
+    fingerprinting_rules_.push_back(rule);
+  };
 
-  const GURL& primary_url = GetOriginOrURL(frame);
-
-  for (const auto& rule : rules) {
-    ContentSettingsPattern secondary_pattern = rule.secondary_pattern;
-    if (rule.secondary_pattern ==
-        ContentSettingsPattern::FromString("https://firstParty/*")) {
-      secondary_pattern = ContentSettingsPattern::FromString(
-          "[*.]" + GetOriginOrURL(frame).HostNoBrackets());
+  if (content_setting_rules_) {
+    for (const auto& rule : content_setting_rules_->fingerprinting_rules) {
+      add_rule(rule.primary_pattern, rule.secondary_pattern,
+               rule.GetContentSetting());
     }
+  }
+  // First parties are allowed unless a rule says otherwise.
+  add_rule(ContentSettingsPattern::Wildcard(), first_party_pattern,
+           CONTENT_SETTING_ALLOW);
+  fingerprinting_rules_compiled_ = true;
+}
 
+ContentSetting BraveContentSettingsObserver::GetFPContentSettingFromRules(
+    const GURL& primary_url,
+    const GURL& secondary_url) const {
+  for (const auto& rule : fingerprinting_rules_) {
     if (rule.primary_pattern.Matches(primary_url) &&
-        (secondary_pattern == ContentSettingsPattern::Wildcard() ||
-         secondary_pattern.Matches(secondary_url))) {
-      return rule.GetContentSetting();
+        (rule.matches_any_secondary ||
+         rule.secondary_pattern.Matches(secondary_url))) {
+      return rule.setting;
     }
   }
 
@@ -176,23 +205,62 @@ ContentSetting BraveContentSettingsObserver::GetFPContentSettingFromRules(
   return CONTENT_SETTING_BLOCK;
 }
 
-bool BraveContentSettingsObserver::IsBraveShieldsDown(
-    const blink::WebFrame* frame,
-    const GURL& secondary_url) {
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  const GURL& primary_url = GetOriginOrURL(frame);
+void BraveContentSettingsObserver::ClearCachesIfRulesChanged() {
+  const uint64_t rules_version =
+      content_setting_rules_ ? content_setting_rules_->brave_rules_version : 0;
+  if (rules_version == rules_version_)
+    return;
+
+  ClearCaches();
+  rules_version_ = rules_version;
+}
 
+void BraveContentSettingsObserver::ClearCaches() {
+  primary_url_ = GURL();
+  brave_shields_rules_.clear();
+  brave_shields_rules_compiled_ = false;
+  fingerprinting_rules_.clear();
+  fingerprinting_rules_compiled_ = false;
+  fingerprinting_decisions_.clear();
+}
+
+void BraveContentSettingsObserver::CompileBraveShieldsRules(
+    const GURL& primary_url) {
+  brave_shields_rules_.clear();
   if (content_setting_rules_) {
     for (const auto& rule : content_setting_rules_->brave_shields_rules) {
-      if (rule.primary_pattern.Matches(primary_url) &&
-          rule.secondary_pattern.Matches(secondary_url)) {
-        setting = rule.GetContentSetting();
+      if (!rule.primary_pattern.Matches(primary_url))
+        continue;
+      CompiledRule compiled_rule;
+      compiled_rule.primary_pattern = rule.primary_pattern;
+      compiled_rule.secondary_pattern = rule.secondary_pattern;
+      compiled_rule.matches_any_secondary =
+          rule.secondary_pattern == ContentSettingsPattern::Wildcard();
+      compiled_rule.setting = rule.GetContentSetting();
+      brave_shields_rules_.push_back(compiled_rule);
+      // Nothing after a rule matching every secondary URL can be reached.
+      if (compiled_rule.matches_any_secondary)
         break;
-      }
     }
   }
+  brave_shields_rules_compiled_ = true;
+}
 
-  return setting == CONTENT_SETTING_BLOCK;
+bool BraveContentSettingsObserver::IsBraveShieldsDown(
+    const blink::WebFrame* frame,
+    const GURL& secondary_url) {
+  DCHECK_EQ(frame, render_frame()->GetWebFrame());
+  ClearCachesIfRulesChanged();
+  if (!brave_shields_rules_compiled_)
+    CompileBraveShieldsRules(GetPrimaryURL());
+
+  for (const auto& rule : brave_shields_rules_) {
+    if (rule.matches_any_secondary ||
+        rule.secondary_pattern.Matches(secondary_url)) {
+      return rule.setting == CONTENT_SETTING_BLOCK;
+    }
+  }
+  return false;
 }
 
 bool BraveContentSettingsObserver::AllowFingerprinting(
@@ -202,29 +270,16 @@ bool BraveContentSettingsObserver::AllowFingerprinting(
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
   const GURL secondary_url(
       url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL());
-  if (IsBraveShieldsDown(frame, secondary_url)) {
-    return true;
-  }
-  const GURL& primary_url = GetOriginOrURL(frame);
-  if (brave::IsWhitelistedFingerprintingException(primary_url, secondary_url)) {
-    return true;
-  }
-  ContentSettingsForOneType rules;
-  if (content_setting_rules_) {
-      rules = content_setting_rules_->fingerprinting_rules;
+
+  ClearCachesIfRulesChanged();
+  bool allow;
+  auto it = fingerprinting_decisions_.find(secondary_url);
+  if (it != fingerprinting_decisions_.end()) {
+    allow = it->second;
+  } else {
+    allow = ComputeAllowFingerprinting(secondary_url);
+    fingerprinting_decisions_[secondary_url] = allow;
   }
-  ContentSettingPatternSource default_rule = ContentSettingPatternSource(
-      ContentSettingsPattern::Wildcard(),
-      ContentSettingsPattern::FromString("https://firstParty/*"),
-      base::Value::FromUniquePtrValue(
-          content_settings::ContentSettingToValue(CONTENT_SETTING_ALLOW)),
-      std::string(), false);
-  rules.push_back(default_rule);
-  ContentSetting setting =
-      GetFPContentSettingFromRules(rules, frame, secondary_url);
-  rules.pop_back();
-  bool allow = setting != CONTENT_SETTING_BLOCK;
-  allow = allow || IsWhitelistedForContentSettings();
 
   if (!allow) {
     DidBlockFingerprinting(base::UTF8ToUTF16(secondary_url.spec()));
@@ -233,6 +288,23 @@ bool BraveContentSettingsObserver::AllowFingerprinting(
   return allow;
 }
 
+bool BraveContentSettingsObserver::ComputeAllowFingerprinting(
+    const GURL& secondary_url) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (IsBraveShieldsDown(frame, secondary_url)) {
+    return true;
+  }
+  const GURL& primary_url = GetPrimaryURL();
+  if (brave::IsWhitelistedFingerprintingException(primary_url, secondary_url)) {
+    return true;
+  }
+  if (!fingerprinting_rules_compiled_)
+    CompileFingerprintingRules(primary_url);
+  ContentSetting setting =
+      GetFPContentSettingFromRules(primary_url, secondary_url);
+  return setting != CONTENT_SETTING_BLOCK || IsWhitelistedForContentSettings();
+}
+
 bool BraveContentSettingsObserver::AllowAutoplay(bool default_value) {
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
   auto origin = frame->GetDocument().GetSecurityOrigin();
@@ -5,9 +5,15 @@
 #ifndef BRAVE_RENDERER_CONTENT_SETTINGS_OBSERVER_H_
 #define BRAVE_RENDERER_CONTENT_SETTINGS_OBSERVER_H_
 
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/containers/flat_map.h"
 #include "base/strings/string16.h"
 #include "chrome/renderer/content_settings_observer.h"
 #include "components/content_settings/core/common/content_settings.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
 #include "components/content_settings/core/common/content_settings_types.h"
 
 namespace blink {
@@ -42,10 +48,28 @@ class BraveContentSettingsObserver
  private:
   GURL GetOriginOrURL(const blink::WebFrame* frame);
 
-  ContentSetting GetFPContentSettingFromRules(
-      const ContentSettingsForOneType& rules,
-      const blink::WebFrame* frame,
-      const GURL& secondary_url);
+  // A rule compiled for the current document. For fingerprinting rules the
+  // "https://firstParty/*" placeholder is already resolved against the
+  // frame's top-level origin.
+  struct CompiledRule {
+    ContentSettingsPattern primary_pattern;
+    ContentSettingsPattern secondary_pattern;
+    bool matches_any_secondary;
+    ContentSetting setting;
+  };
+
+  // The top-level origin (or URL) of the current document.
+  const GURL& GetPrimaryURL();
+  void CompileFingerprintingRules(const GURL& primary_url);
+  void CompileBraveShieldsRules(const GURL& primary_url);
+  ContentSetting GetFPContentSettingFromRules(const GURL& primary_url,
+                                              const GURL& secondary_url) const;
+  bool ComputeAllowFingerprinting(const GURL& secondary_url);
+
+  // Clears the cached decisions below if the browser sent new rules since
+  // they were computed.
+  void ClearCachesIfRulesChanged();
+  void ClearCaches();
 
   bool IsBraveShieldsDown(
       const blink::WebFrame* frame,
@@ -69,6 +93,23 @@ class BraveContentSettingsObserver
   // temporary allowed script origins we preloaded for the next load
   base::flat_set<std::string> preloaded_temporarily_allowed_scripts_;
 
+  // RendererContentSettingRules::brave_rules_version of the rules the caches
+  // below were computed from.
+  uint64_t rules_version_ = 0;
+
+  // Fingerprinting rules compiled for the current document, in rule order,
+  // followed by the default rule allowing first parties.
+  GURL primary_url_;
+  std::vector<CompiledRule> fingerprinting_rules_;
+  bool fingerprinting_rules_compiled_ = false;
+  // Brave shields rules whose primary pattern matches |primary_url_|, so
+  // that IsBraveShieldsDown() only has to look at the secondary URL.
+  std::vector<CompiledRule> brave_shields_rules_;
+  bool brave_shields_rules_compiled_ = false;
+  // AllowFingerprinting() results for the current document, keyed by the
+  // secondary URL.
+  base::flat_map<GURL, bool> fingerprinting_decisions_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsObserver);
 };
 
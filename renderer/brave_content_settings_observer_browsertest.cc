@@ -4,6 +4,7 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "base/path_service.h"
+#include "base/timer/elapsed_timer.h"
 #include "brave/browser/brave_content_browser_client.h"
 #include "brave/common/brave_paths.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -20,6 +21,7 @@
 #include "net/dns/mock_host_resolver.h"
 #include "net/http/http_request_headers.h"
 #include "net/test/embedded_test_server/http_request.h"
+#include "testing/perf/perf_test.h"
 
 const char kIframeID[] = "test";
 
@@ -766,3 +768,23 @@ IN_PROC_BROWSER_TEST_F(BraveContentSettingsObserverBrowserTest,
       NavigateToURLUntilLoadStop("b.com", "/load_js_from_origins.html"));
   EXPECT_EQ(contents()->GetAllFrames().size(), 1u);
 }
+
+// Loads a page with 500 script tags, which all go through
+// AllowScriptFromSource(), and reports how long it took.
+IN_PROC_BROWSER_TEST_F(BraveContentSettingsObserverBrowserTest,
+                       ManyScriptsShieldsDownPerf) {
+  BlockScripts();
+  ShieldsDown();
+
+  base::ElapsedTimer timer;
+  EXPECT_TRUE(NavigateToURLUntilLoadStop("a.com", "/many_scripts.html"));
+  base::TimeDelta load_time = timer.Elapsed();
+
+  int scripts_loaded = 0;
+  EXPECT_TRUE(ExecuteScriptAndExtractInt(
+      contents(), "domAutomationController.send(window.scriptsLoaded);",
+      &scripts_loaded));
+  EXPECT_EQ(scripts_loaded, 500);
+  perf_test::PrintResult("many_scripts_shields_down", "", "load_time",
+                         load_time.InMillisecondsF(), "ms", true);
+}
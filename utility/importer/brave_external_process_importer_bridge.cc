@@ -65,6 +65,12 @@ void BraveExternalProcessImporterBridge::UpdateSettings(
   (*observer_)->OnSettingsImportReady(settings);
 }
 
+void BraveExternalProcessImporterBridge::NotifyItemProgress(
+    importer::ImportItem item,
+    uint32_t imported_count) {
+  (*observer_)->OnImportItemProgress(item, imported_count);
+}
+
 
 BraveExternalProcessImporterBridge::BraveExternalProcessImporterBridge(
     const base::flat_map<uint32_t, std::string>& localized_strings,
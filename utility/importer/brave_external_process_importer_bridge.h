@@ -25,6 +25,8 @@ class BraveExternalProcessImporterBridge :
   void UpdateReferral(const BraveReferral& referral) override;
   void UpdateWindows(const ImportedWindowState& windowState) override;
   void UpdateSettings(const SessionStoreSettings& settings) override;
+  void NotifyItemProgress(importer::ImportItem item,
+                          uint32_t imported_count) override;
 
 
  private:
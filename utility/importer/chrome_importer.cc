@@ -7,13 +7,18 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
+#include "base/barrier_closure.h"
+#include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/task/post_task.h"
 #include "base/values.h"
 #include "brave/utility/importer/brave_external_process_importer_bridge.h"
 #include "build/build_config.h"
@@ -57,6 +62,50 @@ base::nix::DesktopEnvironment ChromeImporter::GetDesktopEnvironment() {
 
 using base::Time;
 
+// static
+const size_t ChromeImporter::kNumHistoryRowsPerChunk = 1000;
+// static
+const size_t ChromeImporter::kNumFaviconsPerBatch = 100;
+
+namespace {
+
+void ReencodePendingFavicon(ChromeImporter::PendingFavicon* favicon,
+                            base::OnceClosure done) {
+  favicon->reencoded = importer::ReencodeFavicon(
+      favicon->image_data.data(), favicon->image_data.size(),
+      &favicon->usage.png_data);
+  std::move(done).Run();
+}
+
+// Decoding and PNG encoding dominate the import of large favicon databases,
+// so the images of a batch are reencoded on the thread pool while the
+// import thread waits.
+void ReencodeFavicons(std::vector<ChromeImporter::PendingFavicon>* favicons) {
+  if (favicons->empty())
+    return;
+
+  base::WaitableEvent reencoded;
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      favicons->size(), base::BindOnce(&base::WaitableEvent::Signal,
+                                       base::Unretained(&reencoded)));
+  for (ChromeImporter::PendingFavicon& favicon : *favicons) {
+    base::PostTaskWithTraits(
+        FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(&ReencodePendingFavicon, base::Unretained(&favicon),
+                       barrier));
+  }
+  reencoded.Wait();
+}
+
+}  // namespace
+
+ChromeImporter::PendingFavicon::PendingFavicon() = default;
+
+ChromeImporter::PendingFavicon::PendingFavicon(PendingFavicon&& other) =
+    default;
+
+ChromeImporter::PendingFavicon::~PendingFavicon() = default;
+
 ChromeImporter::ChromeImporter() {
 }
 
@@ -110,13 +159,15 @@ void ChromeImporter::ImportHistory() {
   if (!db.Open(history_path))
     return;
 
+  // One row per URL, with the time of its most recent visit.
   const char query[] =
-    "SELECT u.url, u.title, v.visit_time, u.typed_count, u.visit_count "
+    "SELECT u.url, u.title, MAX(v.visit_time), u.typed_count, u.visit_count "
     "FROM urls u JOIN visits v ON u.id = v.url "
     "WHERE hidden = 0 "
     "AND (transition & ?) != 0 "  // CHAIN_END
-    "AND (transition & ?) NOT IN (?, ?, ?)";  // No SUBFRAME or
+    "AND (transition & ?) NOT IN (?, ?, ?) "  // No SUBFRAME or
                                               // KEYWORD_GENERATED
+    "GROUP BY u.id";
 
   sql::Statement s(db.GetUniqueStatement(query));
   s.BindInt(0, ui::PAGE_TRANSITION_CHAIN_END);
@@ -125,7 +176,11 @@ void ChromeImporter::ImportHistory() {
   s.BindInt(3, ui::PAGE_TRANSITION_MANUAL_SUBFRAME);
   s.BindInt(4, ui::PAGE_TRANSITION_KEYWORD_GENERATED);
 
+  // Rows are handed to the bridge in chunks, so that neither process holds
+  // the whole history and the browser starts writing it while we read.
   std::vector<ImporterURLRow> rows;
+  rows.reserve(kNumHistoryRowsPerChunk);
+  uint32_t imported_rows = 0;
   while (s.Step() && !cancelled()) {
     GURL url(s.ColumnString(0));
 
@@ -137,11 +192,20 @@ void ChromeImporter::ImportHistory() {
     row.typed_count = s.ColumnInt(3);
     row.visit_count = s.ColumnInt(4);
 
-    rows.push_back(row);
+    rows.push_back(std::move(row));
+    if (rows.size() == kNumHistoryRowsPerChunk) {
+      bridge_->SetHistoryItems(rows, importer::VISIT_SOURCE_CHROME_IMPORTED);
+      imported_rows += rows.size();
+      bridge_->NotifyItemProgress(importer::HISTORY, imported_rows);
+      rows.clear();
+    }
   }
 
-  if (!rows.empty() && !cancelled())
+  if (!rows.empty() && !cancelled()) {
     bridge_->SetHistoryItems(rows, importer::VISIT_SOURCE_CHROME_IMPORTED);
+    imported_rows += rows.size();
+    bridge_->NotifyItemProgress(importer::HISTORY, imported_rows);
+  }
 }
 
 void ChromeImporter::ImportBookmarks() {
@@ -200,11 +264,8 @@ void ChromeImporter::ImportBookmarks() {
   FaviconMap favicon_map;
   ImportFaviconURLs(&db, &favicon_map);
   // Write favicons into profile.
-  if (!favicon_map.empty() && !cancelled()) {
-    favicon_base::FaviconUsageDataList favicons;
-    LoadFaviconData(&db, favicon_map, &favicons);
-    bridge_->SetFavicons(favicons);
-  }
+  if (!favicon_map.empty() && !cancelled())
+    ImportFaviconData(&db, favicon_map);
 }
 
 void ChromeImporter::ImportFaviconURLs(
@@ -220,43 +281,67 @@ void ChromeImporter::ImportFaviconURLs(
   }
 }
 
-void ChromeImporter::LoadFaviconData(
-    sql::Database* db,
-    const FaviconMap& favicon_map,
-    favicon_base::FaviconUsageDataList* favicons) {
-  const char query[] = "SELECT f.url, fb.image_data "
+void ChromeImporter::ImportFaviconData(sql::Database* db,
+                                       const FaviconMap& favicon_map) {
+  // Icons can have several bitmaps; like before, only the first one of each
+  // icon is imported.
+  const char query[] = "SELECT f.id, f.url, fb.image_data "
                        "FROM favicons f "
                        "JOIN favicon_bitmaps fb "
                        "ON f.id = fb.icon_id "
-                       "WHERE f.id = ?;";
+                       "ORDER BY f.id, fb.id;";
   sql::Statement s(db->GetUniqueStatement(query));
 
   if (!s.is_valid())
     return;
 
-  for (FaviconMap::const_iterator i = favicon_map.begin();
-       i != favicon_map.end(); ++i) {
-    s.BindInt64(0, i->first);
-    if (s.Step()) {
-      favicon_base::FaviconUsageData usage;
-
-      usage.favicon_url = GURL(s.ColumnString(0));
-      if (!usage.favicon_url.is_valid())
-        continue;  // Don't bother importing favicons with invalid URLs.
+  std::vector<PendingFavicon> batch;
+  batch.reserve(kNumFaviconsPerBatch);
+  bool has_previous_icon = false;
+  int64_t previous_icon_id = 0;
+  while (s.Step() && !cancelled()) {
+    int64_t icon_id = s.ColumnInt64(0);
+    if (has_previous_icon && icon_id == previous_icon_id)
+      continue;
+    has_previous_icon = true;
+    previous_icon_id = icon_id;
+
+    FaviconMap::const_iterator urls = favicon_map.find(icon_id);
+    if (urls == favicon_map.end())
+      continue;
+
+    PendingFavicon favicon;
+    favicon.usage.favicon_url = GURL(s.ColumnString(1));
+    if (!favicon.usage.favicon_url.is_valid())
+      continue;  // Don't bother importing favicons with invalid URLs.
+
+    s.ColumnBlobAsVector(2, &favicon.image_data);
+    if (favicon.image_data.empty())
+      continue;  // Data definitely invalid.
+
+    favicon.usage.urls = urls->second;
+    batch.push_back(std::move(favicon));
+    if (batch.size() == kNumFaviconsPerBatch) {
+      ImportFaviconBatch(&batch);
+      batch.clear();
+    }
+  }
 
-      std::vector<unsigned char> data;
-      s.ColumnBlobAsVector(1, &data);
-      if (data.empty())
-        continue;  // Data definitely invalid.
+  if (!batch.empty() && !cancelled())
+    ImportFaviconBatch(&batch);
+}
 
-      if (!importer::ReencodeFavicon(&data[0], data.size(), &usage.png_data))
-        continue;  // Unable to decode.
+void ChromeImporter::ImportFaviconBatch(std::vector<PendingFavicon>* batch) {
+  ReencodeFavicons(batch);
 
-      usage.urls = i->second;
-      favicons->push_back(usage);
-    }
-    s.Reset(true);
+  favicon_base::FaviconUsageDataList favicons;
+  favicons.reserve(batch->size());
+  for (PendingFavicon& favicon : *batch) {
+    if (favicon.reencoded)
+      favicons.push_back(std::move(favicon.usage));
   }
+  if (!favicons.empty() && !cancelled())
+    bridge_->SetFavicons(favicons);
 }
 
 void ChromeImporter::RecursiveReadBookmarksFolder(
@@ -33,6 +33,24 @@ class ChromeImporter : public Importer {
  public:
   ChromeImporter();
 
+  // The largest number of history rows passed to the bridge at once.
+  static const size_t kNumHistoryRowsPerChunk;
+  // The largest number of favicons passed to the bridge at once.
+  static const size_t kNumFaviconsPerBatch;
+
+  // A favicon read from the Favicons database, waiting to be reencoded.
+  struct PendingFavicon {
+    PendingFavicon();
+    PendingFavicon(PendingFavicon&& other);
+    ~PendingFavicon();
+
+    favicon_base::FaviconUsageData usage;
+    std::vector<unsigned char> image_data;
+    bool reencoded = false;
+
+    DISALLOW_COPY_AND_ASSIGN(PendingFavicon);
+  };
+
   // Importer:
   void StartImport(const importer::SourceProfile& source_profile,
                    uint16_t items,
@@ -63,10 +81,10 @@ class ChromeImporter : public Importer {
     sql::Database* db,
     FaviconMap* favicon_map);
 
-  // Loads and reencodes the individual favicons.
-  void LoadFaviconData(sql::Database* db,
-                       const FaviconMap& favicon_map,
-                       favicon_base::FaviconUsageDataList* favicons);
+  // Loads the individual favicons and imports them in batches, reencoding
+  // the images of each batch in parallel.
+  void ImportFaviconData(sql::Database* db, const FaviconMap& favicon_map);
+  void ImportFaviconBatch(std::vector<PendingFavicon>* batch);
 
   void RecursiveReadBookmarksFolder(
     const base::DictionaryValue* folder,
@@ -0,0 +1,183 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "base/barrier_closure.h"
+#include "base/bind.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/system/sys_info.h"
+#include "base/test/scoped_task_environment.h"
+#include "base/threading/thread.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/common/importer/brave_mock_importer_bridge.h"
+#include "brave/utility/importer/chrome_importer.h"
+#include "brave/utility/importer/chrome_importer_test_util.h"
+#include "chrome/common/importer/importer_data_types.h"
+#include "chrome/common/importer/importer_url_row.h"
+#include "chrome/utility/importer/favicon_reencode.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=ChromeImporterPerfTest.*
+
+using ::testing::_;
+
+namespace {
+
+// 1M visits, the size of a long-lived profile's history.
+const int kNumURLs = 100000;
+const int kVisitsPerURL = 10;
+
+const int kNumIcons = 5000;
+
+// Builds a synthetic favicon set of |num_icons| icons from |images|.
+std::vector<ChromeImporter::PendingFavicon> CreatePendingFavicons(
+    const std::vector<std::vector<unsigned char>>& images,
+    int num_icons) {
+  std::vector<ChromeImporter::PendingFavicon> favicons(num_icons);
+  for (int i = 0; i < num_icons; ++i) {
+    favicons[i].usage.favicon_url = GURL(
+        base::StringPrintf("https://site%d.example.com/favicon.ico", i));
+    favicons[i].image_data = images[i % images.size()];
+  }
+  return favicons;
+}
+
+void ReencodePendingFavicon(ChromeImporter::PendingFavicon* favicon,
+                            base::OnceClosure done) {
+  favicon->reencoded = importer::ReencodeFavicon(
+      favicon->image_data.data(), favicon->image_data.size(),
+      &favicon->usage.png_data);
+  std::move(done).Run();
+}
+
+// Reencodes |favicons| in batches of ChromeImporter::kNumFaviconsPerBatch
+// on |num_workers| threads, waiting for every batch the way the importer
+// does, and returns how long it took.
+base::TimeDelta ReencodeInBatches(
+    std::vector<ChromeImporter::PendingFavicon>* favicons,
+    int num_workers) {
+  std::vector<std::unique_ptr<base::Thread>> workers;
+  for (int i = 0; i < num_workers; ++i) {
+    workers.push_back(std::make_unique<base::Thread>(
+        base::StringPrintf("FaviconReencode%d", i)));
+    CHECK(workers.back()->Start());
+  }
+
+  base::ElapsedTimer timer;
+  for (size_t start = 0; start < favicons->size();
+       start += ChromeImporter::kNumFaviconsPerBatch) {
+    const size_t end = std::min(
+        favicons->size(), start + ChromeImporter::kNumFaviconsPerBatch);
+    base::WaitableEvent reencoded;
+    base::RepeatingClosure barrier = base::BarrierClosure(
+        end - start, base::BindOnce(&base::WaitableEvent::Signal,
+                                    base::Unretained(&reencoded)));
+    for (size_t i = start; i < end; ++i) {
+      workers[i % workers.size()]->task_runner()->PostTask(
+          FROM_HERE, base::BindOnce(&ReencodePendingFavicon,
+                                    base::Unretained(&(*favicons)[i]),
+                                    barrier));
+    }
+    reencoded.Wait();
+  }
+  return timer.Elapsed();
+}
+
+class ChromeImporterPerfTest : public testing::Test {
+ public:
+  ChromeImporterPerfTest() {}
+  ~ChromeImporterPerfTest() override {}
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    profile_dir_ = temp_dir_.GetPath().AppendASCII("profile");
+    ASSERT_TRUE(base::CopyDirectory(GetTestChromeProfileDir("default"),
+                                    profile_dir_, true));
+    profile_.source_path = profile_dir_;
+    importer_ = new ChromeImporter;
+    bridge_ = new BraveMockImporterBridge;
+  }
+
+ protected:
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath profile_dir_;
+  importer::SourceProfile profile_;
+  scoped_refptr<ChromeImporter> importer_;
+  scoped_refptr<BraveMockImporterBridge> bridge_;
+};
+
+}  // namespace
+
+// Imports a synthetic History database with 1M visits and reports how long
+// it took and how many chunks it was handed to the bridge in.
+TEST_F(ChromeImporterPerfTest, ImportHistory) {
+  CreateHistoryDatabase(profile_dir_.AppendASCII("History"), kNumURLs,
+                        kVisitsPerURL);
+
+  size_t total_rows = 0;
+  size_t num_chunks = 0;
+  EXPECT_CALL(*bridge_, NotifyStarted());
+  EXPECT_CALL(*bridge_, NotifyItemStarted(importer::HISTORY));
+  EXPECT_CALL(*bridge_, SetHistoryItems(_, _))
+      .WillRepeatedly(::testing::Invoke(
+          [&](const std::vector<ImporterURLRow>& rows,
+              importer::VisitSource visit_source) {
+            total_rows += rows.size();
+            ++num_chunks;
+          }));
+  EXPECT_CALL(*bridge_, NotifyItemProgress(importer::HISTORY, _))
+      .Times(::testing::AnyNumber());
+  EXPECT_CALL(*bridge_, NotifyItemEnded(importer::HISTORY));
+  EXPECT_CALL(*bridge_, NotifyEnded());
+
+  base::ElapsedTimer timer;
+  importer_->StartImport(profile_, importer::HISTORY, bridge_.get());
+  base::TimeDelta import_time = timer.Elapsed();
+
+  EXPECT_EQ(static_cast<size_t>(kNumURLs), total_rows);
+  perf_test::PrintResult("chrome_importer", "_history", "import_time",
+                         import_time.InMillisecondsF(), "ms", true);
+  perf_test::PrintResult("chrome_importer", "_history", "chunks", num_chunks,
+                         "count", true);
+}
+
+// Reencodes a synthetic favicon set with 1, 2 and as many workers as there
+// are cores, and reports how long each took.
+TEST_F(ChromeImporterPerfTest, ReencodeFavicons) {
+  std::vector<std::vector<unsigned char>> images;
+  CreateFaviconsDatabase(profile_dir_.AppendASCII("Favicons"), kNumIcons,
+                         &images);
+
+  const std::set<int> worker_counts = {1, 2,
+                                       base::SysInfo::NumberOfProcessors()};
+  for (int num_workers : worker_counts) {
+    std::vector<ChromeImporter::PendingFavicon> favicons =
+        CreatePendingFavicons(images, kNumIcons);
+    base::TimeDelta reencode_time = ReencodeInBatches(&favicons, num_workers);
+
+    EXPECT_EQ(static_cast<size_t>(kNumIcons),
+              static_cast<size_t>(std::count_if(
+                  favicons.begin(), favicons.end(),
+                  [](const ChromeImporter::PendingFavicon& favicon) {
+                    return favicon.reencoded;
+                  })));
+    perf_test::PrintResult(
+        "chrome_importer", base::StringPrintf("_favicons_%d_workers",
+                                              num_workers),
+        "reencode_time", reencode_time.InMillisecondsF(), "ms", true);
+  }
+}
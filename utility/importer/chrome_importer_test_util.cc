@@ -0,0 +1,130 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/utility/importer/chrome_importer_test_util.h"
+
+#include "base/files/file_util.h"
+#include "base/path_service.h"
+#include "base/strings/stringprintf.h"
+#include "brave/common/brave_paths.h"
+#include "sql/database.h"
+#include "sql/statement.h"
+#include "sql/transaction.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/base/page_transition_types.h"
+
+base::FilePath GetTestChromeProfileDir(const std::string& profile) {
+  base::FilePath test_dir;
+  base::PathService::Get(brave::DIR_TEST_DATA, &test_dir);
+
+  return test_dir.AppendASCII("import").AppendASCII("chrome")
+      .AppendASCII(profile);
+}
+
+void CreateHistoryDatabase(const base::FilePath& path,
+                           int num_urls,
+                           int visits_per_url) {
+  ASSERT_TRUE(base::DeleteFile(path, false));
+  sql::Database db;
+  ASSERT_TRUE(db.Open(path));
+  ASSERT_TRUE(db.Execute(
+      "CREATE TABLE urls(id INTEGER PRIMARY KEY, url LONGVARCHAR, "
+      "title LONGVARCHAR, visit_count INTEGER DEFAULT 0 NOT NULL, "
+      "typed_count INTEGER DEFAULT 0 NOT NULL, "
+      "last_visit_time INTEGER NOT NULL, hidden INTEGER DEFAULT 0 NOT NULL)"));
+  ASSERT_TRUE(db.Execute(
+      "CREATE TABLE visits(id INTEGER PRIMARY KEY, url INTEGER NOT NULL, "
+      "visit_time INTEGER NOT NULL, from_visit INTEGER, "
+      "transition INTEGER DEFAULT 0 NOT NULL)"));
+
+  sql::Transaction transaction(&db);
+  ASSERT_TRUE(transaction.Begin());
+  sql::Statement url_statement(db.GetUniqueStatement(
+      "INSERT INTO urls (id, url, title, visit_count, last_visit_time) "
+      "VALUES (?, ?, ?, ?, ?)"));
+  sql::Statement visit_statement(db.GetUniqueStatement(
+      "INSERT INTO visits (url, visit_time, transition) VALUES (?, ?, ?)"));
+  const int64_t kFirstVisitTime = 13165369272568785;
+  const int kTransition = ui::PAGE_TRANSITION_LINK |
+                          ui::PAGE_TRANSITION_CHAIN_START |
+                          ui::PAGE_TRANSITION_CHAIN_END;
+  for (int i = 1; i <= num_urls; ++i) {
+    url_statement.BindInt64(0, i);
+    url_statement.BindString(
+        1, base::StringPrintf("https://site%d.example.com/", i));
+    url_statement.BindString(2, base::StringPrintf("Site %d", i));
+    url_statement.BindInt(3, visits_per_url);
+    url_statement.BindInt64(4, kFirstVisitTime + visits_per_url - 1);
+    ASSERT_TRUE(url_statement.Run());
+    url_statement.Reset(true);
+
+    for (int visit = 0; visit < visits_per_url; ++visit) {
+      visit_statement.BindInt64(0, i);
+      visit_statement.BindInt64(1, kFirstVisitTime + visit);
+      visit_statement.BindInt(2, kTransition);
+      ASSERT_TRUE(visit_statement.Run());
+      visit_statement.Reset(true);
+    }
+  }
+  ASSERT_TRUE(transaction.Commit());
+}
+
+void CreateFaviconsDatabase(const base::FilePath& path,
+                            int num_icons,
+                            std::vector<std::vector<unsigned char>>* images) {
+  {
+    sql::Database db;
+    ASSERT_TRUE(db.Open(path));
+    sql::Statement s(
+        db.GetUniqueStatement("SELECT image_data FROM favicon_bitmaps"));
+    while (s.Step()) {
+      images->emplace_back();
+      s.ColumnBlobAsVector(0, &images->back());
+    }
+  }
+  ASSERT_FALSE(images->empty());
+
+  ASSERT_TRUE(base::DeleteFile(path, false));
+  sql::Database db;
+  ASSERT_TRUE(db.Open(path));
+  ASSERT_TRUE(db.Execute(
+      "CREATE TABLE icon_mapping(id INTEGER PRIMARY KEY, "
+      "page_url LONGVARCHAR NOT NULL, icon_id INTEGER)"));
+  ASSERT_TRUE(db.Execute(
+      "CREATE TABLE favicons(id INTEGER PRIMARY KEY, "
+      "url LONGVARCHAR NOT NULL, icon_type INTEGER DEFAULT 1)"));
+  ASSERT_TRUE(db.Execute(
+      "CREATE TABLE favicon_bitmaps(id INTEGER PRIMARY KEY, "
+      "icon_id INTEGER NOT NULL, image_data BLOB)"));
+
+  sql::Transaction transaction(&db);
+  ASSERT_TRUE(transaction.Begin());
+  sql::Statement mapping_statement(db.GetUniqueStatement(
+      "INSERT INTO icon_mapping (page_url, icon_id) VALUES (?, ?)"));
+  sql::Statement icon_statement(
+      db.GetUniqueStatement("INSERT INTO favicons (id, url) VALUES (?, ?)"));
+  sql::Statement bitmap_statement(db.GetUniqueStatement(
+      "INSERT INTO favicon_bitmaps (icon_id, image_data) VALUES (?, ?)"));
+  for (int i = 1; i <= num_icons; ++i) {
+    mapping_statement.BindString(
+        0, base::StringPrintf("https://site%d.example.com/", i));
+    mapping_statement.BindInt64(1, i);
+    ASSERT_TRUE(mapping_statement.Run());
+    mapping_statement.Reset(true);
+
+    icon_statement.BindInt64(0, i);
+    icon_statement.BindString(
+        1, base::StringPrintf("https://site%d.example.com/favicon.ico", i));
+    ASSERT_TRUE(icon_statement.Run());
+    icon_statement.Reset(true);
+
+    const std::vector<unsigned char>& image = (*images)[i % images->size()];
+    bitmap_statement.BindInt64(0, i);
+    bitmap_statement.BindBlob(1, image.data(), image.size());
+    ASSERT_TRUE(bitmap_statement.Run());
+    bitmap_statement.Reset(true);
+  }
+  ASSERT_TRUE(transaction.Commit());
+}
@@ -0,0 +1,33 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_UTILITY_IMPORTER_CHROME_IMPORTER_TEST_UTIL_H_
+#define BRAVE_UTILITY_IMPORTER_CHROME_IMPORTER_TEST_UTIL_H_
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+
+// In order to test the Chrome import functionality effectively, we store a
+// simulated Chrome profile directory containing dummy data files with the
+// same structure as ~/Library/Application Support/Google/Chrome in the Brave
+// test data directory. This function returns the path to that directory.
+base::FilePath GetTestChromeProfileDir(const std::string& profile);
+
+// Replaces the History database at |path| with one holding |num_urls| URLs,
+// each visited |visits_per_url| times.
+void CreateHistoryDatabase(const base::FilePath& path,
+                           int num_urls,
+                           int visits_per_url);
+
+// Replaces the Favicons database at |path| with one holding |num_icons|
+// icons, each used by one page. Their images are copies of the ones already
+// in the database, which are returned in |images|.
+void CreateFaviconsDatabase(const base::FilePath& path,
+                            int num_icons,
+                            std::vector<std::vector<unsigned char>>* images);
+
+#endif  // BRAVE_UTILITY_IMPORTER_CHROME_IMPORTER_TEST_UTIL_H_
@@ -3,15 +3,16 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "brave/utility/importer/chrome_importer.h"
-#include "brave/common/brave_paths.h"
 #include "brave/common/importer/brave_mock_importer_bridge.h"
+#include "brave/utility/importer/chrome_importer_test_util.h"
+
+#include <algorithm>
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/strings/utf_string_conversions.h"
-#include "base/path_service.h"
-#include "chrome/common/chrome_paths.h"
+#include "base/test/scoped_task_environment.h"
 #include "chrome/common/importer/imported_bookmark_entry.h"
 #include "chrome/common/importer/importer_data_types.h"
 #include "chrome/common/importer/importer_url_row.h"
@@ -24,20 +25,37 @@ using base::ASCIIToUTF16;
 using base::UTF16ToASCII;
 using ::testing::_;
 
-// In order to test the Chrome import functionality effectively, we store a
-// simulated Chrome profile directory containing dummy data files with the
-// same structure as ~/Library/Application Support/Google/Chrome in the Brave
-// test data directory. This function returns the path to that directory.
-base::FilePath GetTestChromeProfileDir(const std::string& profile) {
-  base::FilePath test_dir;
-  base::PathService::Get(brave::DIR_TEST_DATA, &test_dir);
-
-  return test_dir.AppendASCII("import").AppendASCII("chrome")
-      .AppendASCII(profile);
-}
-
 class ChromeImporterTest : public ::testing::Test {
  protected:
+  // Imports the history and records how it was handed to the bridge, and
+  // the progress reported after each chunk.
+  void ImportHistoryInChunks(size_t* total_rows,
+                             size_t* num_chunks,
+                             size_t* largest_chunk,
+                             std::vector<uint32_t>* progress) {
+    *total_rows = *num_chunks = *largest_chunk = 0;
+    progress->clear();
+    EXPECT_CALL(*bridge_, NotifyStarted());
+    EXPECT_CALL(*bridge_, NotifyItemStarted(importer::HISTORY));
+    EXPECT_CALL(*bridge_, SetHistoryItems(_, _))
+        .WillRepeatedly(::testing::Invoke(
+            [&](const std::vector<ImporterURLRow>& rows,
+                importer::VisitSource visit_source) {
+              *total_rows += rows.size();
+              ++*num_chunks;
+              *largest_chunk = std::max(*largest_chunk, rows.size());
+            }));
+    EXPECT_CALL(*bridge_, NotifyItemProgress(importer::HISTORY, _))
+        .WillRepeatedly(::testing::Invoke(
+            [&](importer::ImportItem item, uint32_t imported_count) {
+              progress->push_back(imported_count);
+            }));
+    EXPECT_CALL(*bridge_, NotifyItemEnded(importer::HISTORY));
+    EXPECT_CALL(*bridge_, NotifyEnded());
+
+    importer_->StartImport(profile_, importer::HISTORY, bridge_.get());
+  }
+
   void SetUpChromeProfile() {
     // Creates a new profile in a new subdirectory in the temp directory.
     ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
@@ -59,6 +77,8 @@ class ChromeImporterTest : public ::testing::Test {
     bridge_ = new BraveMockImporterBridge;
   }
 
+  // Favicons are reencoded on the thread pool.
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
   base::ScopedTempDir temp_dir_;
   base::FilePath profile_dir_;
   importer::SourceProfile profile_;
@@ -73,6 +93,7 @@ TEST_F(ChromeImporterTest, ImportHistory) {
   EXPECT_CALL(*bridge_, NotifyItemStarted(importer::HISTORY));
   EXPECT_CALL(*bridge_, SetHistoryItems(_, _))
       .WillOnce(::testing::SaveArg<0>(&history));
+  EXPECT_CALL(*bridge_, NotifyItemProgress(importer::HISTORY, 3u));
   EXPECT_CALL(*bridge_, NotifyItemEnded(importer::HISTORY));
   EXPECT_CALL(*bridge_, NotifyEnded());
 
@@ -84,6 +105,23 @@ TEST_F(ChromeImporterTest, ImportHistory) {
   EXPECT_EQ("https://www.nytimes.com/", history[2].url.spec());
 }
 
+TEST_F(ChromeImporterTest, ImportHistoryOneRowPerURLInChunks) {
+  const int kNumURLs = ChromeImporter::kNumHistoryRowsPerChunk * 2 + 10;
+  CreateHistoryDatabase(profile_dir_.AppendASCII("History"), kNumURLs, 3);
+
+  size_t total_rows, num_chunks, largest_chunk;
+  std::vector<uint32_t> progress;
+  ImportHistoryInChunks(&total_rows, &num_chunks, &largest_chunk, &progress);
+
+  EXPECT_EQ(static_cast<size_t>(kNumURLs), total_rows);
+  EXPECT_EQ(3u, num_chunks);
+  EXPECT_EQ(ChromeImporter::kNumHistoryRowsPerChunk, largest_chunk);
+  // Progress is reported after every chunk.
+  const uint32_t kChunk = ChromeImporter::kNumHistoryRowsPerChunk;
+  EXPECT_EQ(std::vector<uint32_t>({kChunk, kChunk * 2, kChunk * 2 + 10}),
+            progress);
+}
+
 TEST_F(ChromeImporterTest, ImportBookmarks) {
   std::vector<ImportedBookmarkEntry> bookmarks;
 
@@ -134,6 +172,39 @@ TEST_F(ChromeImporterTest, ImportFavicons) {
             favicons[3].favicon_url.spec());
 }
 
+TEST_F(ChromeImporterTest, ImportFaviconsInBatches) {
+  const int kNumIcons = ChromeImporter::kNumFaviconsPerBatch + 10;
+  std::vector<std::vector<unsigned char>> images;
+  CreateFaviconsDatabase(profile_dir_.AppendASCII("Favicons"), kNumIcons,
+                         &images);
+
+  std::vector<size_t> batch_sizes;
+  favicon_base::FaviconUsageDataList first_batch;
+  EXPECT_CALL(*bridge_, NotifyStarted());
+  EXPECT_CALL(*bridge_, NotifyItemStarted(importer::FAVORITES));
+  EXPECT_CALL(*bridge_, AddBookmarks(_, _));
+  EXPECT_CALL(*bridge_, SetFavicons(_))
+      .WillRepeatedly(::testing::Invoke(
+          [&](const favicon_base::FaviconUsageDataList& favicons) {
+            if (batch_sizes.empty())
+              first_batch = favicons;
+            batch_sizes.push_back(favicons.size());
+          }));
+  EXPECT_CALL(*bridge_, NotifyItemEnded(importer::FAVORITES));
+  EXPECT_CALL(*bridge_, NotifyEnded());
+
+  importer_->StartImport(profile_, importer::FAVORITES, bridge_.get());
+
+  ASSERT_EQ(2u, batch_sizes.size());
+  EXPECT_EQ(ChromeImporter::kNumFaviconsPerBatch, batch_sizes[0]);
+  EXPECT_EQ(10u, batch_sizes[1]);
+  // Batches keep the order of the icons.
+  EXPECT_EQ("https://site1.example.com/favicon.ico",
+            first_batch[0].favicon_url.spec());
+  EXPECT_EQ(1u, first_batch[0].urls.count(GURL("https://site1.example.com/")));
+  EXPECT_FALSE(first_batch[0].png_data.empty());
+}
+
 // The mock keychain only works on macOS, so only run this test on macOS (for now)
 #if defined(OS_MACOSX)
 TEST_F(ChromeImporterTest, ImportPasswords) {